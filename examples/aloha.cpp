@@ -1,9 +1,9 @@
 #include <cxxdes/cxxdes.hpp>
-#include <set>
 
 #include "random_variable.hpp"
 
 #include <fmt/core.h>
+#include <iostream>
 
 using namespace cxxdes::core;
 using namespace cxxdes::core::time_ops;
@@ -15,6 +15,7 @@ struct aloha_config {
     float lambda = 2.0f; // frames / second
     std::size_t packets_per_station = 10000; // frames
     float frame_time = 1.0f; // seconds / frame
+    std::uint64_t seed = 1;
 };
 
 struct aloha_result {
@@ -26,6 +27,9 @@ CXXDES_SIMULATION(aloha) {
     aloha(aloha_config const &cfg): cfg_{cfg} {
         env.time_unit(1_s);
         env.time_precision(1_ms);
+
+        for (std::size_t i = 0; i < cfg_.num_stations; ++i)
+            channel_.add_node();
     }
 
     const auto &config() const {
@@ -48,20 +52,14 @@ CXXDES_SIMULATION(aloha) {
     }
 
 private:
-    coroutine<void> station([[maybe_unused]] int id) {
-        exponential_rv interarrival{rand_seed(), cfg_.lambda / cfg_.num_stations};
+    coroutine<void> station(int id) {
+        exponential_rv interarrival{cxxdes::experiment::replication_seed(cfg_.seed, id), cfg_.lambda / cfg_.num_stations};
 
         for (std::size_t i = 0; i < cfg_.packets_per_station; ++i) {
-            bool collided = false;
-
-            active_transmissions_.insert(&collided);
-
-            check_collisions();
+            channel_.begin_transmission(id);
             co_await env.timeout(cfg_.frame_time);
 
-            active_transmissions_.erase(&collided);
-
-            if (!collided) {
+            if (channel_.end_transmission(id)) {
                 successful_transmissions_++;
             }
 
@@ -70,43 +68,43 @@ private:
         }
     }
 
-    void check_collisions() {
-        if (active_transmissions_.size() > 1) {
-            for (auto collided: active_transmissions_)
-                *collided = true;
-        }
-    }
-
     const aloha_config cfg_;
     aloha_result result_;
 
     std::size_t successful_transmissions_ = 0;
-    std::set<bool *> active_transmissions_;
+
+    // every station hears every other, so overlapping frames collide
+    cxxdes::sync::medium channel_;
 };
 
 int main() {
-    // experiment parameters
-    const std::size_t num_steps = 50;
-    const float begin = 0.1;
-    const float end = 3.0;
-
-    fmt::print("G [Erlang], S [Erlang]\n");
-
-    for (std::size_t i = 0; i < num_steps; ++i) {
-        const float lambda = begin + (end - begin) * i / (num_steps - 1);
-
-        environment env;
-        aloha experiment{
-            aloha_config{
-                .lambda = lambda, .packets_per_station = std::size_t(lambda * 1000)
+    // with a frame time of 1 s, G equals lambda; points are added where S
+    // changes most, and stream out as they complete
+    cxxdes::experiment::sweep(
+        cxxdes::experiment::sweep_config{
+            .lower = 0.1,
+            .upper = 3.0,
+            .initial_points = 9,
+            .max_points = 33,
+            .replications = {
+                .min_replications = 5,
+                .max_replications = 10,
+                .relative_half_width = 0.05
             }
-        };
-
-        experiment.run();
-        auto [g, s] = experiment.result();
-
-        fmt::print("{}, {}\n", g, s);
-    }
+        },
+        [](double lambda, cxxdes::experiment::replication r) {
+            aloha experiment{
+                aloha_config{
+                    .lambda = float(lambda),
+                    .packets_per_station = std::size_t(lambda * 100),
+                    .seed = r.seed
+                }
+            };
+
+            experiment.run();
+            return experiment.result().s;
+        },
+        cxxdes::experiment::csv_writer{std::cout, "G"});
 
     return 0;
 }
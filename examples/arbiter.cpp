@@ -0,0 +1,54 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <vector>
+
+using namespace cxxdes::core;
+
+using cxxdes::sync::arbiter_policy;
+
+CXXDES_SIMULATION(bus_example) {
+    bus_example(arbiter_policy policy): bus{4, policy} {
+        // under the weighted policy, core 0 gets two bus transfers per round
+        bus.set_weight(0, 2);
+    }
+
+    // one shared bus, arbitrated every cycle among four cores
+    cxxdes::sync::arbiter bus;
+    std::vector<time_integral> finished = std::vector<time_integral>(4);
+
+    coroutine<> core(std::size_t id) {
+        for (int i = 0; i < 4; ++i) {
+            _Co_with(bus.port(id)) {
+                co_await delay(2); // transfer
+            };
+        }
+
+        finished[id] = now();
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(core(0), core(1), core(2), core(3));
+    }
+};
+
+int main() {
+    std::pair<arbiter_policy, const char *> policies[] = {
+        { arbiter_policy::round_robin, "round robin" },
+        { arbiter_policy::fixed_priority, "fixed priority" },
+        { arbiter_policy::weighted, "weighted" },
+        { arbiter_policy::age_based, "age based" }
+    };
+
+    for (auto [policy, name]: policies) {
+        bus_example sim{policy};
+        sim.run();
+
+        fmt::print("{:>15}:", name);
+        for (auto t: sim.finished)
+            fmt::print(" {:3}", t);
+        fmt::print("\n");
+    }
+
+    return 0;
+}
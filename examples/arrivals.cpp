@@ -0,0 +1,87 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <chrono>
+#include <random>
+
+using namespace cxxdes::core;
+using namespace cxxdes::time_utils::ops;
+
+namespace sources = cxxdes::sources;
+
+// counts the arrivals of a Poisson source; no coroutine runs per arrival
+CXXDES_SIMULATION(counting) {
+    counting(): src{env, 1000.0} {
+        env.time_precision(1_us);
+        src.on_arrival([this] { ++arrivals; });
+        src.limit(2'000'000);
+    }
+
+    sources::poisson src;
+    std::uint64_t arrivals = 0;
+
+    coroutine<> co_main() {
+        src.start();
+        co_return ;
+    }
+};
+
+// bursts of customers arrive at a single server through a bounded queue
+CXXDES_SIMULATION(bursts) {
+    bursts():
+        q{20},
+        src{env, std::exponential_distribution<double>{0.25}, std::geometric_distribution<int>{0.3}, 1} {
+        env.time_precision(1_ms);
+        src.feed(q, [this] { return now(); });
+    }
+
+    cxxdes::sync::queue<time_integral> q;
+    sources::batch<std::exponential_distribution<double>, std::geometric_distribution<int>> src;
+
+    std::uint64_t served = 0;
+    time_integral total_wait = 0;
+
+    coroutine<> server() {
+        std::mt19937_64 rng{2};
+        std::exponential_distribution<double> service{1.0};
+
+        while (true) {
+            auto arrived = co_await q.pop();
+            total_wait += now() - arrived;
+            ++served;
+            co_await env.timeout(service(rng));
+        }
+    }
+
+    coroutine<> co_main() {
+        src.start();
+        co_await async(server());
+    }
+};
+
+int main() {
+    {
+        counting sim;
+
+        auto t0 = std::chrono::steady_clock::now();
+        sim.run();
+        auto t1 = std::chrono::steady_clock::now();
+
+        auto seconds = std::chrono::duration<double>(t1 - t0).count();
+        fmt::print(
+            "poisson: {} arrivals in {:.2f} s of simulated time, {:.1f} M arrivals/s\n",
+            sim.arrivals, sim.env.now_seconds(), static_cast<double>(sim.arrivals) / seconds / 1e6);
+    }
+
+    {
+        bursts sim;
+        sim.run_for(100'000_x);
+
+        fmt::print(
+            "bursts: {} arrivals, {} dropped at the full queue, {} served, average wait = {:.2f}\n",
+            sim.src.generated(), sim.src.dropped(), sim.served,
+            static_cast<double>(sim.total_wait) / static_cast<double>(sim.served) / 1000.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <functional>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(barrier_example) {
+    using simulation::simulation;
+
+    static constexpr std::size_t n_workers = 4;
+    static constexpr std::size_t n_cycles = 3;
+
+    cxxdes::sync::barrier<std::function<void()>> clock_edge{
+        n_workers,
+        [this]() { fmt::print("cycle done, now = {}\n", now()); }
+    };
+
+    cxxdes::sync::latch done{n_workers};
+
+    coroutine<> worker(int id) {
+        for (std::size_t i = 0; i < n_cycles; ++i) {
+            // workers finish their local work at different times
+            co_await delay(id + 1);
+            co_await clock_edge.arrive_and_wait();
+        }
+        co_await done.count_down();
+    }
+
+    coroutine<> reporter() {
+        co_await done.wait();
+        fmt::print("all workers done, now = {}\n", now());
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(reporter(), worker(0), worker(1), worker(2), worker(3));
+    }
+};
+
+int main() {
+    barrier_example{}.run();
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <string>
+#include <vector>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(broadcast_example) {
+    using simulation::simulation;
+
+    struct quote {
+        std::string symbol;
+        std::vector<double> book;
+    };
+
+    // every quote is stored once and shared by all subscribers;
+    // a subscriber more than 4 quotes behind loses the oldest ones
+    cxxdes::sync::broadcast<quote> feed{4, cxxdes::sync::broadcast_policy::drop};
+
+    coroutine<> trader(std::string name, int think_time, int quotes) {
+        auto sub = feed.subscribe();
+
+        for (int i = 0; i < quotes; ++i) {
+            auto q = co_await sub.recv();
+            fmt::print(
+                "{}: {} @{} (refs: {}, dropped: {})\n",
+                name, q->symbol, now(), q.use_count(), sub.dropped());
+            co_await delay(think_time);
+        }
+    }
+
+    coroutine<> exchange() {
+        co_await delay(1);
+        for (int i = 0; i < 8; ++i) {
+            quote q{"TICK" + std::to_string(i), std::vector<double>(1024, i)};
+            co_await feed.publish(std::move(q));
+            co_await delay(2);
+        }
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(
+            trader("fast", 1, 8),
+            trader("slow", 7, 3),
+            exchange());
+    }
+};
+
+int main() {
+    broadcast_example{}.run();
+    return 0;
+}
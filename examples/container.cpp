@@ -0,0 +1,53 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(container_example) {
+    using simulation::simulation;
+
+    // a fuel tank of 1000 liters, half full
+    cxxdes::sync::container<double> tank{1000.0, 500.0};
+
+    // a 64 KiB buffer in which small requests may pass a large blocked one
+    cxxdes::sync::container<std::size_t> buffer{
+        64 * 1024, 0, cxxdes::sync::container_policy::first_fit};
+
+    coroutine<> car(int id, double liters) {
+        co_await delay(id * 5);
+        co_await tank.get(liters);
+        fmt::print("car {}: took {} l @{}\n", id, liters, now());
+    }
+
+    // car 3 waits behind car 2 even though 200 l would be enough for it
+    coroutine<> tanker() {
+        for (double liters: { 100.0, 700.0 }) {
+            co_await delay(30);
+            co_await tank.put(liters);
+            fmt::print("tanker: delivered {} l @{}\n", liters, now());
+        }
+    }
+
+    coroutine<> reader(std::string name, std::size_t bytes) {
+        co_await buffer.get(bytes);
+        fmt::print("{}: read {} bytes @{}\n", name, bytes, now());
+    }
+
+    coroutine<> writer() {
+        for (int i = 0; i < 4; ++i) {
+            co_await delay(10);
+            co_await buffer.put(16 * 1024);
+        }
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(
+            car(1, 300.0), car(2, 300.0), car(3, 100.0), tanker(),
+            reader("bulk", 48 * 1024), reader("small", 4 * 1024), writer());
+    }
+};
+
+int main() {
+    container_example{}.run();
+    return 0;
+}
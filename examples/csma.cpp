@@ -0,0 +1,44 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(csma_example) {
+    using simulation::simulation;
+
+    // radios hear each other up to 10 m away
+    cxxdes::sync::medium radio{10.0};
+
+    coroutine<> station(char name, double x, int start, bool listen) {
+        auto id = radio.add_node(x, 0);
+        co_await delay(start);
+
+        // carrier sense: defer while a neighbor is transmitting
+        if (listen && radio.busy(id)) {
+            fmt::print("{}: carrier busy @{}\n", name, now());
+            co_await radio.wait_idle(id);
+        }
+
+        radio.begin_transmission(id);
+        co_await delay(5);
+        bool ok = radio.end_transmission(id);
+
+        fmt::print("{}: frame {} @{}\n", name, ok ? "delivered" : "collided", now());
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(
+            station('A', 0, 0, true),
+            station('B', 8, 2, true),   // hears A and defers
+            station('C', 16, 7, false), // hears B only and does not listen
+            station('D', 100, 1, true)  // far away, never interferes
+        );
+
+        fmt::print("{} transmissions, {} collided\n", radio.transmissions(), radio.collisions());
+    }
+};
+
+int main() {
+    csma_example{}.run();
+    return 0;
+}
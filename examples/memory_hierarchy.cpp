@@ -0,0 +1,63 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <random>
+
+using namespace cxxdes::core;
+
+namespace arch = cxxdes::arch;
+
+CXXDES_SIMULATION(memory_hierarchy) {
+    using simulation::simulation;
+
+    // 32 KiB private L1s, a shared 1 MiB L2 with four banks, and two DRAM channels
+    arch::dram dram{arch::dram_config{64, 8192, 2, 8, 14, 14, 14, 4}};
+    arch::cache<arch::srrip> l2{arch::cache_config{64, 1024, 16, 12, 4, 1, 2, 16}, &dram};
+    arch::cache<arch::lru> l1a{arch::cache_config{64, 64, 8, 2, 1, 1, 1, 8}, &l2};
+    arch::cache<arch::lru> l1b{arch::cache_config{64, 64, 8, 2, 1, 1, 1, 8}, &l2};
+
+    // reuses a 64 KiB working set, twice the size of an L1, with one store in four
+    coroutine<> hot_loop(arch::level &l1) {
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<arch::addr_type> addr{0, 64 * 1024 - 1};
+
+        for (int i = 0; i < 40000; ++i) {
+            if (i % 4 == 0)
+                co_await l1.store(addr(rng));
+            else
+                co_await l1.load(addr(rng));
+        }
+    }
+
+    // streams once through 2 MiB, far more than the L2 holds
+    coroutine<> scan(arch::level &l1) {
+        for (arch::addr_type a = 0; a < 2 * 1024 * 1024; a += 64)
+            co_await l1.load((1ull << 32) + a);
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(hot_loop(l1a), scan(l1b));
+        fmt::print("finished at {}\n", now());
+    }
+};
+
+template <typename Cache>
+void report(char const *name, Cache const &c) {
+    fmt::print(
+        "{}: hits = {}, misses = {} ({} coalesced), evictions = {}, writebacks = {}\n",
+        name, c.hits(), c.misses(), c.coalesced(), c.evictions(), c.writebacks());
+}
+
+int main() {
+    memory_hierarchy sim;
+    sim.run();
+
+    report("L1a", sim.l1a);
+    report("L1b", sim.l1b);
+    report("L2", sim.l2);
+    fmt::print(
+        "DRAM: reads = {}, writes = {}, row hits = {}, row misses = {}, row conflicts = {}\n",
+        sim.dram.reads(), sim.dram.writes(), sim.dram.row_hits(), sim.dram.row_misses(), sim.dram.row_conflicts());
+
+    return 0;
+}
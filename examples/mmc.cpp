@@ -0,0 +1,53 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+using namespace cxxdes::core;
+using namespace cxxdes::time_utils::ops;
+
+namespace queueing = cxxdes::queueing;
+
+// one M/M/c station fed by a Poisson source
+CXXDES_SIMULATION(mmc_example) {
+    mmc_example(double lambda, double mu, std::size_t c, queueing::discipline d):
+        out{env, pool},
+        st{env, c, queueing::exponential{mu, 2}, d},
+        src{env, pool, st, lambda, 1} {
+        env.time_precision(1_us);
+        st.connect(out);
+        src.limit(100'000);
+    }
+
+    queueing::job_pool pool;
+    queueing::sink out;
+    queueing::station st;
+    queueing::poisson_source src;
+
+    coroutine<> co_main() {
+        src.start();
+        co_return ;
+    }
+};
+
+int main() {
+    double mu = 1;
+
+    fmt::print("{:>3} {:>5} {:>18} {:>10} {:>10}\n", "c", "rho", "discipline", "simulated", "analytic");
+
+    for (std::size_t c: { 1, 2, 8 }) {
+        for (auto rho: { 0.5, 0.9 }) {
+            auto lambda = rho * static_cast<double>(c) * mu;
+
+            for (auto d: { queueing::discipline::fifo, queueing::discipline::processor_sharing }) {
+                mmc_example sim{lambda, mu, c, d};
+                sim.run();
+
+                fmt::print(
+                    "{:>3} {:>5.2f} {:>18} {:>10.3f} {:>10.3f}\n",
+                    c, rho, d == queueing::discipline::fifo ? "fifo" : "processor sharing",
+                    sim.out.mean(), queueing::mmc_sojourn_time(lambda, mu, c));
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <random>
+
+using namespace cxxdes::core;
+
+namespace net = cxxdes::net;
+
+// uniform random traffic of 4-flit packets
+CXXDES_SIMULATION(noc_example) {
+    noc_example(net::network &net, double rate): net{net}, rate{rate} {
+    }
+
+    net::network &net;
+    double rate; // packets per node per cycle
+
+    time_integral horizon = 2000;
+    std::uint64_t received = 0;
+    time_integral total_latency = 0;
+
+    coroutine<> source(net::node_id node) {
+        std::mt19937 rng{static_cast<unsigned>(node)};
+        std::geometric_distribution<time_integral> gap{rate};
+        std::uniform_int_distribution<net::node_id> dst{0, net.routers() - 1};
+
+        while (now() < horizon) {
+            co_await delay(gap(rng) + 1);
+            co_await net.send(net.make_packet(node, dst(rng), 4));
+        }
+    }
+
+    coroutine<> sink(net::node_id node) {
+        while (true) {
+            auto p = co_await net.receive(node);
+            total_latency += p->delivered - p->created;
+            ++received;
+            net.release(p);
+        }
+    }
+
+    coroutine<> co_main() {
+        for (net::node_id n = 0; n < net.routers(); ++n) {
+            co_await async(source(n));
+            co_await async(sink(n));
+        }
+    }
+};
+
+template <typename Topology>
+void run(char const *name, double rate) {
+    Topology topology{8, 8};
+    noc_example sim{topology, rate};
+    sim.run();
+
+    fmt::print(
+        "{:>5} @ {:.2f}: {} packets, average latency = {:.1f} cycles, {} router steps\n",
+        name, rate, sim.received,
+        static_cast<double>(sim.total_latency) / static_cast<double>(sim.received),
+        topology.steps());
+}
+
+int main() {
+    for (auto rate: { 0.01, 0.03, 0.05 }) {
+        run<net::mesh>("mesh", rate);
+        run<net::torus>("torus", rate);
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+using namespace cxxdes::core;
+
+namespace parallel = cxxdes::parallel;
+
+// PHOLD: jobs hop between partitions, each hop to a random partition after a
+// random delay of at least the lookahead
+constexpr time_integral lookahead = 10;
+constexpr time_integral end = 100'000;
+constexpr int jobs_per_partition = 16;
+
+struct counters {
+    std::uint64_t hops = 0;
+};
+
+coroutine<> hop(std::vector<parallel::channel<int> *> &outs, parallel::channel<int> &in, std::mt19937_64 &rng, counters &c) {
+    std::exponential_distribution<double> extra{1.0 / lookahead};
+
+    while (true) {
+        auto job = co_await in.pop();
+        ++c.hops;
+
+        auto &out = *outs[rng() % outs.size()];
+        out.send(job, lookahead + static_cast<time_integral>(extra(rng)));
+    }
+}
+
+coroutine<> inject(std::vector<parallel::channel<int> *> &outs, std::mt19937_64 &rng) {
+    for (int j = 0; j < jobs_per_partition; ++j)
+        outs[rng() % outs.size()]->send(j, lookahead + j);
+    co_return ;
+}
+
+void run(parallel::synchronization sync, std::size_t n) {
+    std::vector<std::mt19937_64> rngs;
+    std::vector<counters> stats(n);
+    std::vector<std::vector<parallel::channel<int> *>> outs(n);
+
+    parallel::engine e{sync};
+    for (std::size_t i = 0; i < n; ++i) {
+        e.add_partition();
+        rngs.emplace_back(i + 1);
+    }
+
+    // every partition is connected to every other one
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = 0; k < n; ++k) {
+            if (i == k)
+                continue;
+
+            auto &c = e.connect<int>(e[i], e[k], lookahead);
+            outs[i].push_back(&c);
+            e[k].env.bind(hop(outs[k], c, rngs[k], stats[k]));
+        }
+
+        e[i].env.bind(inject(outs[i], rngs[i]));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    e.run_until(end);
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::uint64_t hops = 0;
+    for (auto const &s: stats)
+        hops += s.hops;
+
+    fmt::print(
+        "{:<14} {:>10} {:>10} {:>12} {:>10.3f} {:>12.0f}\n",
+        sync == parallel::synchronization::window ? "window" : "null messages",
+        n, hops, sync == parallel::synchronization::window ? e.windows() : e.null_messages(),
+        seconds, static_cast<double>(hops) / seconds);
+}
+
+int main() {
+    auto n = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+    fmt::print("{:<14} {:>10} {:>10} {:>12} {:>10} {:>12}\n", "sync", "partitions", "hops", "sync events", "seconds", "hops/s");
+    run(parallel::synchronization::window, n);
+    run(parallel::synchronization::null_messages, n);
+
+    return 0;
+}
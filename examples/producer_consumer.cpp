@@ -21,13 +21,12 @@ CXXDES_SIMULATION(producer_consumer_example) {
 
     cxxdes::sync::queue<double> q;
     std::size_t n_packets;
-    double total_latency = 0;
+    cxxdes::stats::tally latency;
+    cxxdes::stats::tdigest latency_quantiles;
 
     exponential_rv lambda;
     exponential_rv mu;
 
-    double avg_latency = 0.0;
-    
     coroutine<> producer() {
         for (std::size_t i = 0; i < n_packets; ++i) {
             co_await q.put(now_seconds());
@@ -42,14 +41,13 @@ CXXDES_SIMULATION(producer_consumer_example) {
             auto x = co_await q.pop();
             ++n;
 
-            if (n == n_packets) {
-                avg_latency = total_latency / n_packets;
+            if (n == n_packets)
                 co_return ;
-            }
             
             co_await env.timeout(mu());
 
-            total_latency += (now_seconds() - x);
+            latency.add(now_seconds() - x);
+            latency_quantiles.add(now_seconds() - x);
         }
     }
 
@@ -64,12 +62,14 @@ int main() {
     double mu = lambda_end;
     std::size_t n_steps = 100;
 
-    fmt::print("{}, {}, {}, {}\n", "lambda", "mu", "rho", "avg_latency");
+    fmt::print("{}, {}, {}, {}, {}\n", "lambda", "mu", "rho", "avg_latency", "p99_latency");
     for (std::size_t i = 0; i < n_steps; ++i) {
         double lambda = lambda_start + (lambda_end - lambda_start) * i / (n_steps - 1);
         auto sim = producer_consumer_example{lambda, mu};
         sim.run();
-        fmt::print("{:.3f}, {:.3f}, {:.3f}, {:.3f}\n", lambda, mu, lambda / lambda_end, sim.avg_latency);
+        fmt::print(
+            "{:.3f}, {:.3f}, {:.3f}, {:.3f}, {:.3f}\n",
+            lambda, mu, lambda / lambda_end, sim.latency.mean(), sim.latency_quantiles.quantile(0.99));
     }
     return 0;
 }
@@ -0,0 +1,50 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <vector>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(queue_batch_example) {
+    using simulation::simulation;
+
+    // a bounded queue preallocates its ring buffer
+    cxxdes::sync::queue<int> q{64};
+
+    coroutine<> nic() {
+        std::vector<int> burst(48);
+        int seq = 0;
+
+        for (int b = 0; b < 4; ++b) {
+            for (auto &x: burst)
+                x = seq++;
+
+            // one suspension until the whole burst fits
+            co_await q.put_range(burst.begin(), burst.end());
+            fmt::print("nic: burst {} queued @{}\n", b, now());
+            co_await delay(2);
+        }
+    }
+
+    coroutine<> cpu() {
+        std::vector<int> batch;
+
+        for (int b = 0; b < 6; ++b) {
+            batch.clear();
+
+            // one wakeup once 32 packets are available
+            co_await q.pop_n(std::back_inserter(batch), 32);
+            fmt::print("cpu: packets {}..{} @{}\n", batch.front(), batch.back(), now());
+            co_await delay(5);
+        }
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(nic(), cpu());
+    }
+};
+
+int main() {
+    queue_batch_example{}.run();
+    return 0;
+}
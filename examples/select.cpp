@@ -0,0 +1,50 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <string>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(select_example) {
+    using simulation::simulation;
+
+    cxxdes::sync::queue<int> requests;
+    cxxdes::sync::queue<std::string> control;
+
+    coroutine<> clients() {
+        for (int i = 0; i < 3; ++i) {
+            co_await delay(4);
+            co_await requests.put(i);
+        }
+        co_await delay(4);
+        co_await control.put("stop");
+    }
+
+    coroutine<> dispatcher() {
+        while (true) {
+            // a single waiter on both queues, with an idle timeout
+            auto r = co_await cxxdes::sync::select(requests.pop_op(), control.pop_op(), delay(3));
+
+            switch (r.index) {
+            case 0:
+                fmt::print("request {} @{}\n", r.get<0>(), now());
+                break;
+            case 1:
+                fmt::print("control '{}' @{}\n", r.get<1>(), now());
+                co_return ;
+            case 2:
+                fmt::print("idle @{}\n", now());
+                break;
+            }
+        }
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(clients(), dispatcher());
+    }
+};
+
+int main() {
+    select_example{}.run();
+    return 0;
+}
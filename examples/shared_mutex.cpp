@@ -0,0 +1,44 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(shared_mutex_example) {
+    using simulation::simulation;
+
+    cxxdes::sync::shared_mutex m{cxxdes::sync::shared_mutex_policy::phase_fair};
+    int value = 0;
+
+    coroutine<> reader(int id, time_integral start) {
+        co_await delay(start);
+        _Co_with(m.shared()) {
+            fmt::print("reader #{}: value = {}, readers = {}, now = {}\n", id, value, m.readers(), now());
+            co_await delay(3);
+        };
+    }
+
+    coroutine<> writer(int id, time_integral start) {
+        co_await delay(start);
+        _Co_with(m.exclusive()) {
+            ++value;
+            fmt::print("writer #{}: value = {}, now = {}\n", id, value, now());
+            co_await delay(5);
+        };
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(
+            reader(0, 0),
+            reader(1, 1),
+            writer(0, 2),
+            reader(2, 3),
+            writer(1, 4),
+            reader(3, 5)
+        );
+    }
+};
+
+int main() {
+    shared_mutex_example{}.run();
+    return 0;
+}
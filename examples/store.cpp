@@ -0,0 +1,80 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+#include <string>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(store_example) {
+    using simulation::simulation;
+
+    struct job {
+        int priority;
+        std::string name;
+
+        job(int priority_, std::string name_):
+            priority{priority_}, name{std::move(name_)} {
+        }
+
+        bool operator<(job const &other) const {
+            return priority < other.priority;
+        }
+    };
+
+    struct message {
+        int dst;
+        std::string body;
+
+        message(int dst_, std::string body_):
+            dst{dst_}, body{std::move(body_)} {
+        }
+    };
+
+    struct dst_of {
+        int operator()(message const &m) const {
+            return m.dst;
+        }
+    };
+
+    // jobs with the smallest priority value are served first
+    cxxdes::sync::priority_store<job> jobs;
+
+    // each node waits only for messages addressed to it
+    cxxdes::sync::filter_store<message, dst_of> mailbox;
+
+    coroutine<> scheduler() {
+        co_await jobs.put({ 3, "backup" });
+        co_await jobs.put({ 1, "interrupt" });
+        co_await jobs.put({ 2, "render" });
+    }
+
+    coroutine<> cpu() {
+        co_await delay(1);
+        for (int i = 0; i < 3; ++i) {
+            auto j = co_await jobs.get();
+            fmt::print("cpu: {} (priority {}) @{}\n", j.name, j.priority, now());
+            co_await delay(2);
+        }
+    }
+
+    coroutine<> node(int id) {
+        auto m = co_await mailbox.get(id);
+        fmt::print("node {}: '{}' @{}\n", id, m.body, now());
+    }
+
+    coroutine<> network() {
+        co_await delay(3);
+        co_await mailbox.put({ 2, "hello two" });
+        co_await delay(3);
+        co_await mailbox.put({ 1, "hello one" });
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(scheduler(), cpu(), node(1), node(2), network());
+    }
+};
+
+int main() {
+    store_example{}.run();
+    return 0;
+}
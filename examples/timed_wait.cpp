@@ -0,0 +1,60 @@
+#include <cxxdes/cxxdes.hpp>
+#include <fmt/core.h>
+
+using namespace cxxdes::core;
+
+CXXDES_SIMULATION(timed_wait_example) {
+    using simulation::simulation;
+
+    cxxdes::sync::queue<int> jobs;
+    cxxdes::sync::resource server{1};
+
+    coroutine<> producer() {
+        for (int i = 0; i < 4; ++i) {
+            co_await delay(i * 3);
+            co_await jobs.put(i);
+        }
+    }
+
+    coroutine<> customer(int id, time_integral patience) {
+        // reneging: give up if the server is not available in time
+        auto h = co_await server.acquire_for(patience);
+        if (!h) {
+            fmt::print("customer #{} reneged @{}\n", id, now());
+            co_return ;
+        }
+
+        fmt::print("customer #{} served @{}\n", id, now());
+        co_await delay(4);
+        co_await h->release();
+    }
+
+    coroutine<> worker() {
+        while (true) {
+            auto job = co_await jobs.pop_for(5);
+            if (job.timed_out()) {
+                fmt::print("worker idle, stopping @{}\n", now());
+                co_return ;
+            }
+
+            fmt::print("job {} @{}\n", *job, now());
+        }
+    }
+
+    coroutine<> co_main() {
+        co_await all_of(
+            producer(),
+            worker(),
+            customer(0, 10),
+            customer(1, 2),
+            customer(2, 10));
+
+        fmt::print("waiting consumers: {}, waiting customers: {}\n",
+            jobs.waiting_consumers(), server.waiting());
+    }
+};
+
+int main() {
+    timed_wait_example{}.run();
+    return 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file cache.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Set-associative write-back cache with banks and MSHRs.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_ARCH_CACHE_HPP_INCLUDED
+#define CXXDES_ARCH_CACHE_HPP_INCLUDED
+
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/event.hpp>
+#include <cxxdes/sync/resource.hpp>
+#include <cxxdes/sync/semaphore.hpp>
+#include <cxxdes/arch/level.hpp>
+#include <cxxdes/arch/replacement.hpp>
+
+namespace cxxdes {
+namespace arch {
+
+/** @brief Geometry and timing of a `cache`. */
+struct cache_config {
+    /** @brief Bytes per line. */
+    std::size_t line_size = 64;
+
+    /** @brief Number of sets; one set makes the cache fully associative. */
+    std::size_t sets = 64;
+
+    /** @brief Lines per set. */
+    std::size_t ways = 8;
+
+    /** @brief Time from the start of an access to a hit. */
+    cxxdes::core::time_integral latency = 1;
+
+    /** @brief Number of independently accessible banks, interleaved by line. */
+    std::size_t banks = 1;
+
+    /** @brief Accesses a bank can start at the same time. */
+    std::size_t ports = 1;
+
+    /** @brief Time a bank port is busy per access; at most `latency`. */
+    cxxdes::core::time_integral occupancy = 1;
+
+    /** @brief Misses that can be outstanding to the next level at the same time. */
+    std::size_t mshrs = 8;
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Set-associative, write-back, write-allocate cache.
+ *
+ * An access first occupies a port of the bank its line maps to for
+ * `occupancy` ticks, so banks and ports bound the bandwidth, and completes
+ * `latency` ticks after it started if it hits. A miss allocates a miss
+ * status holding register (MSHR) and fetches the line from the next level;
+ * further misses to a line being fetched wait for the same fill instead of
+ * going to the next level. When every MSHR is busy, new misses wait for one.
+ * Dirty victims are written back in the background.
+ *
+ * Lines are located through a hash index, and the replacement policy takes
+ * constant time, so an access costs the same for any associativity. The
+ * cache only holds state for its own lines, whatever the footprint of the
+ * simulated program is.
+ *
+ * @tparam Policy Replacement policy: `lru`, `tree_plru`, `srrip`, or a type
+ *         with the same interface.
+ */
+template <typename Policy = lru>
+struct cache: level {
+    /**
+     * @brief Constructs a cache in front of @p next.
+     *
+     * @throws std::runtime_error If @p next is null or the configuration is invalid.
+     */
+    cache(cache_config const &config, level *next):
+        config_{config}, next_{next}, policy_{config.sets, config.ways},
+        lines_(config.sets * config.ways), used_(config.sets, 0),
+        mshr_slots_{config.mshrs, config.mshrs} {
+        if (!next_)
+            throw std::runtime_error("cache requires a next level");
+
+        if (config_.line_size == 0 || config_.banks == 0 || config_.ports == 0 || config_.mshrs == 0)
+            throw std::runtime_error("cache line size, banks, ports, and MSHRs must be positive");
+
+        if (config_.occupancy > config_.latency)
+            throw std::runtime_error("cache occupancy cannot exceed its latency");
+
+        for (std::size_t i = 0; i < config_.banks; ++i)
+            banks_.emplace_back(config_.ports);
+
+        index_.reserve(config_.sets * config_.ways);
+    }
+
+    cache(cache const &) = delete;
+    cache &operator=(cache const &) = delete;
+
+    coroutine<> access(addr_type addr, access_kind kind) override {
+        auto line = addr / config_.line_size;
+
+        _Co_with(banks_[line % banks_.size()]) {
+            co_await delay(config_.occupancy);
+        };
+        co_await delay(config_.latency - config_.occupancy);
+
+        if (hit_(line, kind)) {
+            ++hits_;
+            co_return ;
+        }
+
+        ++misses_;
+
+        for (bool waited = false; ; waited = true) {
+            auto it = mshrs_.find(line);
+            if (it == mshrs_.end())
+                break;
+
+            if (!waited)
+                ++coalesced_;
+
+            // the fill makes the line dirty for a write that waits for it
+            if (kind == access_kind::write)
+                it->second->dirty = true;
+
+            co_await it->second->filled.wait();
+
+            // the line may have been replaced between the fill and the wake;
+            // then the access misses again
+            if (hit_(line, kind))
+                co_return ;
+        }
+
+        // registered before waiting for a free MSHR, so later misses coalesce
+        auto &entry = *mshrs_.emplace(line, std::make_unique<mshr>()).first->second;
+
+        co_await mshr_slots_.down();
+        co_await next_->access(line * config_.line_size, access_kind::read);
+
+        if (auto victim = fill_(line, kind == access_kind::write || entry.dirty); victim != npos) {
+            ++writebacks_;
+            co_await async(next_->access(victim * config_.line_size, access_kind::write));
+        }
+
+        co_await mshr_slots_.up();
+        co_await entry.filled.wake();
+        mshrs_.erase(line);
+    }
+
+    /** @brief Returns whether the line of @p addr is in the cache. */
+    bool contains(addr_type addr) const {
+        return index_.count(addr / config_.line_size) > 0;
+    }
+
+    /** @brief Returns the configuration. */
+    cache_config const &config() const noexcept {
+        return config_;
+    }
+
+    /** @brief Returns the number of accesses that hit. */
+    std::uint64_t hits() const noexcept {
+        return hits_;
+    }
+
+    /** @brief Returns the number of accesses that missed, including coalesced ones. */
+    std::uint64_t misses() const noexcept {
+        return misses_;
+    }
+
+    /** @brief Returns the number of misses that waited for a fill already in flight. */
+    std::uint64_t coalesced() const noexcept {
+        return coalesced_;
+    }
+
+    /** @brief Returns the number of valid lines that were replaced. */
+    std::uint64_t evictions() const noexcept {
+        return evictions_;
+    }
+
+    /** @brief Returns the number of dirty lines written back to the next level. */
+    std::uint64_t writebacks() const noexcept {
+        return writebacks_;
+    }
+
+    /** @brief Returns the number of misses currently in flight or waiting for an MSHR. */
+    std::size_t outstanding() const noexcept {
+        return mshrs_.size();
+    }
+
+private:
+    static constexpr std::uint64_t npos = std::numeric_limits<std::uint64_t>::max();
+
+    struct line_state {
+        std::uint64_t line = 0;
+        bool dirty = false;
+    };
+
+    struct mshr {
+        cxxdes::sync::event filled;
+
+        // whether an access waiting for the fill writes the line
+        bool dirty = false;
+    };
+
+    // updates the replacement state of a present line
+    bool hit_(std::uint64_t line, access_kind kind) {
+        auto it = index_.find(line);
+        if (it == index_.end())
+            return false;
+
+        auto set = line % config_.sets;
+        policy_.touch(set, it->second - set * config_.ways);
+
+        if (kind == access_kind::write)
+            lines_[it->second].dirty = true;
+
+        return true;
+    }
+
+    // places a line, and returns the dirty line it replaced, if any
+    std::uint64_t fill_(std::uint64_t line, bool dirty) {
+        auto set = line % config_.sets;
+        auto victim = npos;
+
+        std::size_t way;
+        if (used_[set] < config_.ways) {
+            way = used_[set]++;
+        }
+        else {
+            way = policy_.victim(set);
+
+            auto &old = lines_[set * config_.ways + way];
+            index_.erase(old.line);
+            ++evictions_;
+
+            if (old.dirty)
+                victim = old.line;
+        }
+
+        auto slot = set * config_.ways + way;
+        lines_[slot] = line_state{line, dirty};
+        index_.emplace(line, slot);
+        policy_.fill(set, way);
+
+        return victim;
+    }
+
+    cache_config config_;
+    level *next_;
+    Policy policy_;
+
+    std::vector<line_state> lines_;
+    std::vector<std::size_t> used_;
+    std::unordered_map<std::uint64_t, std::size_t> index_;
+
+    std::deque<cxxdes::sync::resource> banks_;
+    cxxdes::sync::semaphore<> mshr_slots_;
+    std::unordered_map<std::uint64_t, std::unique_ptr<mshr>> mshrs_;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+    std::uint64_t coalesced_ = 0;
+    std::uint64_t evictions_ = 0;
+    std::uint64_t writebacks_ = 0;
+};
+
+} /* namespace detail */
+
+using detail::cache;
+
+} /* namespace arch */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_ARCH_CACHE_HPP_INCLUDED */
@@ -0,0 +1,179 @@
+/**
+ * @file dram.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief DRAM timing model with channels, banks, and row buffers.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_ARCH_DRAM_HPP_INCLUDED
+#define CXXDES_ARCH_DRAM_HPP_INCLUDED
+
+#include <deque>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/mutex.hpp>
+#include <cxxdes/arch/level.hpp>
+
+namespace cxxdes {
+namespace arch {
+
+/** @brief Organization and timing parameters of a `dram`. */
+struct dram_config {
+    /** @brief Bytes transferred per access. */
+    std::size_t line_size = 64;
+
+    /** @brief Bytes per row of a bank. */
+    std::size_t row_size = 8192;
+
+    /** @brief Number of channels, each with its own data bus. */
+    std::size_t channels = 1;
+
+    /** @brief Number of banks per channel. */
+    std::size_t banks = 8;
+
+    /** @brief Activate to column command delay (tRCD). */
+    cxxdes::core::time_integral t_rcd = 14;
+
+    /** @brief Column command to data delay (CAS latency). */
+    cxxdes::core::time_integral t_cas = 14;
+
+    /** @brief Precharge delay (tRP). */
+    cxxdes::core::time_integral t_rp = 14;
+
+    /** @brief Time a line occupies the data bus of its channel. */
+    cxxdes::core::time_integral t_burst = 4;
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Open-page DRAM with per-bank row buffers and per-channel data buses.
+ *
+ * Consecutive lines fill a row before moving to the next channel and bank,
+ * so streaming accesses hit open rows. An access holds its bank while the
+ * command sequence runs: `t_cas` for a row hit, `t_rcd + t_cas` for a bank
+ * with no open row, and `t_rp + t_rcd + t_cas` for a row conflict. The row
+ * stays open afterwards. The access then occupies the data bus of its
+ * channel for `t_burst`.
+ *
+ * Only the state of the banks is kept, so the model does not grow with the
+ * simulated address space.
+ */
+struct dram: level {
+    /**
+     * @brief Constructs a DRAM.
+     *
+     * @throws std::runtime_error If the configuration is invalid.
+     */
+    explicit dram(dram_config const &config = {}): config_{config} {
+        if (config_.line_size == 0 || config_.channels == 0 || config_.banks == 0)
+            throw std::runtime_error("dram line size, channels, and banks must be positive");
+
+        if (config_.row_size < config_.line_size || config_.row_size % config_.line_size != 0)
+            throw std::runtime_error("dram row size must be a multiple of its line size");
+
+        for (std::size_t i = 0; i < config_.channels * config_.banks; ++i)
+            banks_.emplace_back();
+
+        for (std::size_t i = 0; i < config_.channels; ++i)
+            buses_.emplace_back();
+    }
+
+    dram(dram const &) = delete;
+    dram &operator=(dram const &) = delete;
+
+    coroutine<> access(addr_type addr, access_kind kind) override {
+        auto line = addr / config_.line_size;
+        auto rest = line / (config_.row_size / config_.line_size);
+        auto channel = rest % config_.channels;
+        auto row = rest / config_.channels / config_.banks;
+        auto &b = banks_[rest % (config_.channels * config_.banks)];
+
+        ++(kind == access_kind::read ? reads_ : writes_);
+
+        _Co_with(b.mtx) {
+            if (b.open && b.row == row) {
+                ++row_hits_;
+                co_await delay(config_.t_cas);
+            }
+            else if (!b.open) {
+                ++row_misses_;
+                co_await delay(config_.t_rcd + config_.t_cas);
+            }
+            else {
+                ++row_conflicts_;
+                co_await delay(config_.t_rp + config_.t_rcd + config_.t_cas);
+            }
+
+            b.open = true;
+            b.row = row;
+        };
+
+        _Co_with(buses_[channel]) {
+            co_await delay(config_.t_burst);
+        };
+    }
+
+    /** @brief Returns the configuration. */
+    dram_config const &config() const noexcept {
+        return config_;
+    }
+
+    /** @brief Returns the number of reads. */
+    std::uint64_t reads() const noexcept {
+        return reads_;
+    }
+
+    /** @brief Returns the number of writes. */
+    std::uint64_t writes() const noexcept {
+        return writes_;
+    }
+
+    /** @brief Returns the number of accesses to an open row. */
+    std::uint64_t row_hits() const noexcept {
+        return row_hits_;
+    }
+
+    /** @brief Returns the number of accesses to a bank with no open row. */
+    std::uint64_t row_misses() const noexcept {
+        return row_misses_;
+    }
+
+    /** @brief Returns the number of accesses that had to close another row. */
+    std::uint64_t row_conflicts() const noexcept {
+        return row_conflicts_;
+    }
+
+private:
+    struct bank {
+        cxxdes::sync::mutex mtx;
+        bool open = false;
+        std::uint64_t row = 0;
+    };
+
+    dram_config config_;
+
+    std::deque<bank> banks_;
+    std::deque<cxxdes::sync::mutex> buses_;
+
+    std::uint64_t reads_ = 0;
+    std::uint64_t writes_ = 0;
+    std::uint64_t row_hits_ = 0;
+    std::uint64_t row_misses_ = 0;
+    std::uint64_t row_conflicts_ = 0;
+};
+
+} /* namespace detail */
+
+using detail::dram;
+
+} /* namespace arch */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_ARCH_DRAM_HPP_INCLUDED */
@@ -0,0 +1,58 @@
+/**
+ * @file level.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Common interface of the levels of a memory hierarchy.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_ARCH_LEVEL_HPP_INCLUDED
+#define CXXDES_ARCH_LEVEL_HPP_INCLUDED
+
+#include <cstdint>
+#include <cxxdes/core/core.hpp>
+
+namespace cxxdes {
+namespace arch {
+
+/** @brief Byte address in the simulated memory. */
+using addr_type = std::uint64_t;
+
+/** @brief Kind of a memory access. */
+enum class access_kind {
+    /** @brief A load, or a line fill requested by an upper level. */
+    read,
+
+    /** @brief A store, or a writeback of a dirty line by an upper level. */
+    write
+};
+
+/**
+ * @brief Level of a memory hierarchy, such as a cache or a DRAM.
+ *
+ * `access()` returns a process that completes when the access does; levels
+ * are chained by pointing an upper level to the next level below it.
+ */
+struct level {
+    /** @brief Performs an access of kind @p kind to the byte at @p addr. */
+    virtual cxxdes::core::coroutine<> access(addr_type addr, access_kind kind) = 0;
+
+    /** @brief Equivalent to `access(addr, access_kind::read)`. */
+    cxxdes::core::coroutine<> load(addr_type addr) {
+        return access(addr, access_kind::read);
+    }
+
+    /** @brief Equivalent to `access(addr, access_kind::write)`. */
+    cxxdes::core::coroutine<> store(addr_type addr) {
+        return access(addr, access_kind::write);
+    }
+
+    virtual ~level() = default;
+};
+
+} /* namespace arch */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_ARCH_LEVEL_HPP_INCLUDED */
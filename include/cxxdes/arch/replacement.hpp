@@ -0,0 +1,257 @@
+/**
+ * @file replacement.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Constant-time cache replacement policies.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_ARCH_REPLACEMENT_HPP_INCLUDED
+#define CXXDES_ARCH_REPLACEMENT_HPP_INCLUDED
+
+#include <bit>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+namespace cxxdes {
+namespace arch {
+
+/*
+ * A replacement policy is constructed with the number of sets and ways of a
+ * cache and is told about every fill and hit:
+ *
+ *     policy(std::size_t sets, std::size_t ways);
+ *     void fill(std::size_t set, std::size_t way);  // a line was placed in way
+ *     void touch(std::size_t set, std::size_t way); // the line in way was hit
+ *     std::size_t victim(std::size_t set);          // picks the way to replace
+ *
+ * `victim()` is only called on a full set, and the picked way is filled right
+ * after.
+ */
+
+namespace detail {
+
+// doubly linked lists of the ways of each set, kept in flat index arrays
+struct way_lists {
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    way_lists(std::size_t sets, std::size_t ways, std::size_t lists):
+        ways_{ways}, lists_{lists},
+        prev_(sets * ways, npos), next_(sets * ways, npos),
+        head_(sets * lists, npos), tail_(sets * lists, npos) {
+    }
+
+    void push_back(std::size_t set, std::size_t list, std::size_t way) noexcept {
+        auto s = slot_(set, way);
+        auto &h = head_[set * lists_ + list];
+        auto &t = tail_[set * lists_ + list];
+
+        prev_[s] = t;
+        next_[s] = npos;
+
+        if (t == npos)
+            h = static_cast<std::uint32_t>(way);
+        else
+            next_[slot_(set, t)] = static_cast<std::uint32_t>(way);
+
+        t = static_cast<std::uint32_t>(way);
+    }
+
+    void remove(std::size_t set, std::size_t list, std::size_t way) noexcept {
+        auto s = slot_(set, way);
+
+        if (prev_[s] == npos)
+            head_[set * lists_ + list] = next_[s];
+        else
+            next_[slot_(set, prev_[s])] = next_[s];
+
+        if (next_[s] == npos)
+            tail_[set * lists_ + list] = prev_[s];
+        else
+            prev_[slot_(set, next_[s])] = prev_[s];
+    }
+
+    std::uint32_t front(std::size_t set, std::size_t list) const noexcept {
+        return head_[set * lists_ + list];
+    }
+
+    bool empty(std::size_t set, std::size_t list) const noexcept {
+        return front(set, list) == npos;
+    }
+
+private:
+    std::size_t slot_(std::size_t set, std::size_t way) const noexcept {
+        return set * ways_ + way;
+    }
+
+    std::size_t ways_;
+    std::size_t lists_;
+    std::vector<std::uint32_t> prev_;
+    std::vector<std::uint32_t> next_;
+    std::vector<std::uint32_t> head_;
+    std::vector<std::uint32_t> tail_;
+};
+
+inline void check_geometry(std::size_t sets, std::size_t ways) {
+    if (sets == 0 || ways == 0)
+        throw std::runtime_error("cache must have at least one set and one way");
+
+    if (ways > std::numeric_limits<std::uint32_t>::max() - 1)
+        throw std::runtime_error("cache has too many ways");
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Least recently used replacement.
+ *
+ * The ways of each set are kept in a recency list, so fills, hits and victim
+ * selection take constant time whatever the associativity is.
+ */
+struct lru {
+    lru(std::size_t sets, std::size_t ways): lists_{sets, ways, 1} {
+        detail::check_geometry(sets, ways);
+    }
+
+    void fill(std::size_t set, std::size_t way) noexcept {
+        lists_.push_back(set, 0, way);
+    }
+
+    void touch(std::size_t set, std::size_t way) noexcept {
+        lists_.remove(set, 0, way);
+        lists_.push_back(set, 0, way);
+    }
+
+    std::size_t victim(std::size_t set) noexcept {
+        auto way = lists_.front(set, 0);
+        lists_.remove(set, 0, way);
+        return way;
+    }
+
+private:
+    detail::way_lists lists_;
+};
+
+/**
+ * @brief Tree pseudo-LRU replacement.
+ *
+ * Each set keeps one bit per inner node of a binary tree over its ways,
+ * pointing away from the most recently used half. Operations walk the tree,
+ * taking time logarithmic in the associativity and one bit per way.
+ *
+ * @throws std::runtime_error From the constructor if the number of ways is
+ *         not a power of two.
+ */
+struct tree_plru {
+    tree_plru(std::size_t sets, std::size_t ways):
+        ways_{ways}, depth_{static_cast<std::size_t>(std::countr_zero(ways))},
+        bits_(sets * ways, 0) {
+        detail::check_geometry(sets, ways);
+
+        if (!std::has_single_bit(ways))
+            throw std::runtime_error("tree_plru requires a power-of-two number of ways");
+    }
+
+    void fill(std::size_t set, std::size_t way) noexcept {
+        touch(set, way);
+    }
+
+    void touch(std::size_t set, std::size_t way) noexcept {
+        auto bits = &bits_[set * ways_];
+
+        std::size_t node = 1;
+        for (auto level = depth_; level > 0; --level) {
+            auto right = (way >> (level - 1)) & 1;
+            bits[node] = static_cast<std::uint8_t>(!right);
+            node = 2 * node + right;
+        }
+    }
+
+    std::size_t victim(std::size_t set) const noexcept {
+        auto bits = &bits_[set * ways_];
+
+        std::size_t node = 1;
+        std::size_t way = 0;
+        for (auto level = depth_; level > 0; --level) {
+            way = 2 * way + bits[node];
+            node = 2 * node + bits[node];
+        }
+
+        return way;
+    }
+
+private:
+    std::size_t ways_;
+    std::size_t depth_;
+
+    // node 0 of each set is unused
+    std::vector<std::uint8_t> bits_;
+};
+
+/**
+ * @brief Static re-reference interval prediction (SRRIP) with 2-bit predictions.
+ *
+ * Lines are filled with a long predicted re-reference interval (2) and
+ * promoted to 0 on a hit; the victim is a line predicted at 3, after aging
+ * the set until one is. Scans therefore evict each other instead of the
+ * lines that are reused.
+ *
+ * The ways of a set are bucketed by prediction, and aging rotates the
+ * buckets instead of updating every way, so operations take constant time.
+ * Among the lines predicted at 3, the one that got there first is evicted.
+ */
+struct srrip {
+    srrip(std::size_t sets, std::size_t ways):
+        ways_{ways}, lists_{sets, ways, 4}, base_(sets, 0), bucket_(sets * ways, 0) {
+        detail::check_geometry(sets, ways);
+    }
+
+    void fill(std::size_t set, std::size_t way) noexcept {
+        insert_(set, way, 2);
+    }
+
+    void touch(std::size_t set, std::size_t way) noexcept {
+        lists_.remove(set, bucket_[set * ways_ + way], way);
+        insert_(set, way, 0);
+    }
+
+    std::size_t victim(std::size_t set) noexcept {
+        std::size_t rrpv = 3;
+        while (lists_.empty(set, index_(set, rrpv)))
+            --rrpv;
+
+        // ages every line of the set by 3 - rrpv
+        base_[set] = static_cast<std::uint8_t>((base_[set] + rrpv + 1) & 3);
+
+        auto list = index_(set, 3);
+        auto way = lists_.front(set, list);
+        lists_.remove(set, list, way);
+        return way;
+    }
+
+private:
+    // bucket of the lines of a set that are predicted at rrpv
+    std::size_t index_(std::size_t set, std::size_t rrpv) const noexcept {
+        return (base_[set] + rrpv) & 3;
+    }
+
+    void insert_(std::size_t set, std::size_t way, std::size_t rrpv) noexcept {
+        auto list = index_(set, rrpv);
+        bucket_[set * ways_ + way] = static_cast<std::uint8_t>(list);
+        lists_.push_back(set, list, way);
+    }
+
+    std::size_t ways_;
+    detail::way_lists lists_;
+    std::vector<std::uint8_t> base_;
+    std::vector<std::uint8_t> bucket_;
+};
+
+} /* namespace arch */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_ARCH_REPLACEMENT_HPP_INCLUDED */
@@ -22,10 +22,19 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
 
 #include <cxxdes/misc/time.hpp>
 #include <cxxdes/misc/utils.hpp>
 #include <cxxdes/misc/reference_counted.hpp>
+#include <cxxdes/misc/mpsc_queue.hpp>
 #include <cxxdes/misc/time.hpp>
 
 #if __has_include(<coroutine>)
@@ -0,0 +1,242 @@
+/**
+ * @file fork.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Continuing a simulation in forked processes.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_CORE_FORK_HPP_INCLUDED
+#define CXXDES_CORE_FORK_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <concepts>
+#include <type_traits>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/core/simulation.hpp>
+
+// fork_scenarios() needs POSIX processes and pipes
+#if __has_include(<unistd.h>) && __has_include(<sys/wait.h>)
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define CXXDES_HAS_FORK 1
+
+#else
+
+#define CXXDES_HAS_FORK 0
+
+#endif
+
+namespace cxxdes {
+namespace core {
+
+namespace detail {
+
+#if CXXDES_HAS_FORK
+
+// transfers all n bytes, retrying after signals and partial transfers
+inline bool write_all(int fd, void const *p, std::size_t n) noexcept {
+    auto bytes = static_cast<char const *>(p);
+    while (n > 0) {
+        auto r = ::write(fd, bytes, n);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0)
+            return false;
+        bytes += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+inline bool read_all(int fd, void *p, std::size_t n) noexcept {
+    auto bytes = static_cast<char *>(p);
+    while (n > 0) {
+        auto r = ::read(fd, bytes, n);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0)
+            return false;
+        bytes += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+#endif
+
+} /* namespace detail */
+
+/**
+ * @brief Continues the simulation of @p env in @p k forked processes and returns what each computes.
+ *
+ * Child `i` starts from the current state of the simulation, which it
+ * shares with the parent copy-on-write, calls `fn(i)`, and sends the result
+ * back through a pipe. `fn` typically changes a parameter of the model,
+ * runs it on, and returns its outputs, so a warm-up period run before the
+ * call is paid once instead of once per scenario. The parent is left as it
+ * was.
+ *
+ * The children run at the same time. Results are copied byte by byte, so
+ * they must be trivially copyable: pack outputs into a struct of numbers.
+ * A child leaves with `_exit()`, without destroying the simulation, and
+ * only the calling thread exists in it. A result counts only if the child
+ * sent all of it and then exited with status zero. Requires POSIX `fork()`.
+ *
+ * @throws std::runtime_error If a process cannot be forked, or a scenario
+ *         threw, was killed by a signal, exited with a nonzero status or
+ *         exited without a result; the other scenarios finish first.
+ */
+template <typename Fn>
+    requires std::is_trivially_copyable_v<std::invoke_result_t<Fn &, std::size_t>> &&
+             std::default_initializable<std::invoke_result_t<Fn &, std::size_t>>
+auto fork_scenarios([[maybe_unused]] environment &env, std::size_t k, Fn fn) -> std::vector<std::invoke_result_t<Fn &, std::size_t>> {
+    using result_type = std::invoke_result_t<Fn &, std::size_t>;
+
+#if CXXDES_HAS_FORK
+    struct child {
+        ::pid_t pid;
+        int fd;
+    };
+
+    std::vector<child> children;
+    children.reserve(k);
+
+    // output still buffered would be written once by every child
+    std::fflush(nullptr);
+
+    bool forked = true;
+    for (std::size_t i = 0; i < k; ++i) {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            forked = false;
+            break;
+        }
+
+        auto pid = ::fork();
+        if (pid < 0) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+            forked = false;
+            break;
+        }
+
+        if (pid == 0) {
+            ::close(fds[0]);
+            for (auto const &c: children)
+                ::close(c.fd);
+
+            // a status byte, then the result or the length and text of the error
+            std::string error;
+            bool sent = false;
+            try {
+                auto r = fn(i);
+                char ok = 1;
+                sent = detail::write_all(fds[1], &ok, 1) && detail::write_all(fds[1], &r, sizeof(r));
+            }
+            catch (std::exception const &e) {
+                error = e.what();
+            }
+            catch (...) {
+                error = "unknown exception";
+            }
+
+            if (!error.empty()) {
+                char ok = 0;
+                std::uint64_t size = error.size();
+                sent =
+                    detail::write_all(fds[1], &ok, 1) &&
+                    detail::write_all(fds[1], &size, sizeof(size)) &&
+                    detail::write_all(fds[1], error.data(), error.size());
+            }
+
+            std::fflush(nullptr);
+            ::_exit(sent && error.empty() ? 0 : 1);
+        }
+
+        ::close(fds[1]);
+        children.push_back(child{pid, fds[0]});
+    }
+
+    std::vector<result_type> results(children.size());
+    std::string error = forked ? "" : "cannot fork scenarios";
+
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        auto const &c = children[i];
+
+        // what the child sent: its result, the message of its exception, or neither
+        std::string thrown;
+        char ok = -1;
+        auto received = detail::read_all(c.fd, &ok, 1);
+
+        if (received && ok == 1) {
+            received = detail::read_all(c.fd, &results[i], sizeof(result_type));
+        }
+        else if (received && ok == 0) {
+            std::uint64_t size = 0;
+            if (detail::read_all(c.fd, &size, sizeof(size))) {
+                thrown.resize(size);
+                if (!detail::read_all(c.fd, thrown.data(), thrown.size()))
+                    thrown.clear();
+            }
+
+            received = false;
+        }
+        else {
+            received = false;
+        }
+
+        ::close(c.fd);
+
+        int status = 0;
+        ::pid_t waited;
+        while ((waited = ::waitpid(c.pid, &status, 0)) < 0 && errno == EINTR)
+            ;
+
+        std::string failure;
+        if (ok == 0)
+            failure = fmt::format("scenario {} threw: {}", i, thrown);
+        else if (waited < 0)
+            failure = fmt::format("cannot wait for scenario {}", i);
+        else if (WIFSIGNALED(status))
+            failure = fmt::format("scenario {} was killed by signal {}", i, WTERMSIG(status));
+        else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            failure = fmt::format("scenario {} exited with status {}", i, WIFEXITED(status) ? WEXITSTATUS(status) : status);
+        else if (!received)
+            failure = fmt::format("scenario {} exited without a result", i);
+
+        if (error.empty())
+            error = std::move(failure);
+    }
+
+    if (!error.empty())
+        throw std::runtime_error(error);
+
+    return results;
+#else
+    (void) k;
+    (void) fn;
+    throw std::runtime_error("fork_scenarios() needs fork(), which this platform lacks");
+#endif
+}
+
+/** @brief Binds `co_main()` of @p sim once and continues it in @p k forked scenarios; see above. */
+template <typename Derived, typename Fn>
+auto fork_scenarios(simulation<Derived> &sim, std::size_t k, Fn &&fn) {
+    sim.bind();
+    return fork_scenarios(sim.env, k, std::forward<Fn>(fn));
+}
+
+} /* namespace core */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_CORE_FORK_HPP_INCLUDED */
@@ -46,7 +46,7 @@ struct await_ops_mixin {
             derived().coro_data.get(),
             derived().coro_data->env()->current_coroutine()
         };
-        derived().coro_data->env()->loc_ = loc;
+        derived().coro_data->env()->track_loc_(loc);
         result.a.await_bind(
             derived().coro_data->env(),
             derived().coro_data->priority());
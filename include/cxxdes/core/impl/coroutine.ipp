@@ -121,6 +121,29 @@ struct coroutine:
         return std::move(*this);
     }
 
+    /** @brief Returns the partition of the process. */
+    [[nodiscard]]
+    partition_type partition() const noexcept {
+        return coro_data_->partition();
+    }
+
+    /**
+     * @brief Sets the partition of the process and returns this lvalue.
+     *
+     * Unless set, a process takes the partition of the process that starts
+     * it, and a process bound from outside any process belongs to none.
+     */
+    auto &partition(partition_type partition) & noexcept {
+        coro_data_->partition(partition);
+        return *this;
+    }
+
+    /** @brief Sets the partition of the process and returns this rvalue. */
+    auto &&partition(partition_type partition) && noexcept {
+        coro_data_->partition(partition);
+        return std::move(*this);
+    }
+
     /** @brief Returns the process start latency in simulation ticks. */
     [[nodiscard]]
     time_integral latency() const noexcept {
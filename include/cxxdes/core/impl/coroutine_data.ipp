@@ -57,6 +57,15 @@ struct coroutine_data: memory::reference_counted_base<coroutine_data> {
         priority_ = priority;
     }
 
+    [[nodiscard]]
+    partition_type partition() const noexcept {
+        return partition_;
+    }
+
+    void partition(partition_type partition) noexcept {
+        partition_ = partition;
+    }
+
     [[nodiscard]]
     time_integral latency() const noexcept {
         return latency_;
@@ -135,6 +144,7 @@ protected:
     util::source_location created_;
     util::source_location awaited_;
     priority_type priority_ = priority_consts::inherit;
+    partition_type partition_ = partition_consts::inherit;
     time_integral latency_ = 0;
     memory::ptr<coroutine_data> parent_;
     bool complete_ = false;
@@ -3,6 +3,9 @@ using coroutine_handle = std::coroutine_handle<>;
 /** @brief Integral priority used to order events scheduled for the same time. */
 using priority_type = std::intmax_t;
 
+/** @brief Identifier of the partition a process belongs to; see `environment::parallel_partitions()`. */
+using partition_type = std::size_t;
+
 /** @brief Integral simulation timestamp measured in environment precision ticks. */
 using time_integral = std::intmax_t;
 
@@ -40,3 +43,13 @@ constexpr priority_type lowest = inherit - 1;
 constexpr priority_type zero = static_cast<priority_type>(0);
 
 }
+
+namespace partition_consts {
+
+/** @brief Partition of processes that never run in parallel with others. */
+constexpr partition_type none = std::numeric_limits<partition_type>::max();
+
+/** @brief Sentinel that asks a process to take the partition of the process that starts it. */
+constexpr partition_type inherit = none - 1;
+
+}
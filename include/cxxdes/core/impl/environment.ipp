@@ -1,3 +1,31 @@
+/** @brief What `environment::step()` does with an event posted for a time that has already passed. */
+enum class late_post_policy {
+    /** @brief Runs it at the current time. */
+    run_now,
+
+    /** @brief Discards it, counting it in `environment::dropped_posts()`. */
+    drop,
+
+    /** @brief Discards it and throws `std::runtime_error`. */
+    fail
+};
+
+namespace detail {
+
+template <typename F>
+struct posted_handler: token_handler {
+    F f;
+
+    explicit posted_handler(F f_): f{std::move(f_)} {
+    }
+
+    void invoke(token *) override {
+        f();
+    }
+};
+
+} /* namespace detail */
+
 /**
  * @brief Owns simulation time and the scheduled event queue.
  *
@@ -7,7 +35,7 @@
  * `time_unit()` and `time_precision()`.
  *
  * The environment owns scheduled coroutine state after binding. It is not
- * thread-safe.
+ * thread-safe, except for `post()`.
  */
 struct environment {
     /**
@@ -92,11 +120,116 @@ struct environment {
      * cleared by `reset()`.
      */
     void schedule_token(token *tkn) {
-        used_ = true;
         tkn->ref();
+
+        if (tkn->cancelled) {
+            tkn->unref();
+            return ;
+        }
+
+        // a partition of a batch schedules into its own list, committed after the batch
+        if (batching_) {
+            current_batch_()->scheduled.push_back(tkn);
+            return ;
+        }
+
+        used_ = true;
         tokens_.push(tkn);
     }
 
+    /**
+     * @brief Cancels @p tkn, so that it is neither processed nor advances time.
+     *
+     * A scheduled token stays in the event queue until it reaches the front,
+     * where it is freed, or until cancelled tokens make up half of the queue,
+     * which is then rebuilt without them. A token cancelled before it is
+     * scheduled is never scheduled.
+     */
+    void cancel_token(token *tkn) {
+        if (tkn->cancelled)
+            return ;
+
+        tkn->cancelled = true;
+
+        // the event queue is left to the thread that commits the batch
+        if (batching_)
+            return ;
+
+        ++cancelled_;
+        drop_cancelled_();
+
+        if (2 * cancelled_ > tokens_.size()) {
+            tokens_.remove_cancelled();
+            cancelled_ = 0;
+        }
+    }
+
+    /**
+     * @brief Schedules @p f to be called at time @p t; may be called from any thread.
+     *
+     * Posted events wait in a lock-free queue, which `step()` empties into the
+     * event queue before every event, so a thread that posts never waits for
+     * the simulation and the simulation never waits for it. Events posted for
+     * a time that has passed by then are handled as `late_posts()` says;
+     * posting for time zero thus asks for the earliest possible time.
+     *
+     * @p f runs on the thread that runs the simulation, as an event at
+     * priority zero; it may bind processes, trigger `sync` primitives, and
+     * read `now()`.
+     */
+    template <typename F>
+        requires std::invocable<F &>
+    void post(time_integral t, F f) {
+        auto tkn = new token(t, priority_consts::zero, nullptr, "posted event");
+        tkn->handler = new detail::posted_handler<F>{std::move(f)};
+        post(t, tkn);
+    }
+
+    /**
+     * @brief Schedules @p tkn at time @p t, setting its time; may be called from any thread.
+     *
+     * As the callable overload, for tokens that the posting thread creates and
+     * no other thread refers to.
+     */
+    void post(time_integral t, token *tkn) {
+        tkn->time = t;
+        tkn->ref();
+        posts_.push(tkn);
+    }
+
+    /** @brief Sets what happens to events posted for a time that has already passed; `run_now` by default. */
+    void late_posts(late_post_policy policy) noexcept {
+        late_posts_ = policy;
+    }
+
+    /** @brief Returns what happens to events posted for a time that has already passed. */
+    late_post_policy late_posts() const noexcept {
+        return late_posts_;
+    }
+
+    /**
+     * @brief Moves the events posted so far into the event queue, as `step()` does first.
+     *
+     * Lets a loop that waits between events, such as `run_realtime()`, notice
+     * posted events without running one.
+     *
+     * @return Whether any event had been posted.
+     * @throws std::runtime_error If an event posted for a time that has passed
+     *         arrives under `late_post_policy::fail`.
+     */
+    bool take_posts() {
+        if (posts_.empty())
+            return false;
+
+        take_posts_();
+        return true;
+    }
+
+    /** @brief Returns the number of posted events dropped for being late. */
+    std::uint64_t dropped_posts() const noexcept {
+        return dropped_posts_;
+    }
+
     /** @brief Returns the next scheduled token without removing it, or null. */
     [[nodiscard]]
     token *next_event() const noexcept {
@@ -113,17 +246,44 @@ struct environment {
      *
      * @note Exceptions propagated by token handlers or exception tokens are
      *       rethrown to the caller.
+     * @throws std::runtime_error If an event posted for a time that has passed
+     *         arrives under `late_post_policy::fail`.
      */
     bool step() {
+        if (!posts_.empty())
+            take_posts_();
+
+        drop_cancelled_();
+
         if (tokens_.empty())
             return false;
+
+        if (executor_ && partitioned_(tokens_.top())) {
+            step_partitions_();
+            return true;
+        }
         
         auto tkn = memory::ptr{tokens_.top()};
         tkn->unref() /* tkn already holds a reference now */;
         tkn->attempt_access();
         tokens_.pop();
+        drop_cancelled_();
 
         now_ = std::max(tkn->time, now_);
+        dispatch(tkn);
+        
+        return true;
+    }
+
+    /**
+     * @brief Processes @p tkn now, exactly as `step()` processes a popped token.
+     *
+     * This lets one scheduled token deliver a batch of tokens that are not
+     * scheduled themselves. The caller keeps @p tkn alive during the call.
+     */
+    void dispatch(token *tkn) {
+        if (tkn->cancelled)
+            return ;
 
         if (tkn->handler) {
             try {
@@ -141,8 +301,64 @@ struct environment {
         else if (tkn->eptr) {
             std::rethrow_exception(tkn->eptr);
         }
-        
-        return true;
+    }
+
+    /**
+     * @brief Runs @p n tasks, possibly at the same time, and returns once all have finished.
+     *
+     * Task `i` is `task(i)`. An executor over `experiment::thread_pool` is
+     * `[&pool](std::size_t n, auto const &task) { pool.parallel_for(n, task); }`.
+     */
+    using batch_executor = std::function<void(std::size_t n, std::function<void(std::size_t)> const &task)>;
+
+    /**
+     * @brief Resumes the processes of distinct partitions that are ready at the same time in parallel.
+     *
+     * Once set, whenever the next events are resumptions of processes tagged
+     * with a partition (see `coroutine::partition()`), `step()` takes all of
+     * them at the current time and priority, groups them by partition, and
+     * runs the groups as tasks of @p executor; a null executor turns this off.
+     *
+     * While the groups run, the events that a partition schedules, including
+     * those of the processes it starts, are kept aside and committed after all
+     * groups have finished, partition by partition in increasing order of
+     * partition and in the order they were scheduled. The outcome therefore
+     * does not depend on the number of threads or on their timing.
+     *
+     * An event that a partition schedules for the current time at a more
+     * urgent priority than the batch runs within the batch, before the next
+     * event of the partition, as it would in a serial run; it must resume a
+     * process of the same partition, or `step()` throws once the batch is
+     * committed. With that, a run may differ from one without an executor
+     * only in the order of events at the same time and priority, and in the
+     * order of events of distinct partitions, which do not observe each other.
+     *
+     * During a batch, the processes of a partition must touch only objects of
+     * their own partition. They may start processes of other partitions and
+     * schedule events for them, but must not share `sync` primitives with them;
+     * such processes synchronize through time, for example by resuming at
+     * alternating clock edges, or through processes outside any partition.
+     *
+     * @throws The exception thrown by `step()` when a group throws, after the
+     *         batch is committed; that of the smallest partition wins.
+     */
+    void parallel_partitions(batch_executor executor) {
+        executor_ = std::move(executor);
+    }
+
+    /** @brief Returns the number of batches whose partitions ran in parallel so far. */
+    std::uint64_t partition_batches() const noexcept {
+        return partition_batches_;
+    }
+
+    /** @brief Returns the number of tokens in the event queue, including cancelled ones not freed yet. */
+    std::size_t scheduled_events() const noexcept {
+        return tokens_.size();
+    }
+
+    /** @brief Returns the number of events the queue holds before it allocates again. */
+    std::size_t event_capacity() const noexcept {
+        return tokens_.capacity();
     }
 
     /**
@@ -150,8 +366,11 @@ struct environment {
      *
      * Simulation time is reset to zero. The configured time unit and precision
      * are left unchanged.
+     *
+     * @param keep_capacity Keeps the storage of the event queue and of the set
+     *        of managed coroutines for the next run, instead of releasing it.
      */
-    void reset() {
+    void reset(bool keep_capacity = false) {
         // it is not safe to iterate over the coroutines while
         // individual coroutines might actively modify the
         // unoredered_set. move from it.
@@ -160,6 +379,9 @@ struct environment {
         // sadly, we cannot apply this solution.
         auto coroutines = std::move(coroutines_);
 
+        while (auto tkn = posts_.pop())
+            (*tkn)->unref();
+
         for (auto coroutine: coroutines) {
             if (!coroutine->complete()) {
                 coroutine->destroy();
@@ -172,9 +394,37 @@ struct environment {
             tkn->unref();
         }
 
+        if (keep_capacity) {
+            // clearing keeps the buckets; take back whatever the destroyed
+            // coroutines registered meanwhile
+            coroutines.clear();
+            coroutines.merge(coroutines_);
+            coroutines_.swap(coroutines);
+        }
+        else {
+            tokens_ = decltype(tokens_){};
+        }
+
+        cancelled_ = 0;
         now_ = 0;
     }
 
+    /**
+     * @brief Prepares the environment for another run, as if it were new.
+     *
+     * Equivalent to `reset(true)`, after which the time unit and precision may
+     * be set again, and `dropped_posts()` and `partition_batches()` count from
+     * zero. Settings such as `late_posts()` and `parallel_partitions()` are
+     * kept. Back-to-back replications that recycle one environment reuse the
+     * storage grown by the previous run.
+     */
+    void recycle() {
+        reset(true);
+        used_ = false;
+        dropped_posts_ = 0;
+        partition_batches_ = 0;
+    }
+
     /** @brief Runs scheduled events until the queue is empty. */
     auto &run() {
         while (step());
@@ -188,6 +438,9 @@ struct environment {
      * advances to @p t.
      */
     auto &run_until(time_integral t) {
+        if (!posts_.empty())
+            take_posts_();
+
         while (next_event() && next_event()->time <= t)
             step();
 
@@ -224,13 +477,13 @@ struct environment {
 
     /** @brief Returns the coroutine currently being resumed, or null. */
     coroutine_data_ptr current_coroutine() const noexcept {
-        return current_coroutine_;
+        return batching_ ? current_batch_()->current : current_coroutine_;
     }
 
     /** @brief Returns the source location recorded by the current await transform. */
     [[nodiscard]]
     util::source_location const &loc() const noexcept {
-        return loc_;
+        return batching_ ? current_batch_()->loc : loc_;
     }
 
     ~environment() {
@@ -260,7 +513,38 @@ private:
         }
     };
 
-    std::priority_queue<token *, std::vector<token *>, token_comp> tokens_;
+    struct token_queue: std::priority_queue<token *, std::vector<token *>, token_comp> {
+        std::size_t capacity() const noexcept {
+            return this->c.capacity();
+        }
+
+        // frees the cancelled tokens and restores the heap over the rest
+        void remove_cancelled() {
+            auto first = std::partition(this->c.begin(), this->c.end(), [](token *tkn) { return !tkn->cancelled; });
+            for (auto it = first; it != this->c.end(); ++it)
+                (*it)->unref();
+
+            this->c.erase(first, this->c.end());
+            std::make_heap(this->c.begin(), this->c.end(), this->comp);
+        }
+    };
+
+    token_queue tokens_;
+
+    // cancelled tokens still in tokens_, as far as cancel_token() knows
+    std::size_t cancelled_ = 0;
+
+    // keeps a cancelled token from being the next event
+    void drop_cancelled_() noexcept {
+        while (!tokens_.empty() && tokens_.top()->cancelled) {
+            auto tkn = tokens_.top();
+            tokens_.pop();
+            tkn->unref();
+
+            if (cancelled_ > 0)
+                --cancelled_;
+        }
+    }
     
     friend struct coroutine_data;
 
@@ -276,6 +560,77 @@ private:
     std::unordered_set<memory::ptr<coroutine_data>> coroutines_;
     coroutine_data_ptr current_coroutine_ = nullptr;
     util::source_location loc_;
+
+    // what one partition of a batch changes, applied once the batch ends
+    struct batch {
+        coroutine_data_ptr current = nullptr;
+        util::source_location loc;
+        std::vector<token *> scheduled;
+        std::vector<std::pair<memory::ptr<coroutine_data>, bool>> managed;
+        std::exception_ptr error;
+    };
+
+    // events posted by other threads, and what to do with the late ones
+    util::mpsc_queue<token *> posts_;
+    late_post_policy late_posts_ = late_post_policy::run_now;
+    std::uint64_t dropped_posts_ = 0;
+
+    void take_posts_() {
+        while (auto posted = posts_.pop()) {
+            auto tkn = *posted;
+
+            if (tkn->time < now_) {
+                if (late_posts_ == late_post_policy::run_now) {
+                    tkn->time = now_;
+                }
+                else {
+                    auto t = tkn->time;
+                    tkn->unref();
+
+                    if (late_posts_ == late_post_policy::drop) {
+                        ++dropped_posts_;
+                        continue;
+                    }
+
+                    throw std::runtime_error(fmt::format("event posted for time {} arrived at time {}", t, now_));
+                }
+            }
+
+            // post() took the reference of the queue
+            used_ = true;
+            tokens_.push(tkn);
+        }
+    }
+
+    batch_executor executor_;
+    bool batching_ = false;
+    std::uint64_t partition_batches_ = 0;
+
+    // batch of the partition run by this thread
+    static batch *&current_batch_() noexcept {
+        static thread_local batch *b = nullptr;
+        return b;
+    }
+
+    void track_loc_(util::source_location const &loc) noexcept {
+        if (batching_)
+            current_batch_()->loc = loc;
+        else
+            loc_ = loc;
+    }
+
+    void manage_(coroutine_data *coro_data, bool managed) {
+        if (batching_)
+            current_batch_()->managed.emplace_back(coro_data, managed);
+        else if (managed)
+            coroutines_.insert(coro_data);
+        else
+            coroutines_.erase(coro_data);
+    }
+
+    static bool partitioned_(token const *tkn) noexcept;
+
+    void step_partitions_();
 };
 
 inline
@@ -294,6 +649,9 @@ void coroutine_data::bind_(environment *env, priority_type priority) {
 
     if (priority_ == priority_consts::inherit)
         priority_ = priority;
+
+    if (partition_ == partition_consts::inherit)
+        partition_ = parent_ ? parent_->partition_ : partition_consts::none;
     
     auto start_token = new token{
         env_->now() + latency_,
@@ -308,12 +666,162 @@ void coroutine_data::bind_(environment *env, priority_type priority) {
 
 inline
 void coroutine_data::manage_() {
-    env_->coroutines_.insert(this);
+    env_->manage_(this, true);
 }
 
 inline
 void coroutine_data::unmanage_() {
-    env_->coroutines_.erase(this);
+    env_->manage_(this, false);
+}
+
+inline
+bool environment::partitioned_(token const *tkn) noexcept {
+    return
+        !tkn->handler &&
+        tkn->coro_data &&
+        tkn->coro_data->partition() != partition_consts::none;
+}
+
+inline
+void environment::step_partitions_() {
+    auto first = tokens_.top();
+    auto time = first->time;
+    auto priority = first->priority;
+
+    // the resumptions of partitioned processes at this time and priority, by partition
+    std::vector<std::pair<partition_type, std::vector<memory::ptr<token>>>> groups;
+
+    while (!tokens_.empty()) {
+        auto tkn = tokens_.top();
+        if (tkn->time != time || tkn->priority != priority || !partitioned_(tkn))
+            break;
+
+        auto partition = tkn->coro_data->partition();
+        auto it = std::find_if(groups.begin(), groups.end(), [&](auto const &g) { return g.first == partition; });
+        if (it == groups.end())
+            it = groups.insert(groups.end(), { partition, {} });
+
+        it->second.emplace_back(tkn);
+        tkn->unref() /* the group holds a reference now */;
+        tokens_.pop();
+    }
+
+    std::sort(groups.begin(), groups.end(), [](auto const &a, auto const &b) { return a.first < b.first; });
+
+    now_ = std::max(time, now_);
+
+    std::vector<batch> batches(groups.size());
+    auto run = [&](std::size_t i) {
+        auto &b = batches[i];
+        current_batch_() = &b;
+
+        auto &tokens = groups[i].second;
+        std::size_t k = 0;
+
+        auto resume = [&](token *tkn) {
+            tkn->attempt_access();
+            b.current = tkn->coro_data;
+            tkn->coro_data->resume();
+            b.current = nullptr;
+        };
+
+        // events scheduled now, ahead of the batch priority, would run next
+        // in a serial run; those of this partition run here, in priority order
+        auto run_urgent = [&]() {
+            while (true) {
+                auto urgent = b.scheduled.end();
+                for (auto it = b.scheduled.begin(); it != b.scheduled.end(); ++it) {
+                    auto tkn = *it;
+
+                    // exceptions are left to step(), and cancelled tokens are dropped once committed
+                    if (tkn->cancelled || (!tkn->handler && !tkn->coro_data && tkn->eptr))
+                        continue;
+
+                    if (tkn->time <= now_ && tkn->priority < priority &&
+                        (urgent == b.scheduled.end() || tkn->priority < (*urgent)->priority))
+                        urgent = it;
+                }
+
+                if (urgent == b.scheduled.end())
+                    return ;
+
+                auto tkn = memory::ptr{*urgent};
+
+                // such as the completion of a process started by async(), which resumes nothing
+                bool empty = !tkn->handler && !tkn->coro_data;
+
+                if (!empty && (!partitioned_(tkn.get()) || tkn->coro_data->partition() != groups[i].first))
+                    throw std::runtime_error(fmt::format(
+                        "partition {} scheduled an event of another partition ahead of its batch at time {}",
+                        groups[i].first, now_));
+
+                tkn->unref() /* tkn holds the reference of the list now */;
+                b.scheduled.erase(urgent);
+
+                if (!empty)
+                    resume(tkn.get());
+            }
+        };
+
+        try {
+            for (; k < tokens.size(); ++k) {
+                resume(tokens[k].get());
+                run_urgent();
+            }
+        }
+        catch (...) {
+            b.error = std::current_exception();
+            b.current = nullptr;
+
+            // as after a throwing step(), the events not run yet stay scheduled
+            for (++k; k < tokens.size(); ++k) {
+                tokens[k]->ref();
+                b.scheduled.push_back(tokens[k].get());
+            }
+        }
+
+        current_batch_() = nullptr;
+    };
+
+    batching_ = true;
+
+    try {
+        if (groups.size() == 1) {
+            run(0);
+        }
+        else {
+            ++partition_batches_;
+            executor_(groups.size(), run);
+        }
+    }
+    catch (...) {
+        batching_ = false;
+        throw;
+    }
+
+    batching_ = false;
+
+    std::exception_ptr error;
+    for (auto &b: batches) {
+        for (auto tkn: b.scheduled) {
+            if (tkn->cancelled)
+                tkn->unref();
+            else
+                tokens_.push(tkn);
+        }
+
+        for (auto &[coro_data, managed]: b.managed)
+            manage_(coro_data.get(), managed);
+
+        if (b.error && !error)
+            error = b.error;
+    }
+
+    // a token cancelled by the batch may be next
+    drop_cancelled_();
+
+    if (error)
+        std::rethrow_exception(error);
 }
 
 namespace detail {
@@ -34,6 +34,9 @@ struct token: memory::reference_counted_base<token> {
     // exception to be propagated
     std::exception_ptr eptr = nullptr;
 
+    // set by environment::cancel_token(); the token is then dropped unprocessed
+    bool cancelled = false;
+
     #ifdef CXXDES_DEBUG_TOKEN
     // a non-owning string describing the token
     const char *what = nullptr;
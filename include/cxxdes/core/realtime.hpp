@@ -0,0 +1,245 @@
+/**
+ * @file realtime.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Running a simulation paced by the wall clock.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_CORE_REALTIME_HPP_INCLUDED
+#define CXXDES_CORE_REALTIME_HPP_INCLUDED
+
+#include <chrono>
+#include <thread>
+#include <limits>
+#include <cmath>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/core/simulation.hpp>
+#include <cxxdes/stats/tally.hpp>
+#include <cxxdes/stats/tdigest.hpp>
+
+// run_realtime() sleeps until absolute deadlines where it can
+#if defined(__linux__) && __has_include(<time.h>)
+
+#include <time.h>
+
+#define CXXDES_HAS_CLOCK_NANOSLEEP 1
+
+#else
+
+#define CXXDES_HAS_CLOCK_NANOSLEEP 0
+
+#endif
+
+namespace cxxdes {
+namespace core {
+
+/** @brief What `run_realtime()` does when it falls behind the wall clock. */
+enum class realtime_mode {
+    /** @brief Runs late events at once, without waiting, until the run catches up. */
+    best_effort,
+
+    /** @brief Throws `std::runtime_error` once an event is later than the tolerance. */
+    strict
+};
+
+/** @brief Settings of `run_realtime()`. */
+struct realtime_config {
+    /** @brief What to do when the run falls behind. */
+    realtime_mode mode = realtime_mode::best_effort;
+
+    /** @brief Lateness allowed under `realtime_mode::strict`. */
+    std::chrono::nanoseconds tolerance = std::chrono::milliseconds{1};
+
+    /** @brief Last part of a wait spent spinning rather than sleeping, which trades CPU time for low timer jitter. */
+    std::chrono::nanoseconds spin = std::chrono::microseconds{100};
+
+    /** @brief Longest sleep between looks for posted events. */
+    std::chrono::nanoseconds poll = std::chrono::milliseconds{1};
+
+    /** @brief Simulation time at which the run stops, after waiting for it; by default, once no event is left. */
+    time_integral until = std::numeric_limits<time_integral>::max();
+};
+
+/**
+ * @brief How closely `run_realtime()` kept to the wall clock.
+ *
+ * Every distinct simulation time reached is a step. A step that the run
+ * reached before its wall deadline adds how early it was to `slack` and, once
+ * the wait is over, how late the wake-up was to `jitter`; a step reached after
+ * its deadline adds how late it was to `overrun`. All are in seconds.
+ */
+struct realtime_report {
+    /** @brief Number of steps. */
+    std::uint64_t steps = 0;
+
+    /** @brief Slack of the steps that were on time. */
+    stats::tally slack;
+
+    /** @brief Quantiles of `slack`. */
+    stats::tdigest slack_quantiles;
+
+    /** @brief Delay between the deadline and the wake-up of the steps that waited. */
+    stats::tally jitter;
+
+    /** @brief Lateness of the steps that were late. */
+    stats::tally overrun;
+
+    /** @brief Quantiles of `overrun`. */
+    stats::tdigest overrun_quantiles;
+};
+
+namespace detail {
+
+// sleeps until the steady clock reaches deadline
+inline void sleep_until(std::chrono::steady_clock::time_point deadline) {
+#if CXXDES_HAS_CLOCK_NANOSLEEP
+    // the steady clock is CLOCK_MONOTONIC, and an absolute deadline does not
+    // drift by the time it takes to compute a relative one
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+
+    ::timespec ts;
+    ts.tv_sec = static_cast<decltype(ts.tv_sec)>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<decltype(ts.tv_nsec)>(ns % 1'000'000'000);
+
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Runs the events of @p env no faster than the wall clock, @p factor simulated seconds per second.
+ *
+ * The run maps simulation time to wall time from the moment of the call,
+ * through `time_precision()`, and waits until the wall deadline of each
+ * event before running it: it sleeps until shortly before the deadline and
+ * spins for the rest, looking for `post()`ed events meanwhile, so that an
+ * external thread may inject events while the simulation waits.
+ *
+ * An event reached after its deadline runs at once, so the run catches
+ * up, under `realtime_mode::best_effort`, and throws if it is later than
+ * the tolerance under `realtime_mode::strict`. Deadlines stay tied to the
+ * start of the run, so lateness does not accumulate; events at the
+ * current time, if any, mark that start and are never late.
+ *
+ * @throws std::runtime_error If @p factor is not positive, or a strict run
+ *         falls behind.
+ */
+inline
+realtime_report run_realtime(environment &env, real_type factor, realtime_config const &config = {}) {
+    using clock = std::chrono::steady_clock;
+
+    if (!(factor > 0))
+        throw std::runtime_error("real-time factor must be positive");
+
+    auto seconds = [](clock::duration d) {
+        return std::chrono::duration<double>(d).count();
+    };
+
+    auto start = clock::now();
+    auto origin = env.now();
+    auto ns_per_tick = env.time_precision().seconds<double>() * 1e9 / factor;
+
+    auto deadline_of = [&](time_integral t) {
+        return start + std::chrono::nanoseconds{std::llround(static_cast<double>(t - origin) * ns_per_tick)};
+    };
+
+    // waits until deadline, or returns false as soon as events are posted
+    auto wait = [&](clock::time_point deadline) {
+        while (true) {
+            auto now = clock::now();
+            if (now >= deadline)
+                return true;
+
+            if (env.take_posts())
+                return false;
+
+            if (deadline - now > config.spin)
+                detail::sleep_until(std::min(deadline - config.spin, now + config.poll));
+        }
+    };
+
+    realtime_report report;
+    auto last = origin;
+    bool reached = false;
+
+    while (true) {
+        env.take_posts();
+
+        auto tkn = env.next_event();
+        bool event = tkn && tkn->time <= config.until;
+        if (!event && config.until == std::numeric_limits<time_integral>::max())
+            break;
+
+        auto t = event ? std::max(tkn->time, env.now()) : config.until;
+
+        if (!reached && t == origin) {
+            // the step at the start of the run is due as soon as it is reached,
+            // so the wall clock is tied to it, and it is never late
+            start = clock::now();
+
+            report.slack.add(0);
+            report.slack_quantiles.add(0);
+            report.jitter.add(0);
+
+            ++report.steps;
+            reached = true;
+            last = t;
+        }
+        else if (!reached || t != last) {
+            auto deadline = deadline_of(t);
+            auto ahead = deadline - clock::now();
+
+            if (ahead.count() > 0) {
+                if (!wait(deadline))
+                    continue;
+
+                report.slack.add(seconds(ahead));
+                report.slack_quantiles.add(seconds(ahead));
+                report.jitter.add(seconds(clock::now() - deadline));
+            }
+            else {
+                if (config.mode == realtime_mode::strict && -ahead > config.tolerance)
+                    throw std::runtime_error(fmt::format(
+                        "real-time run fell {:.6f} s behind at time {}", seconds(-ahead), t));
+
+                report.overrun.add(seconds(-ahead));
+                report.overrun_quantiles.add(seconds(-ahead));
+            }
+
+            ++report.steps;
+            reached = true;
+            last = t;
+        }
+
+        if (!event) {
+            // no event is left before the end, so this only advances the time
+            env.run_until(config.until);
+            break;
+        }
+
+        env.step();
+    }
+
+    return report;
+}
+
+/** @brief Binds `co_main()` of @p sim once and runs its environment paced by the wall clock; see above. */
+template <typename Derived>
+realtime_report run_realtime(simulation<Derived> &sim, real_type factor, realtime_config const &config = {}) {
+    sim.bind();
+    return run_realtime(sim.env, factor, config);
+}
+
+} /* namespace core */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_CORE_REALTIME_HPP_INCLUDED */
@@ -59,6 +59,16 @@ struct simulation {
         bind();
         env.run_for(std::forward<T>(t));
     }
+
+    /**
+     * @brief Recycles `env`, so that the next `run()` binds `co_main()` again.
+     *
+     * The members of the derived simulation are left to the caller to reset.
+     */
+    void recycle() {
+        env.recycle();
+        bound_ = false;
+    }
     
 private:
     auto derived() noexcept -> auto& {
@@ -71,8 +81,13 @@ private:
 
     bool bound_ = false;
 
-protected:
-    /** @brief Binds `Derived::co_main()` to `env` if it has not been bound yet. */
+public:
+    /**
+     * @brief Binds `Derived::co_main()` to `env` if it has not been bound yet.
+     *
+     * Runners outside this class, such as `run_realtime(sim, ...)`, call it
+     * before running `env` themselves.
+     */
     void bind() {
         if (!bound_) {
             env.bind(derived().co_main());
@@ -14,12 +14,69 @@
 // core
 #include <cxxdes/core/core.hpp>
 #include <cxxdes/core/simulation.hpp>
+#include <cxxdes/core/realtime.hpp>
+#include <cxxdes/core/fork.hpp>
 
 // sync
 #include <cxxdes/sync/event.hpp>
 #include <cxxdes/sync/mutex.hpp>
+#include <cxxdes/sync/shared_mutex.hpp>
 #include <cxxdes/sync/queue.hpp>
+#include <cxxdes/sync/priority_store.hpp>
+#include <cxxdes/sync/filter_store.hpp>
+#include <cxxdes/sync/container.hpp>
+#include <cxxdes/sync/broadcast.hpp>
+#include <cxxdes/sync/medium.hpp>
+#include <cxxdes/sync/select.hpp>
+#include <cxxdes/sync/timed.hpp>
 #include <cxxdes/sync/semaphore.hpp>
 #include <cxxdes/sync/resource.hpp>
+#include <cxxdes/sync/arbiter.hpp>
+#include <cxxdes/sync/barrier.hpp>
+#include <cxxdes/sync/latch.hpp>
+#include <cxxdes/sync/monitor.hpp>
+
+// arch
+#include <cxxdes/arch/level.hpp>
+#include <cxxdes/arch/replacement.hpp>
+#include <cxxdes/arch/cache.hpp>
+#include <cxxdes/arch/dram.hpp>
+
+// net
+#include <cxxdes/net/packet.hpp>
+#include <cxxdes/net/network.hpp>
+#include <cxxdes/net/topology.hpp>
+
+// stats
+#include <cxxdes/stats/tally.hpp>
+#include <cxxdes/stats/time_weighted.hpp>
+#include <cxxdes/stats/histogram.hpp>
+#include <cxxdes/stats/tdigest.hpp>
+#include <cxxdes/stats/confidence.hpp>
+
+// sources
+#include <cxxdes/sources/source.hpp>
+#include <cxxdes/sources/generators.hpp>
+
+// queueing
+#include <cxxdes/queueing/job.hpp>
+#include <cxxdes/queueing/source.hpp>
+#include <cxxdes/queueing/station.hpp>
+#include <cxxdes/queueing/router.hpp>
+#include <cxxdes/queueing/sink.hpp>
+#include <cxxdes/queueing/analytic.hpp>
+
+// experiment
+#include <cxxdes/experiment/thread_pool.hpp>
+#include <cxxdes/experiment/replications.hpp>
+#include <cxxdes/experiment/sweep.hpp>
+
+// parallel
+#include <cxxdes/parallel/channel.hpp>
+#include <cxxdes/parallel/engine.hpp>
+#include <cxxdes/parallel/transport.hpp>
+#include <cxxdes/parallel/socket_transport.hpp>
+#include <cxxdes/parallel/shm_transport.hpp>
+#include <cxxdes/parallel/node.hpp>
 
 #endif /* CXXDES_HPP_INCLUDED */
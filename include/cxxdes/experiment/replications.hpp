@@ -0,0 +1,324 @@
+/**
+ * @file replications.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Independent replications run in parallel until a confidence interval is narrow enough.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_EXPERIMENT_REPLICATIONS_HPP_INCLUDED
+#define CXXDES_EXPERIMENT_REPLICATIONS_HPP_INCLUDED
+
+#include <cmath>
+#include <mutex>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <functional>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/stats/tally.hpp>
+#include <cxxdes/stats/confidence.hpp>
+#include <cxxdes/experiment/thread_pool.hpp>
+
+namespace cxxdes {
+namespace experiment {
+
+/**
+ * @brief Returns the seed of replication @p index of an experiment seeded with @p base.
+ *
+ * Seeds are spread with SplitMix64, so that neighbouring indices and bases
+ * give unrelated streams even for engines seeded with a single integer.
+ */
+inline std::uint64_t replication_seed(std::uint64_t base, std::uint64_t index) noexcept {
+    auto mix = [](std::uint64_t z) {
+        z += 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    };
+
+    return mix(base ^ mix(index));
+}
+
+/** @brief One replication of an experiment. */
+struct replication {
+    /** @brief Position of the replication, from zero. */
+    std::size_t index;
+
+    /** @brief Seed for the random number engines of the replication. */
+    std::uint64_t seed;
+};
+
+/** @brief Settings of `run_replications()`. */
+struct replication_config {
+    /** @brief Replications run before the stopping rule is checked. */
+    std::size_t min_replications = 10;
+
+    /** @brief Replications run at most. */
+    std::size_t max_replications = 1000;
+
+    /** @brief Confidence level of the interval of the mean metric. */
+    double confidence = 0.95;
+
+    /** @brief Stops once the half-width is at most this much; zero disables the target. */
+    double half_width = 0;
+
+    /** @brief Stops once the half-width is at most this fraction of the mean; zero disables the target. */
+    double relative_half_width = 0;
+
+    /** @brief Seed of the experiment, from which every replication derives its own. */
+    std::uint64_t seed = 1;
+
+    /** @brief Worker threads; zero uses one per hardware thread. */
+    std::size_t threads = 0;
+};
+
+namespace detail {
+
+struct summary_base {
+    /** @brief Metric of each counted replication. */
+    stats::tally metric;
+
+    /** @brief Half-width of the confidence interval of the mean metric. */
+    double half_width = std::numeric_limits<double>::infinity();
+
+    /** @brief Whether the requested half-width was reached. */
+    bool converged = false;
+
+    /** @brief Returns the number of counted replications. */
+    std::size_t replications() const noexcept {
+        return static_cast<std::size_t>(metric.count());
+    }
+
+    /** @brief Returns the mean metric. */
+    double mean() const noexcept {
+        return metric.mean();
+    }
+};
+
+} /* namespace detail */
+
+/**
+ * @brief Outcome of `run_replications()`.
+ *
+ * @tparam Result Result of a replication, merged over the counted
+ *         replications, or `void` if replications return only a metric.
+ */
+template <typename Result = void>
+struct replication_summary: detail::summary_base {
+    /** @brief Results of the counted replications, merged in order of their index. */
+    Result merged;
+};
+
+template <>
+struct replication_summary<void>: detail::summary_base {
+};
+
+namespace detail {
+
+inline bool converged(replication_config const &cfg, summary_base const &s) noexcept {
+    if (s.replications() < std::max<std::size_t>(cfg.min_replications, 2))
+        return false;
+
+    if (cfg.half_width > 0 && s.half_width <= cfg.half_width)
+        return true;
+
+    return cfg.relative_half_width > 0 && s.half_width <= cfg.relative_half_width * std::abs(s.mean());
+}
+
+// replications of one experiment, run on a pool that may be shared with
+// other experiments; calls on_done from the task that finishes the last
+// counted replication, unless a replication threw
+template <typename Result, typename Replicate, typename Metric>
+struct replication_run {
+    static constexpr bool merging = !std::is_arithmetic_v<Result>;
+    using summary_type = std::conditional_t<merging, replication_summary<Result>, replication_summary<void>>;
+
+    replication_run(replication_config const &cfg, Replicate f, Metric metric):
+        cfg_{cfg}, f_{std::move(f)}, metric_{std::move(metric)}, results_(cfg.max_replications) {
+        if (cfg.max_replications == 0 || cfg.min_replications > cfg.max_replications)
+            throw std::runtime_error("replications need 0 < max_replications and min_replications <= max_replications");
+
+        if (!(cfg.confidence > 0 && cfg.confidence < 1))
+            throw std::runtime_error("replications need 0 < confidence < 1");
+    }
+
+    CXXDES_NOT_COPIABLE(replication_run)
+    CXXDES_NOT_MOVABLE(replication_run)
+
+    void on_done(std::function<void()> f) {
+        on_done_ = std::move(f);
+    }
+
+    void start(thread_pool &pool) {
+        // keeps a few replications per worker in flight, so that the count
+        // overshoots the stopping point by little
+        auto window = std::min(cfg_.max_replications, 2 * pool.size());
+
+        std::lock_guard lock{m_};
+        while (issued_ < window)
+            submit_(pool);
+    }
+
+    summary_base const &state() const noexcept {
+        return s_;
+    }
+
+    summary_type summary() && {
+        if constexpr (merging)
+            return summary_type{ std::move(s_), std::move(*merged_) };
+        else
+            return summary_type{ std::move(s_) };
+    }
+
+private:
+    void submit_(thread_pool &pool) {
+        ++running_;
+        pool.submit([this, &pool, index = issued_++] { replicate_(pool, index); });
+    }
+
+    void replicate_(thread_pool &pool, std::size_t index) {
+        std::optional<Result> r;
+
+        try {
+            r.emplace(f_(replication{index, replication_seed(cfg_.seed, index)}));
+        }
+        catch (...) {
+            // the pool reports the exception once the running replications finish
+            std::lock_guard lock{m_};
+            stop_ = true;
+            failed_ = true;
+            --running_;
+            throw ;
+        }
+
+        bool finished = false;
+
+        {
+            std::lock_guard lock{m_};
+            --running_;
+
+            if (!stop_) {
+                results_[index] = std::move(r);
+                count_();
+
+                if (!stop_ && issued_ < cfg_.max_replications)
+                    submit_(pool);
+            }
+
+            finished = stop_ && running_ == 0 && !failed_;
+        }
+
+        if (finished && on_done_)
+            on_done_();
+    }
+
+    // counts the finished replications in order of their index, which makes
+    // the outcome independent of the order they finished in
+    void count_() {
+        while (counted_ < results_.size() && results_[counted_] && !stop_) {
+            auto &x = *results_[counted_];
+            s_.metric.add(static_cast<double>(metric_(x)));
+
+            if constexpr (merging) {
+                if (merged_)
+                    merged_->merge(x);
+                else
+                    merged_.emplace(std::move(x));
+            }
+
+            results_[counted_].reset();
+            ++counted_;
+
+            s_.half_width = stats::half_width(s_.metric, cfg_.confidence);
+            s_.converged = detail::converged(cfg_, s_);
+            stop_ = s_.converged || counted_ == cfg_.max_replications;
+        }
+    }
+
+    replication_config cfg_;
+    Replicate f_;
+    Metric metric_;
+    std::function<void()> on_done_;
+
+    std::mutex m_;
+    std::vector<std::optional<Result>> results_;
+    std::optional<Result> merged_;
+    summary_base s_;
+    std::size_t issued_ = 0;
+    std::size_t counted_ = 0;
+    std::size_t running_ = 0;
+    bool stop_ = false;
+    bool failed_ = false;
+};
+
+template <typename Result, typename Replicate, typename Metric>
+auto run(replication_config const &cfg, Replicate f, Metric metric) {
+    replication_run<Result, Replicate, Metric> r{cfg, std::move(f), std::move(metric)};
+
+    thread_pool pool{cfg.threads};
+    r.start(pool);
+    pool.wait();
+
+    return std::move(r).summary();
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Runs replications of a simulation in parallel until the mean of their metric is known well enough.
+ *
+ * @p f is called with a `replication` on a worker thread; it typically
+ * constructs a simulation seeded with `replication::seed`, runs it, and
+ * returns its metric. Calls run concurrently, so each must use its own
+ * simulation and environment, and share nothing else that they modify.
+ *
+ * Replications are counted in order of their index. After each one, the
+ * confidence interval of the mean metric is updated, and counting stops at
+ * the first replication, from `min_replications` on, at which the interval
+ * is narrow enough, or at `max_replications`. Replications running past that
+ * point are discarded, so for a given seed the outcome does not depend on the
+ * number of threads.
+ *
+ * @throws std::runtime_error If the bounds on the number of replications are inconsistent,
+ *         or the confidence level is not between zero and one.
+ * @throws The first exception thrown by @p f.
+ */
+template <typename Replicate>
+    requires std::is_arithmetic_v<std::invoke_result_t<Replicate &, replication>>
+replication_summary<void> run_replications(replication_config const &cfg, Replicate f) {
+    using result_type = std::invoke_result_t<Replicate &, replication>;
+
+    auto metric = [](result_type const &x) { return x; };
+    return detail::run<result_type>(cfg, std::move(f), metric);
+}
+
+/**
+ * @brief Like `run_replications(cfg, f)`, but @p f returns a result with a metric.
+ *
+ * The results, such as a struct of `stats` accumulators, are merged in order
+ * of their index with `merge()`; they must not refer to the simulation that
+ * produced them. The stopping rule uses `metric(result)`.
+ */
+template <typename Replicate, typename Metric>
+auto run_replications(replication_config const &cfg, Replicate f, Metric metric) {
+    using result_type = std::invoke_result_t<Replicate &, replication>;
+
+    static_assert(
+        requires (result_type &a, result_type const &b) { a.merge(b); },
+        "results of replications must have a merge() member function");
+
+    return detail::run<result_type>(cfg, std::move(f), std::move(metric));
+}
+
+} /* namespace experiment */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_EXPERIMENT_REPLICATIONS_HPP_INCLUDED */
@@ -0,0 +1,241 @@
+/**
+ * @file sweep.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Parameter sweeps that refine where the response changes most.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_EXPERIMENT_SWEEP_HPP_INCLUDED
+#define CXXDES_EXPERIMENT_SWEEP_HPP_INCLUDED
+
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <fmt/core.h>
+#include <cxxdes/experiment/thread_pool.hpp>
+#include <cxxdes/experiment/replications.hpp>
+
+namespace cxxdes {
+namespace experiment {
+
+/** @brief Settings of `sweep()`. */
+struct sweep_config {
+    /** @brief Smallest value of the parameter. */
+    double lower = 0;
+
+    /** @brief Largest value of the parameter. */
+    double upper = 1;
+
+    /** @brief Points of the first round, spread evenly from `lower` to `upper`. */
+    std::size_t initial_points = 9;
+
+    /** @brief Points run at most, over all rounds. */
+    std::size_t max_points = 33;
+
+    /** @brief Points added by each later round, whatever the number of threads. */
+    std::size_t batch = 4;
+
+    /** @brief Intervals whose score is at most this much are not refined. */
+    double tolerance = 0;
+
+    /** @brief Intervals at most this wide are not refined. */
+    double min_spacing = 0;
+
+    /** @brief Replications run at every point; their `threads` sets the threads of the sweep. */
+    replication_config replications;
+};
+
+/** @brief One point of a sweep. */
+struct sweep_point {
+    /** @brief Value of the parameter. */
+    double parameter;
+
+    /** @brief Round that added the point, from zero. */
+    std::size_t round;
+
+    /** @brief Replications run at the point. */
+    replication_summary<> summary;
+};
+
+/**
+ * @brief Writes the points of a sweep as comma-separated columns, one row per point.
+ *
+ * The header is written on construction, and every row is flushed, so that a
+ * sweep that is interrupted keeps the points it completed.
+ */
+struct csv_writer {
+    /** @brief Writes the header to @p os, naming the parameter column @p parameter. */
+    explicit csv_writer(std::ostream &os, std::string const &parameter = "parameter"): os_{&os} {
+        *os_ << fmt::format("{},round,replications,mean,half_width,converged\n", parameter);
+        os_->flush();
+    }
+
+    void operator()(sweep_point const &p) const {
+        *os_ << fmt::format(
+            "{},{},{},{},{},{}\n",
+            p.parameter, p.round, p.summary.replications(), p.summary.mean(), p.summary.half_width, p.summary.converged ? 1 : 0);
+        os_->flush();
+    }
+
+private:
+    std::ostream *os_;
+};
+
+namespace detail {
+
+// scores the interval between neighbouring points by how much the mean
+// changes across it and how wide the intervals of its ends are
+inline double refinement_score(sweep_point const &a, sweep_point const &b) noexcept {
+    auto width = [](sweep_point const &p) {
+        return std::isfinite(p.summary.half_width) ? p.summary.half_width : 0.0;
+    };
+
+    return std::abs(b.summary.mean() - a.summary.mean()) + std::max(width(a), width(b));
+}
+
+// midpoints of the intervals with the highest scores, among those that may be refined
+inline std::vector<double> refine(sweep_config const &cfg, std::vector<sweep_point> const &points, std::size_t n) {
+    struct interval {
+        double score;
+        double midpoint;
+    };
+
+    std::vector<interval> candidates;
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        auto const &a = points[i - 1];
+        auto const &b = points[i];
+        auto midpoint = (a.parameter + b.parameter) / 2;
+        auto score = refinement_score(a, b);
+
+        if (b.parameter - a.parameter <= cfg.min_spacing || midpoint <= a.parameter || midpoint >= b.parameter)
+            continue;
+
+        if (score <= cfg.tolerance)
+            continue;
+
+        candidates.push_back(interval{score, midpoint});
+    }
+
+    // ties go to the lower parameter, so that the rounds do not depend on the order points finished in
+    std::stable_sort(candidates.begin(), candidates.end(), [](interval const &a, interval const &b) {
+        return a.score > b.score;
+    });
+
+    std::vector<double> result;
+    for (std::size_t i = 0; i < std::min(n, candidates.size()); ++i)
+        result.push_back(candidates[i].midpoint);
+
+    return result;
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Runs replications of a simulation over a range of a parameter, adding points where the response changes most.
+ *
+ * @p f is called with a parameter value and a `replication`, on a worker
+ * thread, and returns the metric of one replication, as with
+ * `run_replications()`. The first round runs `initial_points` points spread
+ * evenly over the range. Every later round scores the intervals between
+ * neighbouring points by the change of the mean metric across them plus the
+ * larger half-width at their ends, and runs the midpoints of the `batch`
+ * intervals with the highest scores, until `max_points` points have run or no
+ * interval scores above `tolerance`.
+ *
+ * The replications of all points of a round share one pool of threads, so a
+ * round takes about as long as its slowest point. Every point uses the same
+ * replication seeds; these common random numbers make neighbouring points
+ * differ mostly because of the parameter. Rounds are decided only from the
+ * completed rounds, so the points do not depend on the number of threads.
+ *
+ * @p on_point is called with every point as it completes, one call at a time;
+ * pass a `csv_writer` to stream the points to a file.
+ *
+ * @returns The points, in order of their parameter.
+ *
+ * @throws std::runtime_error If the range or the number of points is inconsistent, or `batch` is zero.
+ * @throws The first exception thrown by @p f or @p on_point.
+ */
+template <typename Replicate, typename OnPoint>
+    requires std::is_arithmetic_v<std::invoke_result_t<Replicate &, double, replication>>
+std::vector<sweep_point> sweep(sweep_config const &cfg, Replicate f, OnPoint on_point) {
+    using result_type = std::invoke_result_t<Replicate &, double, replication>;
+
+    if (!(cfg.lower < cfg.upper))
+        throw std::runtime_error("sweep needs lower < upper");
+
+    if (cfg.initial_points < 2 || cfg.initial_points > cfg.max_points)
+        throw std::runtime_error("sweep needs 2 <= initial_points <= max_points");
+
+    if (cfg.batch == 0)
+        throw std::runtime_error("sweep needs a positive batch");
+
+    auto bind = [&f](double x) {
+        return [&f, x](replication r) { return f(x, r); };
+    };
+
+    auto metric = [](result_type const &x) { return x; };
+
+    using run_type = detail::replication_run<result_type, decltype(bind(0.0)), decltype(metric)>;
+
+    thread_pool pool{cfg.replications.threads};
+
+    std::vector<sweep_point> points;
+    std::vector<double> next;
+
+    for (std::size_t i = 0; i < cfg.initial_points; ++i)
+        next.push_back(cfg.lower + (cfg.upper - cfg.lower) * static_cast<double>(i) / static_cast<double>(cfg.initial_points - 1));
+
+    for (std::size_t round = 0; !next.empty(); ++round) {
+        std::mutex m;
+        std::vector<std::unique_ptr<run_type>> runs;
+
+        for (auto x: next) {
+            runs.push_back(std::make_unique<run_type>(cfg.replications, bind(x), metric));
+
+            auto *r = runs.back().get();
+            r->on_done([&, r, x, round] {
+                sweep_point p{x, round, replication_summary<>{ r->state() }};
+
+                std::lock_guard lock{m};
+                on_point(std::as_const(p));
+                points.push_back(std::move(p));
+            });
+        }
+
+        for (auto &r: runs)
+            r->start(pool);
+
+        pool.wait();
+
+        std::sort(points.begin(), points.end(), [](sweep_point const &a, sweep_point const &b) {
+            return a.parameter < b.parameter;
+        });
+
+        next = detail::refine(cfg, points, std::min(cfg.batch, cfg.max_points - points.size()));
+    }
+
+    return points;
+}
+
+/** @brief Like `sweep(cfg, f, on_point)`, without a callback. */
+template <typename Replicate>
+std::vector<sweep_point> sweep(sweep_config const &cfg, Replicate f) {
+    return sweep(cfg, std::move(f), [](sweep_point const &) {  });
+}
+
+} /* namespace experiment */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_EXPERIMENT_SWEEP_HPP_INCLUDED */
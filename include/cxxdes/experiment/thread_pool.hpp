@@ -0,0 +1,241 @@
+/**
+ * @file thread_pool.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Work-stealing thread pool for running simulations in parallel.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_EXPERIMENT_THREAD_POOL_HPP_INCLUDED
+#define CXXDES_EXPERIMENT_THREAD_POOL_HPP_INCLUDED
+
+#include <mutex>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <semaphore>
+#include <functional>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace experiment {
+
+/**
+ * @brief Fixed set of threads running submitted tasks.
+ *
+ * Every thread has its own deque of tasks. A task submitted from a worker
+ * goes to the back of that worker's deque, and the worker runs its newest
+ * task first; an idle worker steals the oldest task of another worker. Tasks
+ * submitted from other threads are spread over the workers in turn.
+ *
+ * Simulations share no state between environments, so each task may run a
+ * simulation of its own; a simulation must not be touched by two tasks.
+ */
+struct thread_pool {
+    /**
+     * @brief Starts @p threads workers.
+     *
+     * Zero starts one worker per hardware thread.
+     */
+    explicit thread_pool(std::size_t threads = 0) {
+        if (threads == 0)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        for (std::size_t i = 0; i < threads; ++i)
+            workers_.push_back(std::make_unique<worker>());
+
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            threads_.emplace_back([this, i] { loop_(i); });
+    }
+
+    CXXDES_NOT_COPIABLE(thread_pool)
+    CXXDES_NOT_MOVABLE(thread_pool)
+
+    /** @brief Returns the number of workers. */
+    std::size_t size() const noexcept {
+        return workers_.size();
+    }
+
+    /** @brief Queues @p task; it may be called from tasks. */
+    void submit(std::function<void()> task) {
+        auto i = current_pool() == this ? current_index() : next_.fetch_add(1, std::memory_order_relaxed) % size();
+
+        pending_.fetch_add(1);
+
+        {
+            std::lock_guard lock{workers_[i]->m};
+            workers_[i]->tasks.push_back(std::move(task));
+        }
+
+        // one permit per queued task, released once the task can be found
+        queued_.release();
+    }
+
+    /**
+     * @brief Blocks until every submitted task, including those submitted by tasks, has finished.
+     *
+     * Must not be called from a task.
+     *
+     * @throws The first exception thrown by a task since the last `wait()`.
+     */
+    void wait() {
+        for (auto p = pending_.load(); p != 0; p = pending_.load())
+            pending_.wait(p);
+
+        std::lock_guard lock{m_};
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    /**
+     * @brief Runs `f(i)` for every `i` below @p n as tasks and returns once they have finished.
+     *
+     * Unlike `wait()`, it waits only for its own tasks. Must not be called from
+     * a task.
+     *
+     * @throws The first exception thrown by `f`, once all calls have finished.
+     */
+    void parallel_for(std::size_t n, std::function<void(std::size_t)> const &f) {
+        // shared with the tasks, which may still hold it when the caller returns
+        struct state {
+            std::atomic<std::size_t> left;
+            std::mutex m;
+            std::exception_ptr error;
+        };
+
+        auto s = std::make_shared<state>();
+        s->left = n;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            submit([s, &f, i] {
+                try {
+                    f(i);
+                }
+                catch (...) {
+                    std::lock_guard lock{s->m};
+                    if (!s->error)
+                        s->error = std::current_exception();
+                }
+
+                if (s->left.fetch_sub(1) == 1)
+                    s->left.notify_all();
+            });
+        }
+
+        for (auto l = s->left.load(); l != 0; l = s->left.load())
+            s->left.wait(l);
+
+        std::lock_guard lock{s->m};
+        if (s->error)
+            std::rethrow_exception(s->error);
+    }
+
+    /** @brief Finishes the queued tasks and stops the workers. */
+    ~thread_pool() {
+        stop_ = true;
+        queued_.release(static_cast<std::ptrdiff_t>(size()));
+
+        for (auto &t: threads_)
+            t.join();
+    }
+
+private:
+    struct worker {
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static thread_pool *&current_pool() noexcept {
+        static thread_local thread_pool *pool = nullptr;
+        return pool;
+    }
+
+    static std::size_t &current_index() noexcept {
+        static thread_local std::size_t index = 0;
+        return index;
+    }
+
+    // newest task of worker i, else the oldest task of another worker
+    bool take_(std::size_t i, std::function<void()> &task) {
+        {
+            auto &w = *workers_[i];
+            std::lock_guard lock{w.m};
+            if (!w.tasks.empty()) {
+                task = std::move(w.tasks.back());
+                w.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (std::size_t k = 1; k < size(); ++k) {
+            auto &w = *workers_[(i + k) % size()];
+            std::lock_guard lock{w.m};
+            if (!w.tasks.empty()) {
+                task = std::move(w.tasks.front());
+                w.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void loop_(std::size_t i) {
+        current_pool() = this;
+        current_index() = i;
+
+        std::function<void()> task;
+
+        while (true) {
+            queued_.acquire();
+
+            // a permit promises a task, which a scan may miss while other
+            // workers take theirs; only the permits of the destructor do not
+            while (!take_(i, task)) {
+                if (stop_ && pending_.load() == 0)
+                    return ;
+
+                std::this_thread::yield();
+            }
+
+            try {
+                task();
+            }
+            catch (...) {
+                std::lock_guard lock{m_};
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+
+            task = nullptr;
+
+            if (pending_.fetch_sub(1) == 1)
+                pending_.notify_all();
+        }
+    }
+
+    std::vector<std::unique_ptr<worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_ = 0;
+    std::atomic<std::size_t> pending_ = 0;
+    std::counting_semaphore<std::numeric_limits<int>::max()> queued_{0};
+    std::atomic<bool> stop_ = false;
+
+    // guards error_
+    std::mutex m_;
+    std::exception_ptr error_;
+};
+
+} /* namespace experiment */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_EXPERIMENT_THREAD_POOL_HPP_INCLUDED */
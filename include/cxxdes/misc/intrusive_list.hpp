@@ -0,0 +1,260 @@
+/**
+ * @file intrusive_list.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Intrusive doubly-linked list.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_MISC_INTRUSIVE_LIST_HPP_INCLUDED
+#define CXXDES_MISC_INTRUSIVE_LIST_HPP_INCLUDED
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+namespace cxxdes {
+namespace util {
+
+template <typename T>
+struct intrusive_list;
+
+/**
+ * @brief Base class for objects that can be linked into an `intrusive_list`.
+ *
+ * A node can be linked into at most one list at a time. Copying or moving a
+ * node produces an unlinked node, and a linked node unlinks itself when it is
+ * destroyed.
+ *
+ * @tparam T CRTP parameter.
+ */
+template <typename T>
+struct intrusive_list_node {
+    intrusive_list_node() noexcept = default;
+
+    intrusive_list_node(intrusive_list_node const &) noexcept {
+    }
+
+    intrusive_list_node &operator=(intrusive_list_node const &) noexcept {
+        return *this;
+    }
+
+    /** @brief Returns whether this node is currently linked into a list. */
+    [[nodiscard]]
+    bool linked() const noexcept {
+        return list_ != nullptr;
+    }
+
+    /** @brief Removes this node from its list, if any, in constant time. */
+    void unlink() noexcept {
+        if (list_)
+            list_->erase(static_cast<T *>(this));
+    }
+
+    ~intrusive_list_node() {
+        unlink();
+    }
+
+private:
+    friend struct intrusive_list<T>;
+
+    T *prev_ = nullptr;
+    T *next_ = nullptr;
+    intrusive_list<T> *list_ = nullptr;
+};
+
+/**
+ * @brief Non-owning doubly-linked list of `intrusive_list_node<T>` objects.
+ *
+ * Insertion and removal are constant time and never allocate. The list does
+ * not own its elements; destroying or clearing the list only unlinks them.
+ * A list must not be moved while it has elements.
+ *
+ * @tparam T Element type deriving from `intrusive_list_node<T>`.
+ */
+template <typename T>
+struct intrusive_list {
+    using node_type = intrusive_list_node<T>;
+
+    struct iterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        T &operator*() const noexcept { return *x; }
+        T *operator->() const noexcept { return x; }
+
+        iterator &operator++() noexcept {
+            x = static_cast<node_type *>(x)->next_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        bool operator==(iterator const &other) const noexcept = default;
+
+        T *x = nullptr;
+    };
+
+    intrusive_list() noexcept = default;
+
+    intrusive_list(intrusive_list const &) = delete;
+    intrusive_list &operator=(intrusive_list const &) = delete;
+
+    /** @brief Returns whether the list has no elements. */
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return head_ == nullptr;
+    }
+
+    /** @brief Returns the number of linked elements. */
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /** @brief Returns the first element; the list must not be empty. */
+    T *front() const noexcept {
+        return head_;
+    }
+
+    /** @brief Returns the last element; the list must not be empty. */
+    T *back() const noexcept {
+        return tail_;
+    }
+
+    /** @brief Returns the element before @p x, or null if @p x is the first one. */
+    static T *prev(T *x) noexcept {
+        return node(x).prev_;
+    }
+
+    /** @brief Returns the element after @p x, or null if @p x is the last one. */
+    static T *next(T *x) noexcept {
+        return node(x).next_;
+    }
+
+    /** @brief Links @p x at the back; @p x must not be linked. */
+    void push_back(T *x) noexcept {
+        auto &n = node(x);
+        assert(!n.linked() && "node is already linked.");
+
+        n.list_ = this;
+        n.prev_ = tail_;
+        n.next_ = nullptr;
+
+        if (tail_)
+            node(tail_).next_ = x;
+        else
+            head_ = x;
+
+        tail_ = x;
+        ++size_;
+    }
+
+    /** @brief Links @p x at the front; @p x must not be linked. */
+    void push_front(T *x) noexcept {
+        auto &n = node(x);
+        assert(!n.linked() && "node is already linked.");
+
+        n.list_ = this;
+        n.prev_ = nullptr;
+        n.next_ = head_;
+
+        if (head_)
+            node(head_).prev_ = x;
+        else
+            tail_ = x;
+
+        head_ = x;
+        ++size_;
+    }
+
+    /** @brief Links @p x right before @p pos, or at the back if @p pos is null. */
+    void insert_before(T *pos, T *x) noexcept {
+        if (!pos || pos == head_) {
+            if (!pos) push_back(x);
+            else push_front(x);
+            return ;
+        }
+
+        auto &n = node(x);
+        assert(!n.linked() && "node is already linked.");
+
+        auto prev = node(pos).prev_;
+
+        n.list_ = this;
+        n.prev_ = prev;
+        n.next_ = pos;
+
+        node(prev).next_ = x;
+        node(pos).prev_ = x;
+        ++size_;
+    }
+
+    /** @brief Unlinks and returns the first element; the list must not be empty. */
+    T *pop_front() noexcept {
+        auto x = head_;
+        erase(x);
+        return x;
+    }
+
+    /** @brief Unlinks @p x, which must be linked into this list. */
+    void erase(T *x) noexcept {
+        auto &n = node(x);
+        assert(n.list_ == this && "node is not linked into this list.");
+
+        if (n.prev_)
+            node(n.prev_).next_ = n.next_;
+        else
+            head_ = n.next_;
+
+        if (n.next_)
+            node(n.next_).prev_ = n.prev_;
+        else
+            tail_ = n.prev_;
+
+        n.prev_ = n.next_ = nullptr;
+        n.list_ = nullptr;
+        --size_;
+    }
+
+    /** @brief Unlinks all elements. */
+    void clear() noexcept {
+        while (!empty())
+            pop_front();
+    }
+
+    iterator begin() const noexcept {
+        return { head_ };
+    }
+
+    iterator end() const noexcept {
+        return { nullptr };
+    }
+
+    ~intrusive_list() {
+        clear();
+    }
+
+private:
+    static node_type &node(T *x) noexcept {
+        return *static_cast<node_type *>(x);
+    }
+
+    T *head_ = nullptr;
+    T *tail_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} /* namespace util */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_MISC_INTRUSIVE_LIST_HPP_INCLUDED */
@@ -0,0 +1,94 @@
+/**
+ * @file mpsc_queue.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Unbounded lock-free multi-producer single-consumer queue.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_MISC_MPSC_QUEUE_HPP_INCLUDED
+#define CXXDES_MISC_MPSC_QUEUE_HPP_INCLUDED
+
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace util {
+
+/**
+ * @brief FIFO queue from any number of producer threads to one consumer thread.
+ *
+ * Like `spsc_queue`, a linked list that starts with a sentinel node, except
+ * that producers claim the tail with one atomic exchange and then link the
+ * previous tail to their node (Vyukov). `push()` never blocks and never
+ * retries. Until a producer has linked its node, the consumer does not see it
+ * or the nodes pushed after it.
+ *
+ * `push()` may be called by any thread, and `pop()` and `empty()` by one
+ * thread at a time.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+struct mpsc_queue {
+    mpsc_queue(): head_{new node}, tail_{head_} {
+    }
+
+    CXXDES_NOT_COPIABLE(mpsc_queue)
+    CXXDES_NOT_MOVABLE(mpsc_queue)
+
+    /** @brief Appends @p value; called by any producer. */
+    void push(T value) {
+        auto n = new node;
+        n->value.emplace(std::move(value));
+
+        auto prev = tail_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    /** @brief Removes and returns the front element, if any; called by the consumer. */
+    std::optional<T> pop() {
+        auto n = head_->next.load(std::memory_order_acquire);
+        if (!n)
+            return std::nullopt;
+
+        // n becomes the sentinel
+        std::optional<T> result{std::move(n->value)};
+        n->value.reset();
+        delete head_;
+        head_ = n;
+        return result;
+    }
+
+    /** @brief Returns whether no element is available; called by the consumer. */
+    bool empty() const noexcept {
+        return head_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    ~mpsc_queue() {
+        while (head_) {
+            auto n = head_->next.load(std::memory_order_relaxed);
+            delete head_;
+            head_ = n;
+        }
+    }
+
+private:
+    struct node {
+        std::atomic<node *> next = nullptr;
+        std::optional<T> value;
+    };
+
+    // owned by the consumer and shared by the producers, on separate cache lines
+    alignas(64) node *head_;
+    alignas(64) std::atomic<node *> tail_;
+};
+
+} /* namespace util */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_MISC_MPSC_QUEUE_HPP_INCLUDED */
@@ -0,0 +1,228 @@
+/**
+ * @file ring_buffer.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Contiguous FIFO ring buffer.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_MISC_RING_BUFFER_HPP_INCLUDED
+#define CXXDES_MISC_RING_BUFFER_HPP_INCLUDED
+
+#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace cxxdes {
+namespace util {
+
+/**
+ * @brief FIFO buffer over a single contiguous allocation.
+ *
+ * Elements are appended at the back and removed from the front without
+ * moving the others. The buffer grows geometrically when an element is added
+ * to a full buffer; a buffer reserved up front never allocates again until it
+ * exceeds its capacity.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+struct ring_buffer {
+    ring_buffer() noexcept = default;
+
+    /** @brief Constructs an empty buffer with room for @p capacity elements. */
+    explicit ring_buffer(std::size_t capacity) {
+        reserve(capacity);
+    }
+
+    ring_buffer(ring_buffer const &) = delete;
+    ring_buffer &operator=(ring_buffer const &) = delete;
+
+    ring_buffer(ring_buffer &&other) noexcept {
+        swap(other);
+    }
+
+    ring_buffer &operator=(ring_buffer &&other) noexcept {
+        ring_buffer tmp{std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    /** @brief Returns the number of stored elements. */
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /** @brief Returns the number of elements that fit without reallocation. */
+    [[nodiscard]]
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    /** @brief Returns whether the buffer has no elements. */
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /** @brief Returns the @p i th element from the front. */
+    T &operator[](std::size_t i) noexcept {
+        assert(i < size_);
+        return data_[wrap_(head_ + i)];
+    }
+
+    /** @copydoc operator[] */
+    T const &operator[](std::size_t i) const noexcept {
+        assert(i < size_);
+        return data_[wrap_(head_ + i)];
+    }
+
+    /** @brief Returns the first element; the buffer must not be empty. */
+    T &front() noexcept { return (*this)[0]; }
+    T const &front() const noexcept { return (*this)[0]; }
+
+    /** @brief Returns the last element; the buffer must not be empty. */
+    T &back() noexcept { return (*this)[size_ - 1]; }
+    T const &back() const noexcept { return (*this)[size_ - 1]; }
+
+    /**
+     * @brief Constructs an element at the back, growing the buffer if it is full.
+     *
+     * @p args may refer to elements of the buffer itself. If the construction,
+     * or moving the elements into a grown buffer, throws, the buffer is left
+     * unchanged.
+     */
+    template <typename ...Args>
+    T &emplace_back(Args && ...args) {
+        if (size_ < capacity_) {
+            auto p = std::construct_at(data_ + wrap_(head_ + size_), std::forward<Args>(args)...);
+            ++size_;
+            return *p;
+        }
+
+        // the new element is built before the old ones move, as args may refer to them
+        auto capacity = capacity_ ? 2 * capacity_ : 8;
+        auto data = alloc_.allocate(capacity);
+        T *p = nullptr;
+
+        try {
+            p = std::construct_at(data + size_, std::forward<Args>(args)...);
+            relocate_(data);
+        }
+        catch (...) {
+            if (p)
+                std::destroy_at(p);
+            alloc_.deallocate(data, capacity);
+            throw;
+        }
+
+        adopt_(data, capacity);
+        ++size_;
+        return *p;
+    }
+
+    /** @brief Appends a copy of @p x at the back. */
+    void push_back(T const &x) {
+        emplace_back(x);
+    }
+
+    /** @brief Appends @p x at the back. */
+    void push_back(T &&x) {
+        emplace_back(std::move(x));
+    }
+
+    /** @brief Destroys the first element; the buffer must not be empty. */
+    void pop_front() noexcept {
+        assert(size_ > 0);
+        std::destroy_at(data_ + head_);
+        head_ = wrap_(head_ + 1);
+        --size_;
+    }
+
+    /** @brief Grows the capacity to at least @p capacity elements. */
+    void reserve(std::size_t capacity) {
+        if (capacity <= capacity_)
+            return ;
+
+        auto data = alloc_.allocate(capacity);
+
+        try {
+            relocate_(data);
+        }
+        catch (...) {
+            alloc_.deallocate(data, capacity);
+            throw;
+        }
+
+        adopt_(data, capacity);
+    }
+
+    /** @brief Destroys all elements and keeps the capacity. */
+    void clear() noexcept {
+        while (!empty())
+            pop_front();
+        head_ = 0;
+    }
+
+    void swap(ring_buffer &other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    ~ring_buffer() {
+        clear();
+        if (data_)
+            alloc_.deallocate(data_, capacity_);
+    }
+
+private:
+    // moves or, if moving may throw, copies the elements to the front of data;
+    // on an exception, the copies made so far are destroyed and the buffer is intact
+    void relocate_(T *data) {
+        std::size_t i = 0;
+
+        try {
+            for (; i < size_; ++i)
+                std::construct_at(data + i, std::move_if_noexcept((*this)[i]));
+        }
+        catch (...) {
+            std::destroy(data, data + i);
+            throw;
+        }
+    }
+
+    // destroys the elements and frees the old allocation, once relocate_(data) is done
+    void adopt_(T *data, std::size_t capacity) noexcept {
+        for (std::size_t i = 0; i < size_; ++i)
+            std::destroy_at(&(*this)[i]);
+
+        if (data_)
+            alloc_.deallocate(data_, capacity_);
+
+        data_ = data;
+        capacity_ = capacity;
+        head_ = 0;
+    }
+
+    std::size_t wrap_(std::size_t i) const noexcept {
+        return i >= capacity_ ? i - capacity_ : i;
+    }
+
+    [[no_unique_address]] std::allocator<T> alloc_;
+
+    T *data_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+
+} /* namespace util */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_MISC_RING_BUFFER_HPP_INCLUDED */
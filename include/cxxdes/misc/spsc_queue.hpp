@@ -0,0 +1,92 @@
+/**
+ * @file spsc_queue.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Unbounded lock-free single-producer single-consumer queue.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_MISC_SPSC_QUEUE_HPP_INCLUDED
+#define CXXDES_MISC_SPSC_QUEUE_HPP_INCLUDED
+
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace util {
+
+/**
+ * @brief FIFO queue between one producer thread and one consumer thread.
+ *
+ * The queue is a linked list that starts with a sentinel node: the producer
+ * links new nodes after the tail, and the consumer advances the head, so the
+ * two sides never write the same memory and need no lock. `push()` never
+ * blocks, which lets a producer run ahead of a consumer that is busy.
+ *
+ * `push()` must be called by one thread at a time, and `pop()` and `empty()`
+ * by one other thread at a time.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+struct spsc_queue {
+    spsc_queue(): head_{new node}, tail_{head_} {
+    }
+
+    CXXDES_NOT_COPIABLE(spsc_queue)
+    CXXDES_NOT_MOVABLE(spsc_queue)
+
+    /** @brief Appends @p value; called by the producer. */
+    void push(T value) {
+        auto n = new node;
+        n->value.emplace(std::move(value));
+        tail_->next.store(n, std::memory_order_release);
+        tail_ = n;
+    }
+
+    /** @brief Removes and returns the front element, if any; called by the consumer. */
+    std::optional<T> pop() {
+        auto n = head_->next.load(std::memory_order_acquire);
+        if (!n)
+            return std::nullopt;
+
+        // n becomes the sentinel
+        std::optional<T> result{std::move(n->value)};
+        n->value.reset();
+        delete head_;
+        head_ = n;
+        return result;
+    }
+
+    /** @brief Returns whether no element is available; called by the consumer. */
+    bool empty() const noexcept {
+        return head_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    ~spsc_queue() {
+        while (head_) {
+            auto n = head_->next.load(std::memory_order_relaxed);
+            delete head_;
+            head_ = n;
+        }
+    }
+
+private:
+    struct node {
+        std::atomic<node *> next = nullptr;
+        std::optional<T> value;
+    };
+
+    // owned by the consumer and the producer, on separate cache lines
+    alignas(64) node *head_;
+    alignas(64) node *tail_;
+};
+
+} /* namespace util */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_MISC_SPSC_QUEUE_HPP_INCLUDED */
@@ -0,0 +1,747 @@
+/**
+ * @file network.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Virtual-channel routers connected by credit-based links.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_NET_NETWORK_HPP_INCLUDED
+#define CXXDES_NET_NETWORK_HPP_INCLUDED
+
+#include <deque>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/misc/ring_buffer.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+#include <cxxdes/net/packet.hpp>
+
+namespace cxxdes {
+namespace net {
+
+/** @brief How a router picks among flits competing for the same resource. */
+enum class allocation_policy {
+    /** @brief Rotates priority among input virtual channels. */
+    round_robin,
+
+    /** @brief Prefers the packet that was sent first. */
+    oldest_first
+};
+
+/** @brief Parameters shared by the routers and links of a `network`. */
+struct network_config {
+    /** @brief Virtual channels per port. */
+    std::size_t vcs = 2;
+
+    /** @brief Flits per virtual channel buffer. */
+    std::size_t buffer_depth = 4;
+
+    /** @brief Router cycle time. */
+    cxxdes::core::time_integral cycle = 1;
+
+    /** @brief Time a flit takes from leaving a router to arriving at the next one. */
+    cxxdes::core::time_integral link_latency = 1;
+
+    /** @brief Time a credit takes to return upstream. */
+    cxxdes::core::time_integral credit_latency = 1;
+
+    /** @brief Virtual channel and switch allocation policy. */
+    allocation_policy allocation = allocation_policy::round_robin;
+};
+
+/** @brief Output port and permitted output virtual channels `[vc_begin, vc_end)` of a hop. */
+struct route_result {
+    std::size_t port = 0;
+    std::size_t vc_begin = 0;
+    std::size_t vc_end = 0;
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+using sync::detail::waiter;
+using sync::detail::waiter_list;
+using sync::detail::wake_batch;
+using sync::detail::select_core;
+
+/**
+ * @brief Network of input-queued virtual-channel routers with credit-based flow control.
+ *
+ * Every router has one terminal attached to its port 0, which sends packets
+ * with `send()` and takes delivered packets with `receive()`. The other ports
+ * are connected by unidirectional links. A topology derives from `network`,
+ * adds routers and links, and implements `route()`.
+ *
+ * Packets are split into flits, which carry a pointer to their packet
+ * descriptor. Each cycle, a router
+ *
+ * - accepts the flits and credits that arrived over its links,
+ * - injects one flit from its terminal,
+ * - routes waiting head flits and allocates them a free output virtual
+ *   channel among those `route()` permits, and
+ * - lets each output port send one flit whose output virtual channel has a
+ *   credit, at most one per input port.
+ *
+ * A flit takes `link_latency` to reach the next router and its credit takes
+ * `credit_latency` to come back. An output virtual channel stays with a
+ * packet until its tail flit passes, so packets do not interleave.
+ *
+ * Routers are simulated without processes: a router is stepped by a single
+ * event per cycle, and only while it moves flits or has flits or credits
+ * arriving, so idle parts of a large network cost nothing.
+ */
+struct network {
+private:
+    struct router_state;
+    struct receive_awaitable;
+    struct send_awaitable;
+
+public:
+    /** @brief Port of every router that connects its terminal. */
+    static constexpr std::size_t local_port = 0;
+
+    /**
+     * @brief Constructs a network without routers.
+     *
+     * @throws std::runtime_error If the configuration is invalid.
+     */
+    explicit network(network_config const &config): config_{config} {
+        if (config_.vcs == 0 || config_.buffer_depth == 0)
+            throw std::runtime_error("network needs at least one virtual channel and one buffer slot");
+
+        if (config_.cycle <= 0 || config_.link_latency <= 0 || config_.credit_latency <= 0)
+            throw std::runtime_error("network cycle and latencies must be positive");
+    }
+
+    CXXDES_NOT_COPIABLE(network)
+    CXXDES_NOT_MOVABLE(network)
+
+    /** @brief Returns a packet descriptor from the pool of the network. */
+    [[nodiscard]]
+    packet *make_packet(node_id src, node_id dst, std::uint32_t flits = 1) {
+        check_(src);
+        check_(dst);
+        return pool_.acquire(src, dst, flits);
+    }
+
+    /** @brief Gives a delivered packet descriptor back to the pool. */
+    void release(packet *p) {
+        pool_.release(p);
+    }
+
+    /**
+     * @brief Queues @p p for injection at its source terminal.
+     *
+     * Completes immediately; terminals have unbounded injection queues.
+     */
+    [[nodiscard("expected usage: co_await network.send(p)")]]
+    auto send(packet *p) {
+        check_(p->src);
+        check_(p->dst);
+        return send_awaitable{this, p};
+    }
+
+    /**
+     * @brief Waits for the next packet delivered to terminal @p node.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     */
+    [[nodiscard("expected usage: co_await network.receive(node)")]]
+    auto receive(node_id node, priority_type priority = priority_consts::inherit) {
+        check_(node);
+        return receive_awaitable{this, node, priority};
+    }
+
+    /**
+     * @brief Like `receive()`, but gives up after @p d.
+     *
+     * @return A `timed_result<packet *>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await network.receive_for(d, node)")]]
+    auto receive_for(D &&d, node_id node, priority_type priority = priority_consts::inherit) {
+        return timed(receive(node, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `receive()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await network.receive_until(t, node)")]]
+    auto receive_until(T &&t, node_id node, priority_type priority = priority_consts::inherit) {
+        return timed(receive(node, priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the number of routers. */
+    std::size_t routers() const noexcept {
+        return routers_.size();
+    }
+
+    /** @brief Returns the configuration. */
+    network_config const &config() const noexcept {
+        return config_;
+    }
+
+    /** @brief Returns the packet pool. */
+    packet_pool &pool() noexcept {
+        return pool_;
+    }
+
+    /** @brief Returns the number of packets sent so far. */
+    std::uint64_t sent() const noexcept {
+        return sent_;
+    }
+
+    /** @brief Returns the number of packets delivered so far. */
+    std::uint64_t delivered() const noexcept {
+        return delivered_;
+    }
+
+    /** @brief Returns the number of packets sent but not delivered yet. */
+    std::uint64_t in_flight() const noexcept {
+        return sent_ - delivered_;
+    }
+
+    /** @brief Returns the number of flits that crossed a router-to-router link. */
+    std::uint64_t link_traversals() const noexcept {
+        return link_traversals_;
+    }
+
+    /** @brief Returns the number of router steps simulated. */
+    std::uint64_t steps() const noexcept {
+        return steps_;
+    }
+
+    virtual ~network() {
+        for (auto &r: routers_) {
+            discard_all(r.receivers);
+            r.stepper->r = nullptr;
+        }
+    }
+
+protected:
+    /**
+     * @brief Returns the next hop of @p p at router @p at.
+     *
+     * Only called for packets that have not reached their destination router.
+     */
+    virtual route_result route(node_id at, packet const &p) const = 0;
+
+    /** @brief Adds a router with @p ports ports, including the local port, and returns its identifier. */
+    node_id add_router(std::size_t ports) {
+        if (ports == 0)
+            throw std::runtime_error("router needs at least its local port");
+
+        auto &r = routers_.emplace_back();
+        r.id = routers_.size() - 1;
+        r.stepper = new step_handler{this, &r};
+
+        r.in.resize(ports);
+        r.out.resize(ports);
+
+        for (auto &in: r.in) {
+            for (std::size_t v = 0; v < config_.vcs; ++v)
+                in.vcs.emplace_back(config_.buffer_depth);
+        }
+
+        for (auto &out: r.out)
+            out.owner.assign(config_.vcs, nullptr);
+
+        return r.id;
+    }
+
+    /** @brief Adds a link from port @p from_port of @p from to port @p to_port of @p to. */
+    void connect(node_id from, std::size_t from_port, node_id to, std::size_t to_port) {
+        check_(from);
+        check_(to);
+
+        auto &src = routers_[from];
+        auto &dst = routers_[to];
+
+        if (from_port == local_port || to_port == local_port ||
+            from_port >= src.out.size() || to_port >= dst.in.size())
+            throw std::runtime_error("network link ports are out of range");
+
+        auto &out = src.out[from_port];
+        auto &in = dst.in[to_port];
+
+        if (out.downstream || in.upstream)
+            throw std::runtime_error("network port is already connected");
+
+        out.downstream = &dst;
+        out.downstream_port = to_port;
+        out.credits.assign(config_.vcs, config_.buffer_depth);
+
+        in.upstream = &src;
+        in.upstream_port = from_port;
+    }
+
+private:
+    static constexpr time_integral never = std::numeric_limits<time_integral>::max();
+
+    struct input_vc {
+        util::ring_buffer<flit> buffer;
+        bool active = false;
+        std::size_t out_port = 0;
+        std::size_t out_vc = 0;
+
+        input_vc(std::size_t depth): buffer{depth} {
+        }
+    };
+
+    struct arrival {
+        time_integral time;
+        std::size_t vc;
+        flit f;
+    };
+
+    struct credit {
+        time_integral time;
+        std::size_t vc;
+    };
+
+    struct in_port {
+        std::vector<input_vc> vcs;
+        router_state *upstream = nullptr;
+        std::size_t upstream_port = 0;
+        util::ring_buffer<arrival> arrivals;
+    };
+
+    struct out_port {
+        router_state *downstream = nullptr;
+        std::size_t downstream_port = 0;
+
+        // empty for the local port, which always accepts flits
+        std::vector<std::size_t> credits;
+        std::vector<input_vc *> owner;
+        util::ring_buffer<credit> credits_back;
+
+        // index of the input virtual channel that won last
+        std::size_t last = 0;
+    };
+
+    struct step_handler: token_handler {
+        network *net;
+        router_state *r;
+
+        step_handler(network *net_, router_state *r_): net{net_}, r{r_} {
+        }
+
+        void invoke(token *) override {
+            if (r)
+                net->step_(*r);
+        }
+    };
+
+    struct router_state {
+        node_id id = 0;
+        std::vector<in_port> in;
+        std::vector<out_port> out;
+
+        // terminal
+        std::deque<packet *> injection;
+        std::uint32_t injected = 0;
+        std::size_t inject_vc = 0;
+        std::deque<packet *> delivered;
+        waiter_list receivers;
+
+        std::size_t buffered = 0;
+        std::size_t last_vc_alloc = 0;
+
+        memory::ptr<step_handler> stepper;
+        bool pending = false;
+        time_integral next = 0;
+        bool stepped = false;
+        time_integral last_step = 0;
+    };
+
+    struct send_awaitable {
+        network *net;
+        packet *p;
+
+        send_awaitable(network *net_, packet *p_): net{net_}, p{p_} {
+        }
+
+        void await_bind(environment *env, priority_type) noexcept {
+            net->env_ = env;
+        }
+
+        bool await_ready() {
+            net->inject_(p);
+            return true;
+        }
+
+        void await_suspend(coroutine_data_ptr) const noexcept {  }
+
+        token *await_token() const noexcept {
+            return nullptr;
+        }
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+    };
+
+    struct receive_awaitable: waiter {
+        network *net;
+        node_id node;
+        priority_type priority;
+        packet *value = nullptr;
+
+        receive_awaitable(network *net_, node_id node_, priority_type priority_):
+            net{net_}, node{node_}, priority{priority_} {
+        }
+
+        receive_awaitable(receive_awaitable &&) = default;
+
+        void await_bind(environment *env, priority_type priority_) noexcept {
+            net->env_ = env;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(net->routers_[node].receivers, coro_data, 0, priority, "network receive");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        packet *await_resume() noexcept {
+            return value;
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() {
+            auto &delivered = net->routers_[node].delivered;
+            if (delivered.empty())
+                return false;
+
+            value = delivered.front();
+            delivered.pop_front();
+            return true;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(net->routers_[node].receivers, core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            this->discard_();
+        }
+
+        packet *select_resume() noexcept {
+            return value;
+        }
+    };
+
+    void check_(node_id node) const {
+        if (node >= routers_.size())
+            throw std::runtime_error("network node does not exist");
+    }
+
+    void inject_(packet *p) {
+        p->created = env_->now();
+        ++sent_;
+
+        auto &r = routers_[p->src];
+        r.injection.push_back(p);
+        wake_(r, env_->now());
+    }
+
+    // makes sure that r steps at t, or earlier
+    void wake_(router_state &r, time_integral t) {
+        if (r.stepped && t <= r.last_step)
+            t = r.last_step + config_.cycle;
+
+        if (r.pending && r.next <= t)
+            return ;
+
+        r.pending = true;
+        r.next = t;
+
+        // after the other events of that time, so that every send is seen
+        auto tkn = new token(t, priority_consts::lowest, nullptr, "router step");
+        tkn->handler = r.stepper.get();
+        env_->schedule_token(tkn);
+    }
+
+    void step_(router_state &r) {
+        auto now = env_->now();
+
+        // a superseded step of an earlier wake
+        if (r.stepped && r.last_step == now)
+            return ;
+
+        if (r.pending && r.next <= now)
+            r.pending = false;
+
+        r.stepped = true;
+        r.last_step = now;
+        ++steps_;
+
+        bool progress = false;
+        wake_batch batch;
+
+        for (auto &in: r.in) {
+            while (!in.arrivals.empty() && in.arrivals.front().time <= now) {
+                auto &a = in.arrivals.front();
+                in.vcs[a.vc].buffer.push_back(a.f);
+                ++r.buffered;
+                in.arrivals.pop_front();
+            }
+        }
+
+        for (auto &out: r.out) {
+            while (!out.credits_back.empty() && out.credits_back.front().time <= now) {
+                ++out.credits[out.credits_back.front().vc];
+                out.credits_back.pop_front();
+            }
+        }
+
+        progress |= inject_flit_(r, now);
+        progress |= allocate_vcs_(r);
+        progress |= traverse_(r, now, batch);
+
+        batch.schedule(env_);
+
+        // routers that make no progress are blocked until flits or credits arrive
+        auto next = progress || !r.injection.empty() ? now + config_.cycle : never;
+
+        for (auto &in: r.in)
+            if (!in.arrivals.empty())
+                next = std::min(next, in.arrivals.front().time);
+
+        for (auto &out: r.out)
+            if (!out.credits_back.empty())
+                next = std::min(next, out.credits_back.front().time);
+
+        if (next != never)
+            wake_(r, next);
+    }
+
+    // moves one flit of the oldest queued packet into a local input buffer
+    bool inject_flit_(router_state &r, time_integral now) {
+        if (r.injection.empty())
+            return false;
+
+        auto &vcs = r.in[local_port].vcs;
+        auto p = r.injection.front();
+
+        if (r.injected == 0) {
+            // a new packet takes the emptiest virtual channel
+            auto best = vcs.size();
+            for (std::size_t v = 0; v < vcs.size(); ++v) {
+                if (vcs[v].buffer.size() < config_.buffer_depth &&
+                    (best == vcs.size() || vcs[v].buffer.size() < vcs[best].buffer.size()))
+                    best = v;
+            }
+
+            if (best == vcs.size())
+                return false;
+
+            r.inject_vc = best;
+            p->injected = now;
+        }
+
+        auto &vc = vcs[r.inject_vc];
+        if (vc.buffer.size() == config_.buffer_depth)
+            return false;
+
+        vc.buffer.push_back(flit{p, r.injected});
+        ++r.buffered;
+
+        if (++r.injected == p->flits) {
+            r.injection.pop_front();
+            r.injected = 0;
+        }
+
+        return true;
+    }
+
+    route_result route_(router_state &r, packet const &p) const {
+        if (p.dst == r.id)
+            return route_result{local_port, 0, config_.vcs};
+
+        auto res = route(r.id, p);
+        if (res.port == local_port || res.port >= r.out.size() || !r.out[res.port].downstream ||
+            res.vc_begin >= res.vc_end || res.vc_end > config_.vcs)
+            throw std::runtime_error("network route is invalid");
+
+        return res;
+    }
+
+    bool older_(input_vc const *a, input_vc const *b) const noexcept {
+        auto pa = a->buffer.front().pkt;
+        auto pb = b->buffer.front().pkt;
+        return pa->created != pb->created ? pa->created < pb->created : pa->id < pb->id;
+    }
+
+    // gives free output virtual channels to routed head flits
+    bool allocate_vcs_(router_state &r) {
+        auto vcs = config_.vcs;
+        auto total = r.in.size() * vcs;
+
+        auto &waiting = waiting_;
+        waiting.clear();
+        for (std::size_t k = 0; k < total; ++k) {
+            auto i = (r.last_vc_alloc + 1 + k) % total;
+            auto &ivc = r.in[i / vcs].vcs[i % vcs];
+            if (!ivc.active && !ivc.buffer.empty())
+                waiting.push_back(&ivc);
+        }
+
+        if (config_.allocation == allocation_policy::oldest_first)
+            std::stable_sort(waiting.begin(), waiting.end(), [this](auto a, auto b) { return older_(a, b); });
+
+        bool progress = false;
+        for (auto ivc: waiting) {
+            auto res = route_(r, *ivc->buffer.front().pkt);
+            auto &out = r.out[res.port];
+
+            for (auto v = res.vc_begin; v < res.vc_end; ++v) {
+                if (!out.owner[v]) {
+                    out.owner[v] = ivc;
+                    ivc->active = true;
+                    ivc->out_port = res.port;
+                    ivc->out_vc = v;
+                    progress = true;
+                    break ;
+                }
+            }
+        }
+
+        if (!waiting.empty())
+            r.last_vc_alloc = (r.last_vc_alloc + 1) % total;
+
+        return progress;
+    }
+
+    // sends at most one flit per output port and per input port
+    bool traverse_(router_state &r, time_integral now, wake_batch &batch) {
+        auto vcs = config_.vcs;
+        auto total = r.in.size() * vcs;
+
+        auto &busy_input = busy_input_;
+        busy_input.assign(r.in.size(), false);
+        bool progress = false;
+
+        for (std::size_t o = 0; o < r.out.size(); ++o) {
+            auto &out = r.out[o];
+            input_vc *winner = nullptr;
+            std::size_t winner_index = 0;
+
+            for (std::size_t k = 0; k < total; ++k) {
+                auto i = (out.last + 1 + k) % total;
+                auto &ivc = r.in[i / vcs].vcs[i % vcs];
+
+                if (!ivc.active || ivc.out_port != o || ivc.buffer.empty() || busy_input[i / vcs])
+                    continue ;
+
+                if (out.downstream && out.credits[ivc.out_vc] == 0)
+                    continue ;
+
+                if (!winner || (config_.allocation == allocation_policy::oldest_first && older_(&ivc, winner))) {
+                    winner = &ivc;
+                    winner_index = i;
+
+                    if (config_.allocation == allocation_policy::round_robin)
+                        break ;
+                }
+            }
+
+            if (!winner)
+                continue ;
+
+            out.last = winner_index;
+            busy_input[winner_index / vcs] = true;
+            send_flit_(r, winner_index / vcs, winner_index % vcs, now, batch);
+            progress = true;
+        }
+
+        return progress;
+    }
+
+    void send_flit_(router_state &r, std::size_t port, std::size_t vc, time_integral now, wake_batch &batch) {
+        auto &in = r.in[port];
+        auto &ivc = in.vcs[vc];
+        auto &out = r.out[ivc.out_port];
+        auto f = ivc.buffer.front();
+
+        ivc.buffer.pop_front();
+        --r.buffered;
+
+        if (in.upstream) {
+            in.upstream->out[in.upstream_port].credits_back.push_back(credit{now + config_.credit_latency, vc});
+            wake_(*in.upstream, now + config_.credit_latency);
+        }
+
+        if (out.downstream) {
+            --out.credits[ivc.out_vc];
+            if (f.head())
+                ++f.pkt->hops;
+
+            out.downstream->in[out.downstream_port].arrivals.push_back(arrival{now + config_.link_latency, ivc.out_vc, f});
+            wake_(*out.downstream, now + config_.link_latency);
+            ++link_traversals_;
+        }
+        else if (f.tail()) {
+            deliver_(r, f.pkt, now, batch);
+        }
+
+        if (f.tail()) {
+            out.owner[ivc.out_vc] = nullptr;
+            ivc.active = false;
+        }
+    }
+
+    void deliver_(router_state &r, packet *p, time_integral now, wake_batch &batch) {
+        p->delivered = now;
+        ++delivered_;
+
+        if (r.receivers.empty()) {
+            r.delivered.push_back(p);
+            return ;
+        }
+
+        auto w = static_cast<receive_awaitable *>(r.receivers.pop_front());
+        w->value = p;
+        w->notify_(env_, batch);
+    }
+
+    network_config config_;
+    environment *env_ = nullptr;
+
+    // routers are never erased, so links can point to them
+    std::deque<router_state> routers_;
+    packet_pool pool_;
+
+    // scratch space of the allocators, kept to avoid allocating every step
+    std::vector<input_vc *> waiting_;
+    std::vector<bool> busy_input_;
+
+    std::uint64_t sent_ = 0;
+    std::uint64_t delivered_ = 0;
+    std::uint64_t link_traversals_ = 0;
+    std::uint64_t steps_ = 0;
+};
+
+} /* namespace detail */
+
+using detail::network;
+
+} /* namespace net */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_NET_NETWORK_HPP_INCLUDED */
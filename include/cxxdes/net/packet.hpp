@@ -0,0 +1,145 @@
+/**
+ * @file packet.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Packet descriptors, flits, and a packet pool.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_NET_PACKET_HPP_INCLUDED
+#define CXXDES_NET_PACKET_HPP_INCLUDED
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace net {
+
+/** @brief Identifier of a router, and of the terminal attached to it. */
+using node_id = std::size_t;
+
+/**
+ * @brief Descriptor of a packet travelling through a network.
+ *
+ * The network only moves pointers to descriptors; the payload itself stays
+ * wherever `payload` points to, and is never copied.
+ */
+struct packet {
+    /** @brief Sequence number assigned by the pool. */
+    std::uint64_t id = 0;
+
+    /** @brief Source terminal. */
+    node_id src = 0;
+
+    /** @brief Destination terminal. */
+    node_id dst = 0;
+
+    /** @brief Length in flits; at least one. */
+    std::uint32_t flits = 1;
+
+    /** @brief Number of router-to-router links traversed so far. */
+    std::uint32_t hops = 0;
+
+    /** @brief Time `send()` was called. */
+    cxxdes::core::time_integral created = 0;
+
+    /** @brief Time the head flit entered the source router. */
+    cxxdes::core::time_integral injected = 0;
+
+    /** @brief Time the tail flit left the destination router. */
+    cxxdes::core::time_integral delivered = 0;
+
+    /** @brief User tag; the network does not touch it. */
+    std::uint64_t tag = 0;
+
+    /** @brief User payload; the network does not touch or copy it. */
+    void *payload = nullptr;
+};
+
+/** @brief Flow control unit: one slice of a packet, as small as two words. */
+struct flit {
+    packet *pkt = nullptr;
+    std::uint32_t index = 0;
+
+    /** @brief Returns whether this is the first flit of its packet. */
+    bool head() const noexcept {
+        return index == 0;
+    }
+
+    /** @brief Returns whether this is the last flit of its packet. */
+    bool tail() const noexcept {
+        return index + 1 == pkt->flits;
+    }
+};
+
+/**
+ * @brief Pool recycling packet descriptors.
+ *
+ * Descriptors are allocated in chunks and never freed before the pool, so a
+ * steady-state simulation does not allocate per packet. Pointers returned by
+ * `acquire()` stay valid until they are given back with `release()`.
+ */
+struct packet_pool {
+    packet_pool() = default;
+
+    CXXDES_NOT_COPIABLE(packet_pool)
+    CXXDES_NOT_MOVABLE(packet_pool)
+
+    /** @brief Returns a reset descriptor from @p src to @p dst with @p flits flits. */
+    [[nodiscard]]
+    packet *acquire(node_id src, node_id dst, std::uint32_t flits = 1) {
+        if (flits == 0)
+            throw std::runtime_error("packet must have at least one flit");
+
+        packet *p;
+        if (free_.empty()) {
+            p = &storage_.emplace_back();
+        }
+        else {
+            p = free_.back();
+            free_.pop_back();
+            *p = packet{};
+        }
+
+        p->id = next_id_++;
+        p->src = src;
+        p->dst = dst;
+        p->flits = flits;
+
+        ++live_;
+        return p;
+    }
+
+    /** @brief Gives @p p back to the pool. */
+    void release(packet *p) {
+        free_.push_back(p);
+        --live_;
+    }
+
+    /** @brief Returns the number of acquired descriptors not released yet. */
+    std::size_t live() const noexcept {
+        return live_;
+    }
+
+    /** @brief Returns the number of descriptors allocated so far. */
+    std::size_t allocated() const noexcept {
+        return storage_.size();
+    }
+
+private:
+    std::deque<packet> storage_;
+    std::vector<packet *> free_;
+    std::uint64_t next_id_ = 0;
+    std::size_t live_ = 0;
+};
+
+} /* namespace net */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_NET_PACKET_HPP_INCLUDED */
@@ -0,0 +1,158 @@
+/**
+ * @file topology.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Two-dimensional mesh and torus networks.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_NET_TOPOLOGY_HPP_INCLUDED
+#define CXXDES_NET_TOPOLOGY_HPP_INCLUDED
+
+#include <stdexcept>
+#include <cxxdes/net/network.hpp>
+
+namespace cxxdes {
+namespace net {
+
+/** @brief Router ports of a two-dimensional grid. */
+namespace grid_ports {
+    inline constexpr std::size_t local = 0;
+    inline constexpr std::size_t east = 1;  // +x
+    inline constexpr std::size_t west = 2;  // -x
+    inline constexpr std::size_t north = 3; // +y
+    inline constexpr std::size_t south = 4; // -y
+}
+
+namespace detail {
+
+/**
+ * @brief `cols` by `rows` grid of routers with dimension-order routing.
+ *
+ * Router `(x, y)` is node `y * cols + x`. Packets travel along x first, then
+ * along y, which is deadlock-free on a mesh. With @p wrap, the grid is a
+ * torus, packets take the shorter way around each ring, and the virtual
+ * channels are split into two classes at a dateline on each ring to keep it
+ * deadlock-free.
+ */
+struct grid: network {
+    /** @brief Returns the node at (@p x, @p y). */
+    node_id node(std::size_t x, std::size_t y) const noexcept {
+        return y * cols_ + x;
+    }
+
+    /** @brief Returns the column of @p node. */
+    std::size_t x_of(node_id node) const noexcept {
+        return node % cols_;
+    }
+
+    /** @brief Returns the row of @p node. */
+    std::size_t y_of(node_id node) const noexcept {
+        return node / cols_;
+    }
+
+    /** @brief Returns the number of columns. */
+    std::size_t cols() const noexcept {
+        return cols_;
+    }
+
+    /** @brief Returns the number of rows. */
+    std::size_t rows() const noexcept {
+        return rows_;
+    }
+
+protected:
+    grid(std::size_t cols, std::size_t rows, bool wrap, network_config const &config):
+        network{config}, cols_{cols}, rows_{rows}, wrap_{wrap} {
+        if (cols == 0 || rows == 0)
+            throw std::runtime_error("grid must have at least one row and one column");
+
+        if (wrap && config.vcs < 2)
+            throw std::runtime_error("torus needs at least two virtual channels");
+
+        for (std::size_t i = 0; i < cols * rows; ++i)
+            add_router(5);
+
+        for (std::size_t y = 0; y < rows; ++y) {
+            for (std::size_t x = 0; x < cols; ++x) {
+                if (x + 1 < cols || (wrap && cols > 1)) {
+                    auto east = node((x + 1) % cols, y);
+                    connect(node(x, y), grid_ports::east, east, grid_ports::west);
+                    connect(east, grid_ports::west, node(x, y), grid_ports::east);
+                }
+
+                if (y + 1 < rows || (wrap && rows > 1)) {
+                    auto north = node(x, (y + 1) % rows);
+                    connect(node(x, y), grid_ports::north, north, grid_ports::south);
+                    connect(north, grid_ports::south, node(x, y), grid_ports::north);
+                }
+            }
+        }
+    }
+
+    route_result route(node_id at, packet const &p) const override {
+        auto x = x_of(at);
+        auto y = y_of(at);
+
+        if (x != x_of(p.dst))
+            return hop_(x, x_of(p.dst), x_of(p.src), cols_, grid_ports::east, grid_ports::west);
+
+        return hop_(y, y_of(p.dst), y_of(p.src), rows_, grid_ports::north, grid_ports::south);
+    }
+
+private:
+    // one hop along a dimension of size k, from c towards d, for a packet that entered it at s
+    route_result hop_(
+        std::size_t c, std::size_t d, std::size_t s, std::size_t k,
+        std::size_t up, std::size_t down) const {
+        auto vcs = config().vcs;
+
+        if (!wrap_)
+            return route_result{d > c ? up : down, 0, vcs};
+
+        auto forward = (d + k - c) % k;
+        bool positive = forward <= k - forward;
+
+        // past the dateline, or about to cross it, packets use the upper class
+        bool crossed = positive ? (c == k - 1 || c < s) : (c == 0 || c > s);
+
+        if (crossed)
+            return route_result{positive ? up : down, vcs / 2, vcs};
+
+        return route_result{positive ? up : down, 0, vcs / 2};
+    }
+
+    std::size_t cols_;
+    std::size_t rows_;
+    bool wrap_;
+};
+
+} /* namespace detail */
+
+/** @brief Two-dimensional mesh with XY routing. */
+struct mesh: detail::grid {
+    /** @brief Constructs a @p cols by @p rows mesh. */
+    mesh(std::size_t cols, std::size_t rows, network_config const &config = {}):
+        grid{cols, rows, false, config} {
+    }
+};
+
+/**
+ * @brief Two-dimensional torus with dimension-order routing and dateline virtual channels.
+ *
+ * @throws std::runtime_error From the constructor if fewer than two virtual
+ *         channels are configured.
+ */
+struct torus: detail::grid {
+    /** @brief Constructs a @p cols by @p rows torus. */
+    torus(std::size_t cols, std::size_t rows, network_config const &config = {}):
+        grid{cols, rows, true, config} {
+    }
+};
+
+} /* namespace net */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_NET_TOPOLOGY_HPP_INCLUDED */
@@ -0,0 +1,212 @@
+/**
+ * @file channel.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Partitions of a parallel simulation and the timestamped channels between them.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_CHANNEL_HPP_INCLUDED
+#define CXXDES_PARALLEL_CHANNEL_HPP_INCLUDED
+
+#include <atomic>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/misc/spsc_queue.hpp>
+#include <cxxdes/sync/queue.hpp>
+
+namespace cxxdes {
+namespace parallel {
+
+using namespace cxxdes::core;
+
+struct engine;
+struct partition;
+
+namespace detail {
+
+// time that no event reaches
+constexpr time_integral never = std::numeric_limits<time_integral>::max();
+
+// a + b, or never if it does not fit
+constexpr time_integral saturating_add(time_integral a, time_integral b) noexcept {
+    return a > never - b ? never : a + b;
+}
+
+// time of the next event of env, or never
+inline time_integral next_time(environment const &env) noexcept {
+    auto tkn = env.next_event();
+    return tkn ? tkn->time : never;
+}
+
+// runs the events of env before t; returns whether it ran any
+inline bool run_before(environment &env, time_integral t) {
+    bool ran = false;
+    for (auto tkn = env.next_event(); tkn && tkn->time < t; tkn = env.next_event())
+        ran = env.step();
+    return ran;
+}
+
+struct channel_base {
+    channel_base(partition *from, partition *to, time_integral lookahead):
+        from_{from}, to_{to}, lookahead_{lookahead} {
+    }
+
+    CXXDES_NOT_COPIABLE(channel_base)
+    CXXDES_NOT_MOVABLE(channel_base)
+
+    // schedules the messages in transit as events of the destination; called
+    // by the thread of the destination, or while no partition runs
+    virtual void deliver() = 0;
+
+    virtual ~channel_base() = default;
+
+    partition *from_;
+    partition *to_;
+    time_integral lookahead_;
+
+    // no message sent from now on is earlier than this; raised by the thread
+    // of the source under null-message synchronization
+    std::atomic<time_integral> clock_ = 0;
+};
+
+} /* namespace detail */
+
+/**
+ * @brief Logical process of a parallel simulation: an environment run by a thread of its own.
+ *
+ * Bind processes to `env` as to any environment; they may use every
+ * `coroutine<>` and `sync` facility, as long as everything they touch belongs
+ * to this partition. Partitions interact only through `channel`s.
+ */
+struct partition {
+    /** @brief Environment of the partition. */
+    environment env;
+
+    CXXDES_NOT_COPIABLE(partition)
+    CXXDES_NOT_MOVABLE(partition)
+
+    /** @brief Returns the position of the partition in its engine, from zero. */
+    std::size_t index() const noexcept {
+        return index_;
+    }
+
+private:
+    friend struct engine;
+
+    partition(engine *owner, std::size_t index): owner_{owner}, index_{index} {
+    }
+
+    engine *owner_;
+    std::size_t index_;
+    std::vector<detail::channel_base *> inputs_;
+    std::vector<detail::channel_base *> outputs_;
+};
+
+/**
+ * @brief One-way link carrying values of type @p T from one partition to another.
+ *
+ * A value sent at time `t` of the source arrives at time `t + delay` of the
+ * destination, where `delay` is at least the lookahead of the channel, and is
+ * put into `inbox()`, from which processes of the destination pop it. The
+ * lookahead is the promise that lets the destination run ahead: it never
+ * receives a message earlier than the time of the source plus the lookahead.
+ *
+ * `send()` must be called by processes of the source and `pop()` by
+ * processes of the destination. Values travel through a lock-free queue, so
+ * the source never waits for the destination. Times are in ticks, and the
+ * partitions are expected to share their time precision.
+ *
+ * @tparam T Value type, copied or moved across threads.
+ */
+template <typename T>
+struct channel: detail::channel_base {
+    /** @brief Sends @p value to arrive after the lookahead. */
+    void send(T value) {
+        send(std::move(value), lookahead_);
+    }
+
+    /**
+     * @brief Sends @p value to arrive after @p delay ticks.
+     *
+     * @throws std::runtime_error If @p delay is less than the lookahead.
+     */
+    void send(T value, time_integral delay) {
+        if (delay < lookahead_)
+            throw std::runtime_error("channel delay must be at least its lookahead");
+
+        messages_.push(message{from_->env.now() + delay, std::move(value)});
+    }
+
+    /** @brief Waits for a value and returns it; `co_await ch.pop()` in the destination. */
+    [[nodiscard("expected usage: co_await channel.pop()")]]
+    auto pop() {
+        return inbox_.pop();
+    }
+
+    /** @brief Returns the queue of arrived values, for `select` and the other queue operations. */
+    sync::queue<T> &inbox() noexcept {
+        return inbox_;
+    }
+
+    /** @brief Returns the minimum delay of the channel, in ticks. */
+    time_integral lookahead() const noexcept {
+        return lookahead_;
+    }
+
+    /** @brief Returns the partition that sends. */
+    partition &source() const noexcept {
+        return *from_;
+    }
+
+    /** @brief Returns the partition that receives. */
+    partition &destination() const noexcept {
+        return *to_;
+    }
+
+private:
+    friend struct engine;
+
+    struct message {
+        time_integral time;
+        T value;
+    };
+
+    struct arrival_handler: token_handler {
+        channel *ch;
+        T value;
+
+        arrival_handler(channel *ch_, T value_): ch{ch_}, value{std::move(value_)} {
+        }
+
+        void invoke(token *) override {
+            ch->inbox_.try_put(ch->to_->env, std::move(value));
+        }
+    };
+
+    channel(partition *from, partition *to, time_integral lookahead):
+        channel_base{from, to, lookahead} {
+    }
+
+    void deliver() override {
+        while (auto m = messages_.pop()) {
+            auto tkn = new token(m->time, priority_consts::zero, nullptr, "channel arrival");
+            tkn->handler = new arrival_handler{this, std::move(m->value)};
+            to_->env.schedule_token(tkn);
+        }
+    }
+
+    util::spsc_queue<message> messages_;
+    sync::queue<T> inbox_;
+};
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_PARALLEL_CHANNEL_HPP_INCLUDED */
@@ -0,0 +1,308 @@
+/**
+ * @file engine.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Conservative parallel simulation of partitions on threads.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_ENGINE_HPP_INCLUDED
+#define CXXDES_PARALLEL_ENGINE_HPP_INCLUDED
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <barrier>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/parallel/channel.hpp>
+
+namespace cxxdes {
+namespace parallel {
+
+/** @brief How the partitions of an `engine` agree on how far each may run. */
+enum class synchronization {
+    /**
+     * @brief Windows separated by barriers (YAWNS).
+     *
+     * Between windows, every partition is stopped, messages in transit are
+     * delivered, and the next window is the earliest time any partition may
+     * send a message to: the minimum over partitions of the time of their next
+     * event plus their smallest outgoing lookahead. Every partition then runs
+     * its events before that time.
+     */
+    window,
+
+    /**
+     * @brief Null messages (Chandy-Misra-Bryant), without global stops.
+     *
+     * Every channel carries a clock, the earliest time of a message it may
+     * still deliver. A partition runs its events before the smallest clock of
+     * its inputs, then raises the clocks of its outputs to the earliest time of
+     * its next event, or of its next input, plus their lookahead. A raised
+     * clock is the null message. Needs an end time.
+     */
+    null_messages
+};
+
+/**
+ * @brief Parallel simulation made of partitions, each an environment run by a thread of its own.
+ *
+ * Partitions exchange timestamped values through `channel`s, whose lookahead
+ * bounds how far one partition may run ahead of another, and the engine
+ * synchronizes them conservatively: no partition ever receives a message
+ * earlier than its current time. Within a partition, the order of events is
+ * the same as if the partition ran alone with the messages as inputs, so the
+ * outcome does not depend on the number of cores or on the scheduling of
+ * threads, except for the relative order of a message and a local event at
+ * the same time and priority.
+ *
+ * Partitions and channels are created before running, and the engine must
+ * outlive its processes' use of them.
+ */
+struct engine {
+    /** @brief Constructs an engine without partitions, synchronized with @p sync. */
+    explicit engine(synchronization sync = synchronization::window): sync_{sync} {
+    }
+
+    CXXDES_NOT_COPIABLE(engine)
+    CXXDES_NOT_MOVABLE(engine)
+
+    /** @brief Adds a partition and returns it. */
+    partition &add_partition() {
+        partitions_.emplace_back(new partition{this, partitions_.size()});
+        return *partitions_.back();
+    }
+
+    /** @brief Returns the number of partitions. */
+    std::size_t size() const noexcept {
+        return partitions_.size();
+    }
+
+    /** @brief Returns partition @p i. */
+    partition &operator[](std::size_t i) noexcept {
+        return *partitions_[i];
+    }
+
+    /**
+     * @brief Adds a channel carrying values of type @p T from @p from to @p to.
+     *
+     * @param lookahead Minimum delay of a message, in ticks.
+     *
+     * @throws std::runtime_error If @p lookahead is not positive, or a
+     *         partition belongs to another engine.
+     */
+    template <typename T>
+    channel<T> &connect(partition &from, partition &to, time_integral lookahead) {
+        if (lookahead <= 0)
+            throw std::runtime_error("channel lookahead must be positive");
+
+        if (from.owner_ != this || to.owner_ != this)
+            throw std::runtime_error("cannot connect partitions of another engine");
+
+        auto c = new channel<T>{&from, &to, lookahead};
+        channels_.emplace_back(c);
+        from.outputs_.push_back(c);
+        to.inputs_.push_back(c);
+        return *c;
+    }
+
+    /**
+     * @brief Runs until no partition has an event and no message is in transit.
+     *
+     * @throws std::runtime_error Under null-message synchronization, which cannot detect the end.
+     * @throws The first exception thrown by an event of a partition.
+     */
+    void run() {
+        if (sync_ == synchronization::null_messages)
+            throw std::runtime_error("null-message synchronization needs an end time; call run_until()");
+
+        run_(detail::never);
+    }
+
+    /**
+     * @brief Runs all events at or before @p t, then advances every partition to @p t.
+     *
+     * @throws The first exception thrown by an event of a partition.
+     */
+    void run_until(time_integral t) {
+        run_(t);
+
+        for (auto &p: partitions_)
+            p->env.run_until(t);
+    }
+
+    /** @brief Returns the number of windows run so far under window synchronization. */
+    std::uint64_t windows() const noexcept {
+        return windows_;
+    }
+
+    /** @brief Returns the number of null messages sent so far under null-message synchronization. */
+    std::uint64_t null_messages() const noexcept {
+        return null_messages_;
+    }
+
+private:
+    void fail_(std::exception_ptr e) {
+        std::lock_guard lock{m_};
+        if (!error_)
+            error_ = e;
+        failed_ = true;
+    }
+
+    void run_(time_integral end) {
+        if (partitions_.empty())
+            return ;
+
+        failed_ = false;
+        error_ = nullptr;
+
+        if (sync_ == synchronization::window)
+            run_windows_(end);
+        else
+            run_null_messages_(end);
+
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    void run_windows_(time_integral end) {
+        bool done = false;
+        time_integral window = 0;
+
+        // runs on the last thread to arrive, while all others wait
+        auto plan = [&]() noexcept {
+            try {
+                for (auto &c: channels_)
+                    c->deliver();
+            }
+            catch (...) {
+                fail_(std::current_exception());
+            }
+
+            auto earliest = detail::never;
+            window = detail::never;
+
+            for (auto &p: partitions_) {
+                auto next = detail::next_time(p->env);
+                auto lookahead = detail::never;
+                for (auto c: p->outputs_)
+                    lookahead = std::min(lookahead, c->lookahead_);
+
+                earliest = std::min(earliest, next);
+                window = std::min(window, detail::saturating_add(next, lookahead));
+            }
+
+            done = failed_ || earliest == detail::never || earliest > end;
+            window = std::min(window, detail::saturating_add(end, 1));
+
+            if (!done)
+                ++windows_;
+        };
+
+        std::barrier stops{static_cast<std::ptrdiff_t>(partitions_.size()), plan};
+        std::vector<std::thread> threads;
+
+        for (auto &p: partitions_) {
+            threads.emplace_back([&, env = &p->env] {
+                while (true) {
+                    stops.arrive_and_wait();
+                    if (done)
+                        return ;
+
+                    try {
+                        detail::run_before(*env, window);
+                    }
+                    catch (...) {
+                        fail_(std::current_exception());
+                    }
+                }
+            });
+        }
+
+        for (auto &t: threads)
+            t.join();
+    }
+
+    void run_null_messages_(time_integral end) {
+        std::vector<std::thread> threads;
+
+        for (auto &p: partitions_) {
+            threads.emplace_back([&, p = p.get()] {
+                std::uint64_t sent = 0;
+
+                try {
+                    while (!failed_) {
+                        // the clocks are read before the messages, so every
+                        // message earlier than bound is delivered
+                        auto bound = detail::never;
+                        for (auto c: p->inputs_)
+                            bound = std::min(bound, c->clock_.load(std::memory_order_acquire));
+
+                        for (auto c: p->inputs_)
+                            c->deliver();
+
+                        bool progressed = detail::run_before(p->env, std::min(bound, detail::saturating_add(end, 1)));
+
+                        // no later event of this partition is earlier than floor
+                        auto floor = std::min(detail::next_time(p->env), bound);
+                        bool finished = floor > end;
+
+                        for (auto c: p->outputs_) {
+                            auto clock = finished ? detail::never : detail::saturating_add(floor, c->lookahead_);
+                            if (clock > c->clock_.load(std::memory_order_relaxed)) {
+                                c->clock_.store(clock, std::memory_order_release);
+                                progressed = true;
+                                ++sent;
+                            }
+                        }
+
+                        if (finished)
+                            break;
+
+                        if (!progressed)
+                            std::this_thread::yield();
+                    }
+                }
+                catch (...) {
+                    fail_(std::current_exception());
+                }
+
+                null_messages_ += sent;
+            });
+        }
+
+        for (auto &t: threads)
+            t.join();
+
+        // the next run starts from clocks that promise nothing
+        for (auto &c: channels_)
+            c->clock_ = 0;
+    }
+
+    synchronization sync_;
+
+    // the environments of the partitions refer to the channels, so they go first
+    std::vector<std::unique_ptr<detail::channel_base>> channels_;
+    std::vector<std::unique_ptr<partition>> partitions_;
+
+    std::uint64_t windows_ = 0;
+    std::atomic<std::uint64_t> null_messages_ = 0;
+
+    std::atomic<bool> failed_ = false;
+    std::mutex m_;
+    std::exception_ptr error_;
+};
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_PARALLEL_ENGINE_HPP_INCLUDED */
@@ -0,0 +1,402 @@
+/**
+ * @file node.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Conservative distributed simulation of partitions in separate processes.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_NODE_HPP_INCLUDED
+#define CXXDES_PARALLEL_NODE_HPP_INCLUDED
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/sync/queue.hpp>
+#include <cxxdes/parallel/channel.hpp>
+#include <cxxdes/parallel/transport.hpp>
+
+namespace cxxdes {
+namespace parallel {
+
+struct node;
+
+namespace detail {
+
+struct remote_link_base {
+    remote_link_base(node *owner, std::uint32_t id, std::size_t from, std::size_t to, time_integral lookahead):
+        owner_{owner}, id_{id}, from_{from}, to_{to}, lookahead_{lookahead} {
+    }
+
+    CXXDES_NOT_COPIABLE(remote_link_base)
+    CXXDES_NOT_MOVABLE(remote_link_base)
+
+    // size of a value on the wire
+    virtual std::size_t value_size() const noexcept = 0;
+
+    // schedules the value in bytes as an event of the destination at time t
+    virtual void arrive(time_integral t, std::byte const *bytes) = 0;
+
+    virtual ~remote_link_base() = default;
+
+    node *owner_;
+    std::uint32_t id_;
+    std::size_t from_;
+    std::size_t to_;
+    time_integral lookahead_;
+};
+
+} /* namespace detail */
+
+/**
+ * @brief One-way link carrying values of type @p T from the partition of one process to another.
+ *
+ * Like `channel`, a value sent at time `t` of the source arrives at time
+ * `t + delay` of the destination, with `delay` at least the lookahead, and is
+ * put into `inbox()`. Values are sent as bytes, so @p T must be trivially
+ * copyable; every process must be the same program, built the same way.
+ *
+ * `send()` is called by processes of the source rank and `pop()` by processes
+ * of the destination rank. Other ranks hold the channel only to keep the
+ * channels of all ranks in the same order.
+ */
+template <typename T>
+struct remote_channel: detail::remote_link_base {
+    static_assert(std::is_trivially_copyable_v<T>, "remote channels carry trivially copyable values");
+
+    /** @brief Sends @p value to arrive after the lookahead. */
+    void send(T const &value) {
+        send(value, lookahead_);
+    }
+
+    /**
+     * @brief Sends @p value to arrive after @p delay ticks.
+     *
+     * @throws std::runtime_error If this process is not the source, or @p delay is less than the lookahead.
+     */
+    void send(T const &value, time_integral delay);
+
+    /** @brief Waits for a value and returns it; `co_await ch.pop()` in the destination. */
+    [[nodiscard("expected usage: co_await channel.pop()")]]
+    auto pop() {
+        return inbox_.pop();
+    }
+
+    /** @brief Returns the queue of arrived values, for `select` and the other queue operations. */
+    sync::queue<T> &inbox() noexcept {
+        return inbox_;
+    }
+
+    /** @brief Returns the minimum delay of the channel, in ticks. */
+    time_integral lookahead() const noexcept {
+        return lookahead_;
+    }
+
+    /** @brief Returns the rank that sends. */
+    std::size_t source() const noexcept {
+        return from_;
+    }
+
+    /** @brief Returns the rank that receives. */
+    std::size_t destination() const noexcept {
+        return to_;
+    }
+
+private:
+    friend struct node;
+
+    struct arrival_handler: token_handler {
+        remote_channel *ch;
+        T value;
+
+        arrival_handler(remote_channel *ch_, T const &value_): ch{ch_}, value{value_} {
+        }
+
+        void invoke(token *) override;
+    };
+
+    using remote_link_base::remote_link_base;
+
+    std::size_t value_size() const noexcept override {
+        return sizeof(T);
+    }
+
+    void arrive(time_integral t, std::byte const *bytes) override;
+
+    sync::queue<T> inbox_;
+};
+
+/**
+ * @brief Partition of a distributed simulation: the environment of one process among several.
+ *
+ * All processes run the same program, each with a `node` over its endpoint
+ * of a `transport`. They declare the same `remote_channel`s in the same
+ * order, bind processes to the `env` of their own rank, and call `run()` or
+ * `run_until()` together.
+ *
+ * Synchronization follows `synchronization::window` of `engine`: messages
+ * sent during a window are batched, and between windows every process sends
+ * every other one a single frame, holding its messages for that process and
+ * what it promises about its next messages. From these, all processes agree
+ * on the end of the next window and on when to stop, so the outcome does not
+ * depend on how fast each process runs.
+ */
+struct node {
+    /** @brief Constructs the partition of the process at the rank of @p t; @p t must outlive it. */
+    explicit node(transport &t): transport_{&t}, out_(t.size()) {
+    }
+
+    CXXDES_NOT_COPIABLE(node)
+    CXXDES_NOT_MOVABLE(node)
+
+private:
+    // the environment refers to the channels, so they go first
+    std::vector<std::unique_ptr<detail::remote_link_base>> links_;
+
+public:
+    /** @brief Environment of the partition of this process. */
+    environment env;
+
+    /** @brief Returns the rank of this process. */
+    std::size_t rank() const noexcept {
+        return transport_->rank();
+    }
+
+    /** @brief Returns the number of processes. */
+    std::size_t size() const noexcept {
+        return transport_->size();
+    }
+
+    /**
+     * @brief Adds a channel carrying values of type @p T from rank @p from to rank @p to.
+     *
+     * Every process must add the same channels in the same order.
+     *
+     * @param lookahead Minimum delay of a message, in ticks.
+     *
+     * @throws std::runtime_error If @p lookahead is not positive, or the ranks
+     *         are equal or out of range.
+     */
+    template <typename T>
+    remote_channel<T> &connect(std::size_t from, std::size_t to, time_integral lookahead) {
+        if (lookahead <= 0)
+            throw std::runtime_error("channel lookahead must be positive");
+
+        if (from >= size() || to >= size() || from == to)
+            throw std::runtime_error("remote channels connect two distinct ranks");
+
+        auto c = new remote_channel<T>{this, static_cast<std::uint32_t>(links_.size()), from, to, lookahead};
+        links_.emplace_back(c);
+        return *c;
+    }
+
+    /**
+     * @brief Runs until no process has an event and no message is in transit.
+     *
+     * @throws The exception thrown by an event of this process, or
+     *         std::runtime_error if another process failed.
+     */
+    void run() {
+        run_(detail::never);
+    }
+
+    /**
+     * @brief Runs all events at or before @p t, then advances the partition to @p t.
+     *
+     * @throws The exception thrown by an event of this process, or
+     *         std::runtime_error if another process failed.
+     */
+    void run_until(time_integral t) {
+        run_(t);
+        env.run_until(t);
+    }
+
+    /** @brief Returns the number of windows run so far; the same on every process. */
+    std::uint64_t windows() const noexcept {
+        return windows_;
+    }
+
+private:
+    template <typename T>
+    friend struct remote_channel;
+
+    // what a process tells every other one between windows
+    struct header {
+        time_integral next;
+        time_integral lookahead;
+        time_integral earliest;
+        std::uint8_t failed;
+    };
+
+    // what precedes the bytes of every message
+    struct message_header {
+        std::uint32_t link;
+        time_integral time;
+    };
+
+    void post_(detail::remote_link_base const &link, time_integral t, void const *bytes) {
+        auto &out = out_[link.to_];
+        auto at = out.size();
+        out.resize(at + sizeof(message_header) + link.value_size());
+
+        message_header h{link.id_, t};
+        std::memcpy(out.data() + at, &h, sizeof(h));
+        std::memcpy(out.data() + at + sizeof(h), bytes, link.value_size());
+
+        earliest_ = std::min(earliest_, t);
+    }
+
+    void deliver_(std::size_t from, frame const &in) {
+        std::size_t at = sizeof(header);
+        while (at < in.size()) {
+            message_header h;
+            if (in.size() - at < sizeof(h))
+                throw std::runtime_error("malformed frame from rank " + std::to_string(from));
+
+            std::memcpy(&h, in.data() + at, sizeof(h));
+            at += sizeof(h);
+
+            if (h.link >= links_.size())
+                throw std::runtime_error("malformed frame from rank " + std::to_string(from));
+
+            auto &link = *links_[h.link];
+            if (link.from_ != from || link.to_ != rank() || in.size() - at < link.value_size())
+                throw std::runtime_error("malformed frame from rank " + std::to_string(from));
+
+            link.arrive(h.time, in.data() + at);
+            at += link.value_size();
+        }
+    }
+
+    void run_(time_integral end) {
+        auto n = size();
+
+        // the smallest lookahead, out of this process and out of any
+        auto lookahead = detail::never;
+        auto smallest = detail::never;
+        for (auto &l: links_) {
+            smallest = std::min(smallest, l->lookahead_);
+            if (l->from_ == rank())
+                lookahead = std::min(lookahead, l->lookahead_);
+        }
+
+        std::exception_ptr error;
+
+        while (true) {
+            header own{detail::next_time(env), lookahead, earliest_, static_cast<std::uint8_t>(error ? 1 : 0)};
+
+            for (std::size_t p = 0; p < n; ++p) {
+                out_[p].insert(out_[p].begin(), sizeof(header), std::byte{});
+                std::memcpy(out_[p].data(), &own, sizeof(header));
+            }
+
+            auto in = transport_->exchange(out_);
+
+            for (auto &out: out_)
+                out.clear();
+            earliest_ = detail::never;
+
+            std::vector<header> headers(n);
+            headers[rank()] = own;
+
+            for (std::size_t p = 0; p < n; ++p) {
+                if (p == rank())
+                    continue;
+
+                if (in[p].size() < sizeof(header))
+                    throw std::runtime_error("malformed frame from rank " + std::to_string(p));
+
+                std::memcpy(&headers[p], in[p].data(), sizeof(header));
+            }
+
+            // every process stops at the same exchange after a failure
+            for (std::size_t p = 0; p < n; ++p) {
+                if (!headers[p].failed)
+                    continue;
+
+                if (error)
+                    std::rethrow_exception(error);
+
+                throw std::runtime_error("rank " + std::to_string(p) + " of the distributed simulation failed");
+            }
+
+            for (std::size_t p = 0; p < n; ++p)
+                if (p != rank())
+                    deliver_(p, in[p]);
+
+            // no event of any process is earlier than earliest, and no message
+            // that any process may send is earlier than window
+            auto earliest = detail::never;
+            auto window = detail::never;
+            for (auto const &h: headers) {
+                earliest = std::min({ earliest, h.next, h.earliest });
+                window = std::min({
+                    window,
+                    detail::saturating_add(h.next, h.lookahead),
+                    detail::saturating_add(h.earliest, smallest) });
+            }
+
+            if (earliest == detail::never || earliest > end)
+                return ;
+
+            ++windows_;
+
+            try {
+                detail::run_before(env, std::min(window, detail::saturating_add(end, 1)));
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    transport *transport_;
+
+    // messages sent during the current window, by destination, and the earliest of their times
+    std::vector<frame> out_;
+    time_integral earliest_ = detail::never;
+
+    std::uint64_t windows_ = 0;
+};
+
+template <typename T>
+void remote_channel<T>::send(T const &value, time_integral delay) {
+    if (owner_->rank() != from_)
+        throw std::runtime_error("remote channel sends from rank " + std::to_string(from_) + " only");
+
+    if (delay < lookahead_)
+        throw std::runtime_error("channel delay must be at least its lookahead");
+
+    owner_->post_(*this, owner_->env.now() + delay, &value);
+}
+
+template <typename T>
+void remote_channel<T>::arrival_handler::invoke(token *) {
+    ch->inbox_.try_put(ch->owner_->env, value);
+}
+
+template <typename T>
+void remote_channel<T>::arrive(time_integral t, std::byte const *bytes) {
+    // the bytes of a trivially copyable value make a value
+    alignas(T) std::byte storage[sizeof(T)];
+    std::memcpy(storage, bytes, sizeof(T));
+
+    auto tkn = new token(t, priority_consts::zero, nullptr, "remote channel arrival");
+    tkn->handler = new arrival_handler{this, *std::launder(reinterpret_cast<T *>(storage))};
+    owner_->env.schedule_token(tkn);
+}
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_PARALLEL_NODE_HPP_INCLUDED */
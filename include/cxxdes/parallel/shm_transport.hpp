@@ -0,0 +1,168 @@
+/**
+ * @file shm_transport.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Transport over ring buffers in shared memory.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_SHM_TRANSPORT_HPP_INCLUDED
+#define CXXDES_PARALLEL_SHM_TRANSPORT_HPP_INCLUDED
+
+#include <cxxdes/parallel/transport.hpp>
+
+// shm_transport needs memory shared by forked processes
+#if __has_include(<sys/mman.h>)
+
+#include <sys/mman.h>
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+
+#define CXXDES_HAS_SHM_TRANSPORT 1
+
+namespace cxxdes {
+namespace parallel {
+
+/**
+ * @brief Transport whose processes exchange frames through lock-free rings in shared memory.
+ *
+ * `mesh()` maps one anonymous shared region, holding a single-producer
+ * single-consumer byte ring for every ordered pair of processes, before the
+ * processes are forked; process `i` keeps element `i` of the result. Waiting
+ * processes spin and yield rather than sleep, so the transport suits groups
+ * no larger than the number of cores. It cannot notice a process that exits
+ * without finishing an exchange; its peers then wait forever.
+ */
+struct shm_transport: transport {
+    // the rings are used by several processes, so they must not hide a lock
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    /**
+     * @brief Creates the @p n endpoints of a group, with rings of @p capacity bytes.
+     *
+     * Frames larger than a ring pass through it in parts.
+     *
+     * @throws std::runtime_error If @p capacity is zero, or the region cannot be mapped.
+     */
+    static std::vector<shm_transport> mesh(std::size_t n, std::size_t capacity = 1 << 16) {
+        if (capacity == 0)
+            throw std::runtime_error("shared-memory ring capacity must be positive");
+
+        // every ring is its indices followed by its bytes, at a cache line boundary
+        auto stride = (sizeof(ring) + capacity + alignof(ring) - 1) / alignof(ring) * alignof(ring);
+        auto length = std::max<std::size_t>(n * n * stride, 1);
+
+        auto p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::runtime_error("shared-memory transport: cannot map the rings");
+
+        std::shared_ptr<std::byte> region{
+            static_cast<std::byte *>(p),
+            [length](std::byte *q) { ::munmap(q, length); }};
+
+        for (std::size_t i = 0; i < n * n; ++i)
+            new (region.get() + i * stride) ring{};
+
+        std::vector<shm_transport> endpoints;
+        for (std::size_t i = 0; i < n; ++i)
+            endpoints.push_back(shm_transport{region, i, n, capacity, stride});
+
+        return endpoints;
+    }
+
+    shm_transport(shm_transport &&) = default;
+    shm_transport &operator=(shm_transport &&) = default;
+
+    std::size_t rank() const noexcept override {
+        return rank_;
+    }
+
+    std::size_t size() const noexcept override {
+        return size_;
+    }
+
+protected:
+    std::size_t write_some_(std::size_t peer, std::byte const *p, std::size_t n) override {
+        auto &r = ring_(rank_, peer);
+        auto tail = r.tail.load(std::memory_order_relaxed);
+        auto head = r.head.load(std::memory_order_acquire);
+
+        auto k = std::min<std::size_t>(n, capacity_ - (tail - head));
+        copy_(r, tail, [&](std::byte *q, std::size_t offset, std::size_t m) {
+            std::memcpy(q, p + offset, m);
+        }, k);
+
+        r.tail.store(tail + k, std::memory_order_release);
+        return k;
+    }
+
+    std::size_t read_some_(std::size_t peer, std::byte *p, std::size_t n) override {
+        auto &r = ring_(peer, rank_);
+        auto head = r.head.load(std::memory_order_relaxed);
+        auto tail = r.tail.load(std::memory_order_acquire);
+
+        auto k = std::min<std::size_t>(n, tail - head);
+        copy_(r, head, [&](std::byte *q, std::size_t offset, std::size_t m) {
+            std::memcpy(p + offset, q, m);
+        }, k);
+
+        r.head.store(head + k, std::memory_order_release);
+        return k;
+    }
+
+    void wait_(std::vector<std::size_t> const &, std::vector<std::size_t> const &) override {
+        std::this_thread::yield();
+    }
+
+private:
+    struct ring {
+        // bytes read and written so far, by the reader and the writer
+        alignas(64) std::atomic<std::uint64_t> head = 0;
+        alignas(64) std::atomic<std::uint64_t> tail = 0;
+    };
+
+    shm_transport(std::shared_ptr<std::byte> region, std::size_t rank, std::size_t size, std::size_t capacity, std::size_t stride):
+        region_{std::move(region)}, rank_{rank}, size_{size}, capacity_{capacity}, stride_{stride} {
+    }
+
+    // ring carrying bytes from from to to
+    ring &ring_(std::size_t from, std::size_t to) const noexcept {
+        return *std::launder(reinterpret_cast<ring *>(region_.get() + (from * size_ + to) * stride_));
+    }
+
+    // calls f(bytes, offset, m) on the k bytes of r from position in at most two parts
+    template <typename F>
+    void copy_(ring &r, std::uint64_t position, F f, std::size_t k) const {
+        auto bytes = reinterpret_cast<std::byte *>(&r) + sizeof(ring);
+        auto begin = static_cast<std::size_t>(position % capacity_);
+        auto first = std::min(k, capacity_ - begin);
+
+        f(bytes + begin, 0, first);
+        if (first < k)
+            f(bytes, first, k - first);
+    }
+
+    std::shared_ptr<std::byte> region_;
+    std::size_t rank_;
+    std::size_t size_;
+    std::size_t capacity_;
+    std::size_t stride_;
+};
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#else
+
+#define CXXDES_HAS_SHM_TRANSPORT 0
+
+#endif
+
+#endif /* CXXDES_PARALLEL_SHM_TRANSPORT_HPP_INCLUDED */
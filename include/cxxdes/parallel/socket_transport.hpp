@@ -0,0 +1,305 @@
+/**
+ * @file socket_transport.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Transport over Unix-domain stream sockets.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_SOCKET_TRANSPORT_HPP_INCLUDED
+#define CXXDES_PARALLEL_SOCKET_TRANSPORT_HPP_INCLUDED
+
+#include <cxxdes/parallel/transport.hpp>
+
+// socket_transport needs POSIX sockets
+#if __has_include(<sys/socket.h>) && __has_include(<sys/un.h>) && __has_include(<poll.h>) && __has_include(<unistd.h>)
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <utility>
+
+#define CXXDES_HAS_SOCKET_TRANSPORT 1
+
+namespace cxxdes {
+namespace parallel {
+
+/**
+ * @brief Transport whose processes are connected pairwise by Unix-domain stream sockets.
+ *
+ * `mesh()` creates the endpoints of a group in one process, to be shared
+ * with forked processes, each of which keeps its own endpoint. `connect()`
+ * instead joins a group of independently started processes on one host,
+ * which find each other through socket files. A process that exits closes
+ * its sockets, and the exchanges of its peers then throw.
+ */
+struct socket_transport: transport {
+    /**
+     * @brief Creates the @p n endpoints of a group connected by socket pairs.
+     *
+     * Process `i` uses element `i` of the result, usually after `fork()`, and
+     * should destroy the others.
+     *
+     * @throws std::runtime_error If the sockets cannot be created.
+     */
+    static std::vector<socket_transport> mesh(std::size_t n) {
+        std::vector<socket_transport> endpoints;
+        for (std::size_t i = 0; i < n; ++i)
+            endpoints.push_back(socket_transport{i, n});
+
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = i + 1; k < n; ++k) {
+                int fds[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+                    fail_("socketpair");
+
+                endpoints[i].fds_[k] = fds[0];
+                endpoints[k].fds_[i] = fds[1];
+            }
+        }
+
+        return endpoints;
+    }
+
+    /**
+     * @brief Joins the group of @p size processes whose sockets are named @p prefix followed by their rank.
+     *
+     * Every process listens on its own socket file, connects to the processes
+     * of lower rank, and accepts the processes of higher rank; it waits up to
+     * @p timeout for the others to start. The socket files are removed once
+     * the group is connected.
+     *
+     * @throws std::runtime_error If @p rank is not less than @p size, a path
+     *         is too long, or the group does not connect in time.
+     */
+    static socket_transport connect(
+        std::string const &prefix,
+        std::size_t rank,
+        std::size_t size,
+        std::chrono::milliseconds timeout = std::chrono::seconds{30}) {
+        if (rank >= size)
+            throw std::runtime_error("socket transport rank out of range");
+
+        socket_transport t{rank, size};
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        auto own = address_(prefix, rank);
+        ::unlink(own.sun_path);
+
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0)
+            fail_("socket");
+
+        // the listener is closed and its file removed however this ends
+        struct cleanup {
+            int fd;
+            char const *path;
+            ~cleanup() {
+                ::close(fd);
+                ::unlink(path);
+            }
+        } guard{listener, own.sun_path};
+
+        if (::bind(listener, reinterpret_cast<::sockaddr const *>(&own), sizeof(own)) != 0)
+            fail_("bind");
+
+        if (::listen(listener, static_cast<int>(size)) != 0)
+            fail_("listen");
+
+        for (std::size_t p = 0; p < rank; ++p) {
+            auto peer = address_(prefix, p);
+
+            while (true) {
+                int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (fd < 0)
+                    fail_("socket");
+
+                if (::connect(fd, reinterpret_cast<::sockaddr const *>(&peer), sizeof(peer)) == 0) {
+                    t.fds_[p] = fd;
+                    break;
+                }
+
+                auto error = errno;
+                ::close(fd);
+
+                // the peer has not started listening yet
+                if ((error != ENOENT && error != ECONNREFUSED) || std::chrono::steady_clock::now() > deadline) {
+                    errno = error;
+                    fail_("connect");
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+
+            std::uint64_t r = rank;
+            t.send_all_(p, &r, sizeof(r));
+        }
+
+        for (std::size_t accepted = rank + 1; accepted < size; ++accepted) {
+            ::pollfd pfd{listener, POLLIN, 0};
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0 || ::poll(&pfd, 1, static_cast<int>(left.count())) <= 0)
+                throw std::runtime_error("socket transport: peers did not connect in time");
+
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0)
+                fail_("accept");
+
+            std::uint64_t r = 0;
+            socket_transport unknown{0, 1};
+            unknown.fds_[0] = fd;
+            unknown.recv_all_(0, &r, sizeof(r));
+
+            if (r <= rank || r >= size || t.fds_[r] >= 0)
+                throw std::runtime_error("socket transport: unexpected peer rank");
+
+            t.fds_[r] = std::exchange(unknown.fds_[0], -1);
+        }
+
+        return t;
+    }
+
+    socket_transport(socket_transport &&other) noexcept:
+        rank_{other.rank_}, fds_{std::move(other.fds_)} {
+        other.fds_.clear();
+    }
+
+    socket_transport &operator=(socket_transport &&other) noexcept {
+        if (this != &other) {
+            close_();
+            rank_ = other.rank_;
+            fds_ = std::move(other.fds_);
+            other.fds_.clear();
+        }
+        return *this;
+    }
+
+    std::size_t rank() const noexcept override {
+        return rank_;
+    }
+
+    std::size_t size() const noexcept override {
+        return fds_.size();
+    }
+
+    ~socket_transport() {
+        close_();
+    }
+
+protected:
+    std::size_t write_some_(std::size_t peer, std::byte const *p, std::size_t n) override {
+        auto r = ::send(fds_[peer], p, n, MSG_DONTWAIT | no_signal_);
+        if (r >= 0)
+            return static_cast<std::size_t>(r);
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+
+        fail_("send");
+    }
+
+    std::size_t read_some_(std::size_t peer, std::byte *p, std::size_t n) override {
+        auto r = ::recv(fds_[peer], p, n, MSG_DONTWAIT);
+        if (r > 0)
+            return static_cast<std::size_t>(r);
+
+        if (r == 0)
+            throw std::runtime_error("socket transport: peer " + std::to_string(peer) + " closed the connection");
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+
+        fail_("recv");
+    }
+
+    void wait_(std::vector<std::size_t> const &writing, std::vector<std::size_t> const &reading) override {
+        std::vector<::pollfd> pfds;
+        for (auto p: writing)
+            pfds.push_back(::pollfd{fds_[p], POLLOUT, 0});
+        for (auto p: reading)
+            pfds.push_back(::pollfd{fds_[p], POLLIN, 0});
+
+        if (::poll(pfds.data(), pfds.size(), -1) < 0 && errno != EINTR)
+            fail_("poll");
+    }
+
+private:
+#ifdef MSG_NOSIGNAL
+    // a closed peer makes send() fail instead of raising SIGPIPE
+    static constexpr int no_signal_ = MSG_NOSIGNAL;
+#else
+    static constexpr int no_signal_ = 0;
+#endif
+
+    socket_transport(std::size_t rank, std::size_t size): rank_{rank}, fds_(size, -1) {
+    }
+
+    [[noreturn]]
+    static void fail_(char const *what) {
+        throw std::runtime_error(std::string{"socket transport: "} + what + " failed: " + std::strerror(errno));
+    }
+
+    static ::sockaddr_un address_(std::string const &prefix, std::size_t rank) {
+        ::sockaddr_un a{};
+        a.sun_family = AF_UNIX;
+
+        auto path = prefix + std::to_string(rank);
+        if (path.size() >= sizeof(a.sun_path))
+            throw std::runtime_error("socket transport: path too long: " + path);
+
+        std::memcpy(a.sun_path, path.c_str(), path.size() + 1);
+        return a;
+    }
+
+    void send_all_(std::size_t peer, void const *p, std::size_t n) {
+        auto bytes = static_cast<std::byte const *>(p);
+        while (n > 0) {
+            auto k = write_some_(peer, bytes, n);
+            if (k == 0)
+                wait_({ peer }, {});
+            bytes += k;
+            n -= k;
+        }
+    }
+
+    void recv_all_(std::size_t peer, void *p, std::size_t n) {
+        auto bytes = static_cast<std::byte *>(p);
+        while (n > 0) {
+            auto k = read_some_(peer, bytes, n);
+            if (k == 0)
+                wait_({}, { peer });
+            bytes += k;
+            n -= k;
+        }
+    }
+
+    void close_() noexcept {
+        for (auto fd: fds_)
+            if (fd >= 0)
+                ::close(fd);
+        fds_.clear();
+    }
+
+    std::size_t rank_;
+    std::vector<int> fds_;
+};
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#else
+
+#define CXXDES_HAS_SOCKET_TRANSPORT 0
+
+#endif
+
+#endif /* CXXDES_PARALLEL_SOCKET_TRANSPORT_HPP_INCLUDED */
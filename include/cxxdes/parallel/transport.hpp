@@ -0,0 +1,148 @@
+/**
+ * @file transport.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief All-to-all frame exchange between the processes of a distributed simulation.
+ * @date 2026-10-19
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_PARALLEL_TRANSPORT_HPP_INCLUDED
+#define CXXDES_PARALLEL_TRANSPORT_HPP_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace parallel {
+
+/** @brief Bytes sent to or received from one process in one exchange. */
+using frame = std::vector<std::byte>;
+
+/**
+ * @brief Endpoint of one process in a group of `size()` processes ranked from zero.
+ *
+ * The only operation is `exchange()`, in which every process sends one frame
+ * to every other process and receives one frame from each. Frames are sent
+ * with their length and are interleaved with the frames being received, so
+ * an exchange never deadlocks on full buffers, whatever the frame sizes.
+ *
+ * Implementations provide non-blocking reads and writes of a byte stream to
+ * each peer, and a way to wait until one may make progress.
+ */
+struct transport {
+    transport() = default;
+
+    CXXDES_NOT_COPIABLE(transport)
+
+    transport(transport &&) = default;
+    transport &operator=(transport &&) = default;
+
+    /** @brief Returns the rank of this process. */
+    virtual std::size_t rank() const noexcept = 0;
+
+    /** @brief Returns the number of processes. */
+    virtual std::size_t size() const noexcept = 0;
+
+    /**
+     * @brief Sends `out[p]` to every other process `p` and returns the frame each one sent.
+     *
+     * Every process of the group must call it the same number of times. The
+     * frame at the rank of this process is neither sent nor received.
+     *
+     * @throws std::runtime_error If `out` does not have one frame per process, or the transport fails.
+     */
+    std::vector<frame> exchange(std::vector<frame> const &out) {
+        auto n = size();
+        if (out.size() != n)
+            throw std::runtime_error("exchange needs one frame per process");
+
+        // every frame is preceded by its length
+        struct stream {
+            std::uint64_t length = 0;
+            std::size_t done = 0;
+        };
+
+        std::vector<frame> in(n);
+        std::vector<stream> sending(n), receiving(n);
+        std::vector<std::size_t> writing, reading;
+
+        for (std::size_t p = 0; p < n; ++p) {
+            if (p == rank())
+                continue;
+
+            sending[p].length = out[p].size();
+            writing.push_back(p);
+            reading.push_back(p);
+        }
+
+        constexpr std::size_t prefix = sizeof(std::uint64_t);
+
+        while (!writing.empty() || !reading.empty()) {
+            bool progressed = false;
+
+            std::erase_if(writing, [&](std::size_t p) {
+                auto &s = sending[p];
+                auto total = prefix + s.length;
+
+                std::size_t k = s.done < prefix ?
+                    write_some_(p, reinterpret_cast<std::byte const *>(&s.length) + s.done, prefix - s.done) :
+                    write_some_(p, out[p].data() + (s.done - prefix), total - s.done);
+
+                s.done += k;
+                progressed |= k > 0;
+                return s.done == total;
+            });
+
+            std::erase_if(reading, [&](std::size_t p) {
+                auto &s = receiving[p];
+
+                if (s.done < prefix) {
+                    auto k = read_some_(p, reinterpret_cast<std::byte *>(&s.length) + s.done, prefix - s.done);
+                    s.done += k;
+                    progressed |= k > 0;
+
+                    if (s.done < prefix)
+                        return false;
+
+                    in[p].resize(s.length);
+                }
+
+                auto total = prefix + s.length;
+                if (s.done < total) {
+                    auto k = read_some_(p, in[p].data() + (s.done - prefix), total - s.done);
+                    s.done += k;
+                    progressed |= k > 0;
+                }
+
+                return s.done == total;
+            });
+
+            if (!progressed && (!writing.empty() || !reading.empty()))
+                wait_(writing, reading);
+        }
+
+        return in;
+    }
+
+    virtual ~transport() = default;
+
+protected:
+    // writes up to n bytes to peer without blocking; returns how many it wrote
+    virtual std::size_t write_some_(std::size_t peer, std::byte const *p, std::size_t n) = 0;
+
+    // reads up to n bytes from peer without blocking; returns how many it read
+    virtual std::size_t read_some_(std::size_t peer, std::byte *p, std::size_t n) = 0;
+
+    // blocks until a write to a peer in writing or a read from a peer in reading may progress
+    virtual void wait_(std::vector<std::size_t> const &writing, std::vector<std::size_t> const &reading) = 0;
+};
+
+} /* namespace parallel */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_PARALLEL_TRANSPORT_HPP_INCLUDED */
@@ -0,0 +1,59 @@
+/**
+ * @file analytic.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Closed-form results of the M/M/c queue.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_ANALYTIC_HPP_INCLUDED
+#define CXXDES_QUEUEING_ANALYTIC_HPP_INCLUDED
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace cxxdes {
+namespace queueing {
+
+/**
+ * @brief Returns the probability that a job waits in an M/M/c queue (Erlang C).
+ *
+ * @param servers Number of servers, `c`.
+ * @param load Offered load `lambda / mu`.
+ * @throws std::runtime_error If the queue is not stable, that is, if
+ *         @p load is not less than @p servers.
+ */
+inline double erlang_c(std::size_t servers, double load) {
+    auto c = static_cast<double>(servers);
+    if (servers == 0 || !(load >= 0) || load >= c)
+        throw std::runtime_error("erlang_c needs load < servers");
+
+    // Erlang B by its recurrence, then Erlang C from Erlang B
+    double b = 1;
+    for (std::size_t k = 1; k <= servers; ++k)
+        b = load * b / (static_cast<double>(k) + load * b);
+
+    return c * b / (c - load * (1 - b));
+}
+
+/** @brief Returns the mean waiting time before service in an M/M/c queue. */
+inline double mmc_waiting_time(double lambda, double mu, std::size_t servers) {
+    return erlang_c(servers, lambda / mu) / (static_cast<double>(servers) * mu - lambda);
+}
+
+/** @brief Returns the mean sojourn time, waiting and service, in an M/M/c queue. */
+inline double mmc_sojourn_time(double lambda, double mu, std::size_t servers) {
+    return mmc_waiting_time(lambda, mu, servers) + 1 / mu;
+}
+
+/** @brief Returns the mean number of jobs in an M/M/c queue. */
+inline double mmc_in_system(double lambda, double mu, std::size_t servers) {
+    return lambda * mmc_sojourn_time(lambda, mu, servers);
+}
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_ANALYTIC_HPP_INCLUDED */
@@ -0,0 +1,174 @@
+/**
+ * @file job.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Job descriptors, a job pool, and the node interface of queueing networks.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_JOB_HPP_INCLUDED
+#define CXXDES_QUEUEING_JOB_HPP_INCLUDED
+
+#include <deque>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+
+namespace cxxdes {
+namespace queueing {
+
+/**
+ * @brief Descriptor of a job travelling through a queueing network.
+ *
+ * Nodes only pass pointers to descriptors around; the payload itself stays
+ * wherever `payload` points to, and is never copied.
+ */
+struct job {
+    /** @brief Sequence number assigned by the pool. */
+    std::uint64_t id = 0;
+
+    /** @brief Job class, set by the source. */
+    std::size_t cls = 0;
+
+    /** @brief Priority, set by the source; lower values are served first. */
+    int priority = 0;
+
+    /** @brief Time the job entered the network. */
+    cxxdes::core::time_integral created = 0;
+
+    /** @brief Time the job arrived at its current station. */
+    cxxdes::core::time_integral arrived = 0;
+
+    /** @brief Service demand at the current station, in ticks. */
+    cxxdes::core::time_integral service = 0;
+
+    /** @brief Number of stations that completed the job so far. */
+    std::uint32_t visits = 0;
+
+    /** @brief User tag; the network does not touch it. */
+    std::uint64_t tag = 0;
+
+    /** @brief User payload; the network does not touch or copy it. */
+    void *payload = nullptr;
+};
+
+/**
+ * @brief Pool recycling job descriptors.
+ *
+ * Descriptors are allocated in chunks and never freed before the pool, so a
+ * steady-state simulation does not allocate per job. Pointers returned by
+ * `acquire()` stay valid until they are given back with `release()`.
+ */
+struct job_pool {
+    job_pool() = default;
+
+    CXXDES_NOT_COPIABLE(job_pool)
+    CXXDES_NOT_MOVABLE(job_pool)
+
+    /** @brief Returns a reset descriptor. */
+    [[nodiscard]]
+    job *acquire() {
+        job *j;
+        if (free_.empty()) {
+            j = &storage_.emplace_back();
+        }
+        else {
+            j = free_.back();
+            free_.pop_back();
+            *j = job{};
+        }
+
+        j->id = next_id_++;
+
+        ++live_;
+        return j;
+    }
+
+    /** @brief Gives @p j back to the pool. */
+    void release(job *j) {
+        free_.push_back(j);
+        --live_;
+    }
+
+    /** @brief Returns the number of acquired descriptors not released yet. */
+    std::size_t live() const noexcept {
+        return live_;
+    }
+
+    /** @brief Returns the number of descriptors allocated so far. */
+    std::size_t allocated() const noexcept {
+        return storage_.size();
+    }
+
+private:
+    std::deque<job> storage_;
+    std::vector<job *> free_;
+    std::uint64_t next_id_ = 0;
+    std::size_t live_ = 0;
+};
+
+/**
+ * @brief Element of a queueing network that jobs are handed to.
+ *
+ * `accept()` is called synchronously, from the event that moved the job; a
+ * node that holds the job for some time schedules its own event.
+ */
+struct node {
+    /** @brief Takes over @p j. */
+    virtual void accept(job *j) = 0;
+
+    virtual ~node() = default;
+};
+
+/** @brief Exponentially distributed samples, in model units. */
+struct exponential {
+    /** @brief Constructs a sampler with the given @p rate per model unit. */
+    explicit exponential(double rate, std::uint64_t seed = 1):
+        rng_{seed}, dist_{rate} {
+        if (!(rate > 0))
+            throw std::runtime_error("exponential rate must be positive");
+    }
+
+    /** @brief Returns the next sample. */
+    double operator()() {
+        return dist_(rng_);
+    }
+
+private:
+    std::mt19937_64 rng_;
+    std::exponential_distribution<double> dist_;
+};
+
+/** @brief Constant samples, in model units. */
+struct deterministic {
+    /** @brief Constructs a sampler that always returns @p value. */
+    explicit deterministic(double value): value_{value} {
+    }
+
+    /** @brief Returns the value. */
+    double operator()() const noexcept {
+        return value_;
+    }
+
+private:
+    double value_;
+};
+
+namespace detail {
+
+// converts ticks to model units of env
+inline double to_units(cxxdes::core::environment const &env, cxxdes::core::time_integral ticks) noexcept {
+    return static_cast<double>(ticks) / static_cast<double>(env.real_to_sim(1));
+}
+
+} /* namespace detail */
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_JOB_HPP_INCLUDED */
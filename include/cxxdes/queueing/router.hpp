@@ -0,0 +1,134 @@
+/**
+ * @file router.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Probabilistic, join-the-shortest-queue, and power-of-two-choices routers.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_ROUTER_HPP_INCLUDED
+#define CXXDES_QUEUEING_ROUTER_HPP_INCLUDED
+
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <cxxdes/queueing/job.hpp>
+#include <cxxdes/queueing/station.hpp>
+
+namespace cxxdes {
+namespace queueing {
+
+/**
+ * @brief Sends each job to one of its targets, picked at random with fixed weights.
+ *
+ * @throws std::runtime_error From the constructor if there are no targets, or
+ *         not one non-negative weight per target.
+ */
+struct probabilistic_router: node {
+    /** @brief Constructs a router picking `targets[i]` with probability proportional to `weights[i]`. */
+    probabilistic_router(std::vector<node *> targets, std::vector<double> const &weights, std::uint64_t seed = 1):
+        targets_{std::move(targets)}, rng_{seed} {
+        if (targets_.empty() || weights.size() != targets_.size())
+            throw std::runtime_error("probabilistic_router needs one weight per target");
+
+        for (auto w: weights) {
+            if (w < 0)
+                throw std::runtime_error("probabilistic_router weights must be non-negative");
+        }
+
+        pick_ = std::discrete_distribution<std::size_t>{weights.begin(), weights.end()};
+    }
+
+    void accept(job *j) override {
+        targets_[pick_(rng_)]->accept(j);
+    }
+
+private:
+    std::vector<node *> targets_;
+    std::mt19937_64 rng_;
+    std::discrete_distribution<std::size_t> pick_;
+};
+
+/**
+ * @brief Sends each job to the station with the fewest jobs, breaking ties at random.
+ *
+ * @throws std::runtime_error From the constructor if there are no targets.
+ */
+struct jsq_router: node {
+    /** @brief Constructs a router over @p targets. */
+    explicit jsq_router(std::vector<station *> targets, std::uint64_t seed = 1):
+        targets_{std::move(targets)}, rng_{seed} {
+        if (targets_.empty())
+            throw std::runtime_error("jsq_router needs at least one target");
+    }
+
+    void accept(job *j) override {
+        station *best = nullptr;
+        std::size_t ties = 0;
+
+        for (auto s: targets_) {
+            if (!best || s->in_system() < best->in_system()) {
+                best = s;
+                ties = 1;
+            }
+            else if (s->in_system() == best->in_system()) {
+                // keeps each of the tied stations with equal probability
+                if (std::uniform_int_distribution<std::size_t>{0, ties++}(rng_) == 0)
+                    best = s;
+            }
+        }
+
+        best->accept(j);
+    }
+
+private:
+    std::vector<station *> targets_;
+    std::mt19937_64 rng_;
+};
+
+/**
+ * @brief Samples two distinct stations for each job and sends it to the one with fewer jobs.
+ *
+ * Compared to `jsq_router`, it looks at two stations instead of all of them,
+ * and still avoids most of the queueing of random routing.
+ *
+ * @throws std::runtime_error From the constructor if there are no targets.
+ */
+struct power_of_two_router: node {
+    /** @brief Constructs a router over @p targets. */
+    explicit power_of_two_router(std::vector<station *> targets, std::uint64_t seed = 1):
+        targets_{std::move(targets)}, rng_{seed} {
+        if (targets_.empty())
+            throw std::runtime_error("power_of_two_router needs at least one target");
+    }
+
+    void accept(job *j) override {
+        auto n = targets_.size();
+        if (n == 1) {
+            targets_[0]->accept(j);
+            return ;
+        }
+
+        auto a = std::uniform_int_distribution<std::size_t>{0, n - 1}(rng_);
+        auto b = std::uniform_int_distribution<std::size_t>{0, n - 2}(rng_);
+        if (b >= a)
+            ++b;
+
+        auto x = targets_[a];
+        auto y = targets_[b];
+        (y->in_system() < x->in_system() ? y : x)->accept(j);
+    }
+
+private:
+    std::vector<station *> targets_;
+    std::mt19937_64 rng_;
+};
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_ROUTER_HPP_INCLUDED */
@@ -0,0 +1,89 @@
+/**
+ * @file sink.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Sink recording the sojourn times of the jobs leaving a queueing network.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_SINK_HPP_INCLUDED
+#define CXXDES_QUEUEING_SINK_HPP_INCLUDED
+
+#include <cstdint>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/stats/tally.hpp>
+#include <cxxdes/queueing/job.hpp>
+
+namespace cxxdes {
+namespace queueing {
+
+/**
+ * @brief Gives jobs back to their pool and records their sojourn times.
+ *
+ * The sojourn time of a job is the time from its creation to its arrival at
+ * the sink, in model units. The statistics are updated in constant time and
+ * space per job.
+ */
+struct sink: node {
+    /** @brief Constructs a sink releasing jobs to @p pool. */
+    sink(cxxdes::core::environment &env, job_pool &pool): env_{&env}, pool_{&pool} {
+    }
+
+    void accept(job *j) override {
+        auto x = detail::to_units(*env_, env_->now() - j->created);
+        pool_->release(j);
+        sojourn_.add(x);
+    }
+
+    /** @brief Returns the sojourn times recorded so far. */
+    stats::tally const &sojourn() const noexcept {
+        return sojourn_;
+    }
+
+    /** @brief Returns the number of jobs recorded. */
+    std::uint64_t count() const noexcept {
+        return sojourn_.count();
+    }
+
+    /** @brief Returns the mean sojourn time, or zero without jobs. */
+    double mean() const noexcept {
+        return sojourn_.mean();
+    }
+
+    /** @brief Returns the sample variance of the sojourn times, or zero with fewer than two jobs. */
+    double variance() const noexcept {
+        return sojourn_.variance();
+    }
+
+    /** @brief Returns the sample standard deviation of the sojourn times. */
+    double stddev() const noexcept {
+        return sojourn_.stddev();
+    }
+
+    /** @brief Returns the shortest sojourn time, or infinity without jobs. */
+    double min() const noexcept {
+        return sojourn_.min();
+    }
+
+    /** @brief Returns the longest sojourn time, or minus infinity without jobs. */
+    double max() const noexcept {
+        return sojourn_.max();
+    }
+
+    /** @brief Forgets the jobs recorded so far, for instance after a warm-up period. */
+    void reset_statistics() noexcept {
+        sojourn_.reset();
+    }
+
+private:
+    cxxdes::core::environment *env_;
+    job_pool *pool_;
+    stats::tally sojourn_;
+};
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_SINK_HPP_INCLUDED */
@@ -0,0 +1,99 @@
+/**
+ * @file source.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Poisson, Markov-modulated Poisson, and trace-driven job sources.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_SOURCE_HPP_INCLUDED
+#define CXXDES_QUEUEING_SOURCE_HPP_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sources/generators.hpp>
+#include <cxxdes/queueing/job.hpp>
+
+namespace cxxdes {
+namespace queueing {
+
+namespace detail {
+
+/**
+ * @brief Arrival-process generator that creates a job at each arrival.
+ *
+ * The job is taken from a pool, stamped with its creation time, class, and
+ * priority, and handed to the target node.
+ */
+template <typename Generator>
+struct job_source: Generator {
+    /** @brief Sets the class and the priority of the jobs created from now on. */
+    void classify(std::size_t cls, int priority = 0) noexcept {
+        cls_ = cls;
+        priority_ = priority;
+    }
+
+protected:
+    template <typename ...Args>
+    job_source(job_pool &pool, node &target, cxxdes::core::environment &env, Args && ...args):
+        Generator{env, std::forward<Args>(args)...}, pool_{&pool}, target_{&target} {
+        this->on_arrival([this] { arrive_(); });
+    }
+
+private:
+    void arrive_() {
+        auto j = pool_->acquire();
+        j->cls = cls_;
+        j->priority = priority_;
+        j->created = this->env().now();
+        j->arrived = j->created;
+        target_->accept(j);
+    }
+
+    job_pool *pool_;
+    node *target_;
+    std::size_t cls_ = 0;
+    int priority_ = 0;
+};
+
+} /* namespace detail */
+
+/** @brief Source whose interarrival times are exponential with a fixed rate. */
+struct poisson_source: detail::job_source<sources::poisson> {
+    /** @brief Constructs a source of @p rate jobs per model unit feeding @p target. */
+    poisson_source(
+        cxxdes::core::environment &env, job_pool &pool, node &target,
+        double rate, std::uint64_t seed = 1):
+        job_source{pool, target, env, rate, seed} {
+    }
+};
+
+/** @brief Markov-modulated Poisson source; see `sources::mmpp`. */
+struct mmpp_source: detail::job_source<sources::mmpp> {
+    /** @brief Constructs a source starting in state @p initial. */
+    mmpp_source(
+        cxxdes::core::environment &env, job_pool &pool, node &target,
+        std::vector<double> rates, std::vector<std::vector<double>> switching,
+        std::size_t initial = 0, std::uint64_t seed = 1):
+        job_source{pool, target, env, std::move(rates), std::move(switching), initial, seed} {
+    }
+};
+
+/** @brief Source replaying a nondecreasing list of arrival times, in model units. */
+struct trace_source: detail::job_source<sources::trace> {
+    /** @brief Constructs a source creating one job at each of @p times. */
+    trace_source(
+        cxxdes::core::environment &env, job_pool &pool, node &target,
+        std::vector<double> times):
+        job_source{pool, target, env, std::move(times)} {
+    }
+};
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_SOURCE_HPP_INCLUDED */
@@ -0,0 +1,410 @@
+/**
+ * @file station.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Multi-server stations with FIFO, LIFO, processor-sharing, and priority disciplines.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_QUEUEING_STATION_HPP_INCLUDED
+#define CXXDES_QUEUEING_STATION_HPP_INCLUDED
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/stats/time_weighted.hpp>
+#include <cxxdes/queueing/job.hpp>
+
+namespace cxxdes {
+namespace queueing {
+
+/** @brief Order in which a station serves its jobs. */
+enum class discipline {
+    /** @brief First come, first served. */
+    fifo,
+
+    /** @brief Last come, first served, without preemption. */
+    lifo,
+
+    /** @brief All jobs share the servers equally; each gets at most one server. */
+    processor_sharing,
+
+    /** @brief Lowest `job::priority` first, FIFO among equals, without preemption. */
+    priority
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Station with `servers` identical servers and an unbounded queue.
+ *
+ * The service demand of a job is sampled when it arrives, by calling the
+ * service sampler with the job, or without arguments. A station schedules a
+ * single event per job, at its departure, and then hands the job to the node
+ * it is connected to. Under processor sharing, an arrival moves the departure
+ * of the job that finishes first, and the superseded event is ignored when it
+ * fires.
+ */
+struct station: node {
+    /**
+     * @brief Constructs a station.
+     *
+     * @param service Callable returning service demands in model units, taking
+     *        `job const &` or nothing.
+     * @throws std::runtime_error If @p servers is zero.
+     */
+    template <typename Service>
+    station(environment &env, std::size_t servers, Service service, discipline d = discipline::fifo):
+        env_{&env}, servers_{servers}, discipline_{d}, jobs_{env}, busy_servers_{env} {
+        if (servers == 0)
+            throw std::runtime_error("station needs at least one server");
+
+        if constexpr (std::invocable<Service &, job const &>)
+            service_ = std::move(service);
+        else
+            service_ = [service = std::move(service)](job const &) mutable { return service(); };
+
+        if (d == discipline::processor_sharing) {
+            ps_handler_ = new departure_handler{this, ps_server};
+        }
+        else {
+            current_.assign(servers, nullptr);
+            for (std::size_t k = 0; k < servers; ++k)
+                handlers_.push_back(new departure_handler{this, k});
+
+            // server 0 is taken first
+            for (std::size_t k = servers; k-- > 0;)
+                idle_.push_back(k);
+        }
+    }
+
+    CXXDES_NOT_COPIABLE(station)
+    CXXDES_NOT_MOVABLE(station)
+
+    /** @brief Sends finished jobs to @p next. */
+    void connect(node &next) noexcept {
+        next_ = &next;
+    }
+
+    /** @throws std::runtime_error If the station is not connected. */
+    void accept(job *j) override {
+        if (!next_)
+            throw std::runtime_error("station is not connected");
+
+        j->arrived = env_->now();
+        j->service = std::max<time_integral>(env_->real_to_sim(service_(*j)), 0);
+        ++arrivals_;
+        ++in_system_;
+
+        admit_(j);
+        record_();
+    }
+
+    /** @brief Returns the number of servers. */
+    std::size_t servers() const noexcept {
+        return servers_;
+    }
+
+    /** @brief Returns the number of jobs at the station, waiting or in service. */
+    std::size_t in_system() const noexcept {
+        return in_system_;
+    }
+
+    /** @brief Returns the number of jobs not holding a server. */
+    std::size_t waiting() const noexcept {
+        return in_system_ - busy_();
+    }
+
+    /** @brief Returns the number of jobs that arrived since the statistics were reset. */
+    std::uint64_t arrivals() const noexcept {
+        return arrivals_;
+    }
+
+    /** @brief Returns the number of jobs that departed since the statistics were reset. */
+    std::uint64_t departures() const noexcept {
+        return departures_;
+    }
+
+    /** @brief Returns the time-average number of jobs at the station since the statistics were reset. */
+    double mean_in_system() const noexcept {
+        return jobs_.mean();
+    }
+
+    /** @brief Returns the time-average fraction of busy servers since the statistics were reset. */
+    double utilization() const noexcept {
+        return busy_servers_.mean() / static_cast<double>(servers_);
+    }
+
+    /** @brief Returns the number of jobs at the station over time, since the statistics were reset. */
+    stats::time_weighted const &jobs() const noexcept {
+        return jobs_;
+    }
+
+    /** @brief Returns the number of busy servers over time, since the statistics were reset. */
+    stats::time_weighted const &busy_servers() const noexcept {
+        return busy_servers_;
+    }
+
+    /** @brief Restarts the counters and the time averages, for instance after a warm-up period. */
+    void reset_statistics() noexcept {
+        arrivals_ = 0;
+        departures_ = 0;
+        jobs_.reset();
+        busy_servers_.reset();
+    }
+
+    ~station() {
+        for (auto &h: handlers_)
+            h->s = nullptr;
+
+        if (ps_handler_)
+            ps_handler_->s = nullptr;
+    }
+
+private:
+    static constexpr std::size_t ps_server = std::numeric_limits<std::size_t>::max();
+
+    struct departure_handler: token_handler {
+        station *s;
+        std::size_t k;
+
+        departure_handler(station *s_, std::size_t k_): s{s_}, k{k_} {
+        }
+
+        void invoke(token *) override {
+            if (!s)
+                return ;
+
+            if (k == ps_server)
+                s->ps_depart_();
+            else
+                s->depart_(k);
+        }
+    };
+
+    struct prio_entry {
+        int priority;
+        std::uint64_t seq;
+        job *j;
+    };
+
+    struct prio_later {
+        bool operator()(prio_entry const &a, prio_entry const &b) const noexcept {
+            return a.priority != b.priority ? a.priority > b.priority : a.seq > b.seq;
+        }
+    };
+
+    struct ps_entry {
+        // virtual time at which the job completes
+        double finish;
+        std::uint64_t seq;
+        job *j;
+    };
+
+    struct ps_later {
+        bool operator()(ps_entry const &a, ps_entry const &b) const noexcept {
+            return a.finish != b.finish ? a.finish > b.finish : a.seq > b.seq;
+        }
+    };
+
+    // gives j a server or queues it
+    void admit_(job *j) {
+        switch (discipline_) {
+        case discipline::processor_sharing:
+            ps_advance_();
+            ps_.push_back(ps_entry{ps_virtual_ + static_cast<double>(j->service), seq_++, j});
+            std::push_heap(ps_.begin(), ps_.end(), ps_later{});
+            ps_reschedule_();
+            return ;
+        case discipline::priority:
+            if (idle_.empty()) {
+                prio_.push_back(prio_entry{j->priority, seq_++, j});
+                std::push_heap(prio_.begin(), prio_.end(), prio_later{});
+                return ;
+            }
+            break;
+        default:
+            if (idle_.empty()) {
+                fifo_.push_back(j);
+                return ;
+            }
+            break;
+        }
+
+        auto k = idle_.back();
+        idle_.pop_back();
+        start_(k, j);
+    }
+
+    std::size_t busy_() const noexcept {
+        if (discipline_ == discipline::processor_sharing)
+            return std::min(in_system_, servers_);
+
+        return servers_ - idle_.size();
+    }
+
+    // called after every change of the population
+    void record_() noexcept {
+        jobs_.set(static_cast<double>(in_system_));
+        busy_servers_.set(static_cast<double>(busy_()));
+    }
+
+    void schedule_(time_integral t, departure_handler *h) {
+        auto tkn = new token(t, priority_consts::zero, nullptr, "job departure");
+        tkn->handler = h;
+        env_->schedule_token(tkn);
+    }
+
+    void start_(std::size_t k, job *j) {
+        current_[k] = j;
+        schedule_(env_->now() + j->service, handlers_[k].get());
+    }
+
+    void depart_(std::size_t k) {
+        auto j = current_[k];
+        current_[k] = nullptr;
+
+        // the next job starts before the finished one moves on, which may bring it back here
+        job *n = nullptr;
+        if (discipline_ == discipline::priority) {
+            if (!prio_.empty()) {
+                std::pop_heap(prio_.begin(), prio_.end(), prio_later{});
+                n = prio_.back().j;
+                prio_.pop_back();
+            }
+        }
+        else if (!fifo_.empty()) {
+            if (discipline_ == discipline::lifo) {
+                n = fifo_.back();
+                fifo_.pop_back();
+            }
+            else {
+                n = fifo_.front();
+                fifo_.pop_front();
+            }
+        }
+
+        if (n)
+            start_(k, n);
+        else
+            idle_.push_back(k);
+
+        leave_(j);
+    }
+
+    void leave_(job *j) {
+        --in_system_;
+        ++departures_;
+        ++j->visits;
+        record_();
+        next_->accept(j);
+    }
+
+    // each job receives min(1, servers / n) units of work per tick
+    double ps_rate_() const noexcept {
+        if (ps_.empty())
+            return 0;
+
+        return std::min(1.0, static_cast<double>(servers_) / static_cast<double>(ps_.size()));
+    }
+
+    void ps_advance_() noexcept {
+        ps_virtual_ += static_cast<double>(env_->now() - ps_last_) * ps_rate_();
+        ps_last_ = env_->now();
+    }
+
+    void ps_reschedule_() {
+        if (ps_.empty()) {
+            ps_pending_ = false;
+            ps_virtual_ = 0;
+            return ;
+        }
+
+        auto remaining = std::max(ps_.front().finish - ps_virtual_, 0.0);
+        auto due = env_->now() + static_cast<time_integral>(std::ceil(remaining / ps_rate_() - ps_tolerance));
+
+        if (ps_pending_ && ps_due_ == due)
+            return ;
+
+        ps_pending_ = true;
+        ps_due_ = due;
+        schedule_(due, ps_handler_.get());
+    }
+
+    void ps_depart_() {
+        // superseded by a later arrival
+        if (!ps_pending_ || ps_due_ != env_->now())
+            return ;
+
+        ps_pending_ = false;
+        ps_advance_();
+
+        while (!ps_.empty() && ps_.front().finish <= ps_virtual_ + ps_tolerance) {
+            std::pop_heap(ps_.begin(), ps_.end(), ps_later{});
+            ps_done_.push_back(ps_.back().j);
+            ps_.pop_back();
+        }
+
+        ps_reschedule_();
+
+        for (auto j: ps_done_)
+            leave_(j);
+
+        ps_done_.clear();
+    }
+
+    static constexpr double ps_tolerance = 1e-6;
+
+    environment *env_;
+    std::size_t servers_;
+    discipline discipline_;
+    std::function<double(job const &)> service_;
+    node *next_ = nullptr;
+
+    std::size_t in_system_ = 0;
+    std::uint64_t seq_ = 0;
+
+    // FIFO, LIFO, priority
+    std::vector<job *> current_;
+    std::vector<std::size_t> idle_;
+    std::vector<memory::ptr<departure_handler>> handlers_;
+    std::deque<job *> fifo_;
+    std::vector<prio_entry> prio_;
+
+    // processor sharing
+    std::vector<ps_entry> ps_;
+    std::vector<job *> ps_done_;
+    double ps_virtual_ = 0;
+    time_integral ps_last_ = 0;
+    bool ps_pending_ = false;
+    time_integral ps_due_ = 0;
+    memory::ptr<departure_handler> ps_handler_;
+
+    // statistics
+    std::uint64_t arrivals_ = 0;
+    std::uint64_t departures_ = 0;
+    stats::time_weighted jobs_;
+    stats::time_weighted busy_servers_;
+};
+
+} /* namespace detail */
+
+using detail::station;
+
+} /* namespace queueing */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_QUEUEING_STATION_HPP_INCLUDED */
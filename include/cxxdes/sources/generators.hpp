@@ -0,0 +1,254 @@
+/**
+ * @file generators.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Poisson, renewal, Markov-modulated, batch, periodic, and trace-driven arrivals.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SOURCES_GENERATORS_HPP_INCLUDED
+#define CXXDES_SOURCES_GENERATORS_HPP_INCLUDED
+
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sources/source.hpp>
+
+namespace cxxdes {
+namespace sources {
+
+/**
+ * @brief Arrivals separated by independent, identically distributed gaps.
+ *
+ * @tparam Distribution Callable returning gaps in model units, or a random
+ *         number distribution, which draws from an engine seeded with the
+ *         seed given to the constructor.
+ */
+template <typename Distribution>
+struct renewal: source {
+    /** @brief Constructs a source whose gaps are drawn from @p gap. */
+    renewal(cxxdes::core::environment &env, Distribution gap, std::uint64_t seed = 1):
+        source{env}, gap_{std::move(gap)}, rng_{seed} {
+    }
+
+protected:
+    void next_() override {
+        schedule_after(static_cast<double>(detail::draw(gap_, rng_)));
+    }
+
+private:
+    Distribution gap_;
+    std::mt19937_64 rng_;
+};
+
+/** @brief Arrivals with exponential gaps, at a fixed rate. */
+struct poisson: renewal<std::exponential_distribution<double>> {
+    /**
+     * @brief Constructs a source of @p rate arrivals per model unit.
+     *
+     * @throws std::runtime_error If @p rate is not positive.
+     */
+    poisson(cxxdes::core::environment &env, double rate, std::uint64_t seed = 1):
+        renewal{env, std::exponential_distribution<double>{check_(rate)}, seed} {
+    }
+
+private:
+    static double check_(double rate) {
+        if (!(rate > 0))
+            throw std::runtime_error("poisson rate must be positive");
+        return rate;
+    }
+};
+
+/**
+ * @brief Markov-modulated Poisson arrivals.
+ *
+ * A continuous-time Markov chain selects the arrival rate: in state `i`,
+ * arrivals come at `rates[i]` per model unit, and the chain moves to state
+ * `j` at `switching[i][j]` per model unit. State changes are sampled
+ * together with the arrivals, so the source still schedules one event per
+ * arrival.
+ *
+ * @throws std::runtime_error From the constructor if the matrix is not square
+ *         with one row per state, or if a rate is negative.
+ */
+struct mmpp: source {
+    /** @brief Constructs a source starting in state @p initial. */
+    mmpp(
+        cxxdes::core::environment &env,
+        std::vector<double> rates, std::vector<std::vector<double>> switching,
+        std::size_t initial = 0, std::uint64_t seed = 1):
+        source{env},
+        rates_{std::move(rates)}, switching_{std::move(switching)},
+        state_{initial}, rng_{seed} {
+        if (rates_.empty() || switching_.size() != rates_.size() || initial >= rates_.size())
+            throw std::runtime_error("mmpp needs one switching row per state");
+
+        leave_.resize(rates_.size());
+        for (std::size_t i = 0; i < rates_.size(); ++i) {
+            if (switching_[i].size() != rates_.size() || rates_[i] < 0)
+                throw std::runtime_error("mmpp needs a square switching matrix and non-negative rates");
+
+            for (std::size_t j = 0; j < rates_.size(); ++j) {
+                if (switching_[i][j] < 0)
+                    throw std::runtime_error("mmpp switching rates must be non-negative");
+
+                if (j != i)
+                    leave_[i] += switching_[i][j];
+            }
+
+            if (rates_[i] + leave_[i] <= 0)
+                throw std::runtime_error("mmpp has an absorbing state without arrivals");
+        }
+    }
+
+    /** @brief Returns the state of the modulating chain at the next scheduled arrival. */
+    std::size_t state() const noexcept {
+        return state_;
+    }
+
+protected:
+    void next_() override {
+        // delay to the next arrival, in model units
+        double t = 0;
+        std::uniform_real_distribution<double> u;
+
+        while (true) {
+            auto total = rates_[state_] + leave_[state_];
+            t += std::exponential_distribution<double>{total}(rng_);
+
+            auto x = u(rng_) * total;
+            if (x < rates_[state_])
+                break;
+
+            x -= rates_[state_];
+            auto from = state_;
+            for (std::size_t j = 0; j < rates_.size(); ++j) {
+                if (j == from || switching_[from][j] <= 0)
+                    continue;
+
+                // the last candidate absorbs rounding errors
+                state_ = j;
+                if (x < switching_[from][j])
+                    break;
+
+                x -= switching_[from][j];
+            }
+        }
+
+        schedule_after(t);
+    }
+
+private:
+    std::vector<double> rates_;
+    std::vector<std::vector<double>> switching_;
+    std::vector<double> leave_;
+    std::size_t state_;
+    std::mt19937_64 rng_;
+};
+
+/**
+ * @brief Groups of simultaneous arrivals separated by random gaps.
+ *
+ * Each group is one event, however many arrivals it has; a group of size
+ * zero has no arrivals.
+ *
+ * @tparam Gap Callable or random number distribution returning gaps in model units.
+ * @tparam Size Callable or random number distribution returning group sizes.
+ */
+template <typename Gap, typename Size>
+struct batch: source {
+    /** @brief Constructs a source with gaps drawn from @p gap and group sizes from @p size. */
+    batch(cxxdes::core::environment &env, Gap gap, Size size, std::uint64_t seed = 1):
+        source{env}, gap_{std::move(gap)}, size_dist_{std::move(size)}, rng_{seed} {
+    }
+
+protected:
+    void next_() override {
+        schedule_after(static_cast<double>(detail::draw(gap_, rng_)));
+    }
+
+    std::size_t size_() override {
+        auto n = detail::draw(size_dist_, rng_);
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+private:
+    Gap gap_;
+    Size size_dist_;
+    std::mt19937_64 rng_;
+};
+
+/**
+ * @brief Arrivals once per period, each delayed by an independent uniform jitter.
+ *
+ * Arrival `k` happens at `start + k * period + u`, where `u` is uniform in
+ * `[0, jitter)`, so the jitter does not accumulate.
+ *
+ * @throws std::runtime_error From the constructor if @p period is not
+ *         positive, or @p jitter is not in `[0, period]`.
+ */
+struct periodic: source {
+    /** @brief Constructs a source with the given @p period and @p jitter, in model units. */
+    periodic(cxxdes::core::environment &env, double period, double jitter = 0, std::uint64_t seed = 1):
+        source{env}, period_{period}, jitter_{jitter}, rng_{seed} {
+        if (!(period > 0))
+            throw std::runtime_error("periodic period must be positive");
+
+        if (!(jitter >= 0 && jitter <= period))
+            throw std::runtime_error("periodic jitter must be between zero and the period");
+    }
+
+protected:
+    void next_() override {
+        if (k_ == 0)
+            origin_ = env().now();
+
+        ++k_;
+        auto u = jitter_ > 0 ? std::uniform_real_distribution<double>{0, jitter_}(rng_) : 0.0;
+        schedule_at(origin_ + env().real_to_sim(static_cast<double>(k_) * period_ + u));
+    }
+
+private:
+    double period_;
+    double jitter_;
+    std::mt19937_64 rng_;
+    std::uint64_t k_ = 0;
+    cxxdes::core::time_integral origin_ = 0;
+};
+
+/** @brief Arrivals replaying a nondecreasing list of absolute times, in model units. */
+struct trace: source {
+    /**
+     * @brief Constructs a source with one arrival at each of @p times.
+     *
+     * @throws std::runtime_error If @p times decreases.
+     */
+    trace(cxxdes::core::environment &env, std::vector<double> times):
+        source{env}, times_{std::move(times)} {
+        for (std::size_t i = 1; i < times_.size(); ++i) {
+            if (times_[i] < times_[i - 1])
+                throw std::runtime_error("trace needs nondecreasing arrival times");
+        }
+    }
+
+protected:
+    void next_() override {
+        if (next_index_ < times_.size())
+            schedule_at(env().real_to_sim(times_[next_index_++]));
+    }
+
+private:
+    std::vector<double> times_;
+    std::size_t next_index_ = 0;
+};
+
+} /* namespace sources */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SOURCES_GENERATORS_HPP_INCLUDED */
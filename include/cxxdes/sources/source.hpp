@@ -0,0 +1,199 @@
+/**
+ * @file source.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Base class of the arrival-process generators.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SOURCES_SOURCE_HPP_INCLUDED
+#define CXXDES_SOURCES_SOURCE_HPP_INCLUDED
+
+#include <limits>
+#include <random>
+#include <cstdint>
+#include <utility>
+#include <concepts>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/sync/queue.hpp>
+
+namespace cxxdes {
+namespace sources {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Returns a sample of @p s.
+ *
+ * @p s is either a callable taking no arguments, or a random number
+ * distribution such as `std::gamma_distribution`, which draws from @p rng.
+ */
+template <typename Sampler>
+auto draw(Sampler &s, std::mt19937_64 &rng) {
+    if constexpr (std::invocable<Sampler &>)
+        return s();
+    else
+        return s(rng);
+}
+
+/**
+ * @brief Common part of the arrival-process generators.
+ *
+ * A source is not a process. It owns a single token, which is scheduled at
+ * the next arrival; when the token fires, the source schedules it again at
+ * the arrival after, and then reports the arrival by calling the function
+ * given to `on_arrival()`. An arrival therefore costs one event and no
+ * allocation, whatever the length of the run.
+ */
+struct source {
+    CXXDES_NOT_COPIABLE(source)
+    CXXDES_NOT_MOVABLE(source)
+
+    /** @brief Calls @p f once for every arrival. */
+    void on_arrival(std::function<void()> f) {
+        on_arrival_ = std::move(f);
+    }
+
+    /**
+     * @brief Puts `make()` into @p q at every arrival.
+     *
+     * Arrivals that find a bounded queue full are dropped and counted by
+     * `dropped()`.
+     */
+    template <typename T, typename Monitor, typename Make>
+    void feed(sync::queue<T, Monitor> &q, Make make) {
+        on_arrival([this, &q, make = std::move(make)]() mutable {
+            if (!q.try_put(*env_, make()))
+                ++dropped_;
+        });
+    }
+
+    /**
+     * @brief Schedules the first arrival.
+     *
+     * Call it once the time unit of the environment is configured, for
+     * instance from `co_main()`.
+     *
+     * @throws std::runtime_error If the source was already started.
+     */
+    void start() {
+        if (started_)
+            throw std::runtime_error("source already started");
+
+        started_ = true;
+        next_();
+    }
+
+    /** @brief Stops generating arrivals; an arrival already scheduled is dropped. */
+    void stop() noexcept {
+        stopped_ = true;
+    }
+
+    /** @brief Stops after @p n arrivals in total. */
+    void limit(std::uint64_t n) noexcept {
+        limit_ = n;
+    }
+
+    /** @brief Returns the number of arrivals so far. */
+    std::uint64_t generated() const noexcept {
+        return generated_;
+    }
+
+    /** @brief Returns the number of arrivals `feed()` could not put into its queue. */
+    std::uint64_t dropped() const noexcept {
+        return dropped_;
+    }
+
+    virtual ~source() {
+        handler_->s = nullptr;
+    }
+
+protected:
+    explicit source(environment &env):
+        env_{&env},
+        handler_{new arrival_handler{this}},
+        tkn_{new token(0, priority_consts::zero, nullptr, "arrival")} {
+        tkn_->handler = handler_.get();
+    }
+
+    /** @brief Schedules the next arrival with `schedule_at()` or `schedule_after()`, or does nothing to end. */
+    virtual void next_() = 0;
+
+    /** @brief Returns the number of arrivals at the arrival being processed. */
+    virtual std::size_t size_() {
+        return 1;
+    }
+
+    /** @brief Schedules the next arrival at tick @p t, or now if @p t is in the past. */
+    void schedule_at(time_integral t) {
+        tkn_->time = std::max(t, env_->now());
+        env_->schedule_token(tkn_.get());
+    }
+
+    /** @brief Schedules the next arrival @p d model units from now. */
+    void schedule_after(double d) {
+        schedule_at(env_->now() + env_->real_to_sim(d));
+    }
+
+    environment &env() const noexcept {
+        return *env_;
+    }
+
+private:
+    struct arrival_handler: token_handler {
+        source *s;
+
+        arrival_handler(source *s_): s{s_} {
+        }
+
+        void invoke(token *) override {
+            if (s)
+                s->arrive_();
+        }
+    };
+
+    void arrive_() {
+        if (stopped_ || generated_ >= limit_)
+            return ;
+
+        auto n = std::min<std::uint64_t>(size_(), limit_ - generated_);
+        generated_ += n;
+
+        // the next arrival goes first, so that the callback may stop the source
+        if (generated_ < limit_)
+            next_();
+
+        if (on_arrival_) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                on_arrival_();
+        }
+    }
+
+    environment *env_;
+    memory::ptr<arrival_handler> handler_;
+    memory::ptr<token> tkn_;
+    std::function<void()> on_arrival_;
+
+    std::uint64_t generated_ = 0;
+    std::uint64_t dropped_ = 0;
+    std::uint64_t limit_ = std::numeric_limits<std::uint64_t>::max();
+    bool started_ = false;
+    bool stopped_ = false;
+};
+
+} /* namespace detail */
+
+using detail::source;
+
+} /* namespace sources */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SOURCES_SOURCE_HPP_INCLUDED */
@@ -0,0 +1,129 @@
+/**
+ * @file confidence.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Confidence intervals of sample means.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_STATS_CONFIDENCE_HPP_INCLUDED
+#define CXXDES_STATS_CONFIDENCE_HPP_INCLUDED
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <cxxdes/stats/tally.hpp>
+
+namespace cxxdes {
+namespace stats {
+
+namespace detail {
+
+// continued fraction of the regularized incomplete beta function (Lentz's method)
+inline double beta_fraction(double a, double b, double x) noexcept {
+    constexpr double tiny = 1e-300;
+    constexpr double epsilon = 1e-15;
+
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    d = 1 / (std::abs(d) < tiny ? tiny : d);
+    double h = d;
+
+    for (int m = 1; m <= 300; ++m) {
+        double numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        d = 1 + numerator * d;
+        c = 1 + numerator / c;
+        d = 1 / (std::abs(d) < tiny ? tiny : d);
+        c = std::abs(c) < tiny ? tiny : c;
+        h *= d * c;
+
+        numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1 + numerator * d;
+        c = 1 + numerator / c;
+        d = 1 / (std::abs(d) < tiny ? tiny : d);
+        c = std::abs(c) < tiny ? tiny : c;
+
+        auto delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1) < epsilon)
+            break;
+    }
+
+    return h;
+}
+
+// regularized incomplete beta function I_x(a, b)
+inline double incomplete_beta(double a, double b, double x) noexcept {
+    if (x <= 0)
+        return 0;
+
+    if (x >= 1)
+        return 1;
+
+    auto front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log1p(-x));
+    if (x < (a + 1) / (a + b + 2))
+        return front * beta_fraction(a, b, x) / a;
+
+    return 1 - front * beta_fraction(b, a, 1 - x) / b;
+}
+
+} /* namespace detail */
+
+/** @brief Returns the probability that a Student's t variable with @p df degrees of freedom is at most @p t. */
+inline double student_t_cdf(double t, double df) noexcept {
+    auto tail = detail::incomplete_beta(df / 2, 0.5, df / (df + t * t)) / 2;
+    return t >= 0 ? 1 - tail : tail;
+}
+
+/**
+ * @brief Returns the @p p quantile of Student's t distribution with @p df degrees of freedom.
+ *
+ * @throws std::runtime_error If @p p is not in (0, 1) or @p df is not positive.
+ */
+inline double student_t_quantile(double p, double df) {
+    if (!(p > 0 && p < 1) || !(df > 0))
+        throw std::runtime_error("student_t_quantile needs 0 < p < 1 and df > 0");
+
+    if (p < 0.5)
+        return -student_t_quantile(1 - p, df);
+
+    // the cdf is increasing; bisect on a bracket that grows until it holds p
+    double lo = 0;
+    double hi = 1;
+    while (student_t_cdf(hi, df) < p)
+        hi *= 2;
+
+    for (int i = 0; i < 100 && hi - lo > 1e-12 * hi; ++i) {
+        auto mid = (lo + hi) / 2;
+        (student_t_cdf(mid, df) < p ? lo : hi) = mid;
+    }
+
+    return (lo + hi) / 2;
+}
+
+/**
+ * @brief Returns the half-width of the @p confidence interval of the mean of @p t.
+ *
+ * The observations are assumed to be independent and roughly normal, as the
+ * outputs of independent replications are. With fewer than two observations
+ * the half-width is infinite.
+ *
+ * @throws std::runtime_error If @p confidence is not in (0, 1).
+ */
+inline double half_width(tally const &t, double confidence = 0.95) {
+    if (!(confidence > 0 && confidence < 1))
+        throw std::runtime_error("confidence level must be in (0, 1)");
+
+    if (t.count() < 2)
+        return std::numeric_limits<double>::infinity();
+
+    auto df = static_cast<double>(t.count() - 1);
+    return student_t_quantile((1 + confidence) / 2, df) * t.standard_error();
+}
+
+} /* namespace stats */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_STATS_CONFIDENCE_HPP_INCLUDED */
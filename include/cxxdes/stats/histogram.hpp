@@ -0,0 +1,218 @@
+/**
+ * @file histogram.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Histograms with linearly and logarithmically spaced bins.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_STATS_HISTOGRAM_HPP_INCLUDED
+#define CXXDES_STATS_HISTOGRAM_HPP_INCLUDED
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace cxxdes {
+namespace stats {
+
+namespace detail {
+
+// bins of equal width
+struct linear_scale {
+    linear_scale(double lo, double hi, std::size_t bins) {
+        if (bins == 0 || !(lo < hi))
+            throw std::runtime_error("histogram needs lo < hi and at least one bin");
+
+        lo_ = lo;
+        hi_ = hi;
+        scale_ = static_cast<double>(bins) / (hi - lo);
+        width_ = (hi - lo) / static_cast<double>(bins);
+    }
+
+    double position(double x) const noexcept {
+        return (x - lo_) * scale_;
+    }
+
+    double edge(std::size_t i) const noexcept {
+        return lo_ + static_cast<double>(i) * width_;
+    }
+
+    bool operator==(linear_scale const &) const = default;
+
+    double lo_, hi_, scale_, width_;
+};
+
+// bins of equal width in log(x), for quantities spanning orders of magnitude
+struct log_scale {
+    log_scale(double lo, double hi, std::size_t bins) {
+        if (bins == 0 || !(lo > 0) || !(lo < hi))
+            throw std::runtime_error("log_histogram needs 0 < lo < hi and at least one bin");
+
+        lo_ = lo;
+        hi_ = hi;
+        step_ = std::log(hi / lo) / static_cast<double>(bins);
+    }
+
+    double position(double x) const noexcept {
+        return x > 0 ? std::log(x / lo_) / step_ : -1.0;
+    }
+
+    double edge(std::size_t i) const noexcept {
+        return lo_ * std::exp(static_cast<double>(i) * step_);
+    }
+
+    bool operator==(log_scale const &) const = default;
+
+    double lo_, hi_, step_;
+};
+
+/**
+ * @brief Counts of observations in `bins` bins between `lo` and `hi`.
+ *
+ * Observations below `lo` and from `hi` on are counted separately. The bins
+ * are allocated by the constructor; updates take constant time and never
+ * allocate. Histograms with the same bins can be merged.
+ *
+ * @tparam Scale Spacing of the bins.
+ */
+template <typename Scale>
+struct basic_histogram {
+    /**
+     * @brief Constructs a histogram with @p bins bins between @p lo and @p hi.
+     *
+     * @throws std::runtime_error If the range is empty or there are no bins.
+     */
+    basic_histogram(double lo, double hi, std::size_t bins):
+        scale_{lo, hi, bins}, counts_(bins, 0) {
+    }
+
+    /** @brief Records @p n observations of @p x. */
+    void add(double x, std::uint64_t n = 1) noexcept {
+        total_ += n;
+
+        if (x < scale_.lo_) {
+            underflow_ += n;
+            return ;
+        }
+
+        if (!(x < scale_.hi_)) {
+            overflow_ += n;
+            return ;
+        }
+
+        auto i = static_cast<std::size_t>(std::max(scale_.position(x), 0.0));
+        counts_[std::min(i, counts_.size() - 1)] += n;
+    }
+
+    /**
+     * @brief Adds the observations recorded by @p other.
+     *
+     * @throws std::runtime_error If @p other has different bins.
+     */
+    void merge(basic_histogram const &other) {
+        if (!(scale_ == other.scale_) || counts_.size() != other.counts_.size())
+            throw std::runtime_error("histograms with different bins cannot be merged");
+
+        for (std::size_t i = 0; i < counts_.size(); ++i)
+            counts_[i] += other.counts_[i];
+
+        underflow_ += other.underflow_;
+        overflow_ += other.overflow_;
+        total_ += other.total_;
+    }
+
+    /** @brief Forgets all observations. */
+    void reset() noexcept {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        underflow_ = 0;
+        overflow_ = 0;
+        total_ = 0;
+    }
+
+    /** @brief Returns the number of bins. */
+    std::size_t bins() const noexcept {
+        return counts_.size();
+    }
+
+    /** @brief Returns the number of observations in bin @p i. */
+    std::uint64_t count(std::size_t i) const noexcept {
+        return counts_[i];
+    }
+
+    /** @brief Returns the lower edge of bin @p i; `lower(bins())` is `hi`. */
+    double lower(std::size_t i) const noexcept {
+        return scale_.edge(i);
+    }
+
+    /** @brief Returns the upper edge of bin @p i. */
+    double upper(std::size_t i) const noexcept {
+        return scale_.edge(i + 1);
+    }
+
+    /** @brief Returns the number of observations below `lo`. */
+    std::uint64_t underflow() const noexcept {
+        return underflow_;
+    }
+
+    /** @brief Returns the number of observations from `hi` on. */
+    std::uint64_t overflow() const noexcept {
+        return overflow_;
+    }
+
+    /** @brief Returns the number of observations. */
+    std::uint64_t total() const noexcept {
+        return total_;
+    }
+
+    /**
+     * @brief Returns an estimate of the @p q quantile.
+     *
+     * Observations are assumed to be spread evenly within their bin. Quantiles
+     * falling among the observations below `lo` or from `hi` on are reported
+     * as `lo` or `hi`.
+     */
+    double quantile(double q) const noexcept {
+        if (total_ == 0)
+            return 0;
+
+        auto target = std::clamp(q, 0.0, 1.0) * static_cast<double>(total_);
+        auto seen = static_cast<double>(underflow_);
+        if (target <= seen && underflow_ > 0)
+            return scale_.lo_;
+
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            auto c = static_cast<double>(counts_[i]);
+            if (c > 0 && target <= seen + c)
+                return lower(i) + (upper(i) - lower(i)) * (target - seen) / c;
+
+            seen += c;
+        }
+
+        return scale_.hi_;
+    }
+
+private:
+    Scale scale_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t underflow_ = 0;
+    std::uint64_t overflow_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+} /* namespace detail */
+
+/** @brief Histogram with bins of equal width. */
+using histogram = detail::basic_histogram<detail::linear_scale>;
+
+/** @brief Histogram whose bin edges grow geometrically, for quantities spanning orders of magnitude. */
+using log_histogram = detail::basic_histogram<detail::log_scale>;
+
+} /* namespace stats */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_STATS_HISTOGRAM_HPP_INCLUDED */
@@ -0,0 +1,117 @@
+/**
+ * @file tally.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Count, mean, variance, and extremes of a stream of observations.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_STATS_TALLY_HPP_INCLUDED
+#define CXXDES_STATS_TALLY_HPP_INCLUDED
+
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+namespace cxxdes {
+namespace stats {
+
+/**
+ * @brief Accumulator of observations that are not weighted by time, such as waiting times.
+ *
+ * Updates take constant time and never allocate. Tallies of independent
+ * replications can be merged, which gives the same statistics as one tally
+ * that saw all observations.
+ */
+struct tally {
+    /** @brief Records the observation @p x. */
+    void add(double x) noexcept {
+        // Welford's algorithm
+        ++count_;
+        auto delta = x - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (x - mean_);
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+    }
+
+    /** @brief Adds the observations recorded by @p other. */
+    void merge(tally const &other) noexcept {
+        if (other.count_ == 0)
+            return ;
+
+        if (count_ == 0) {
+            *this = other;
+            return ;
+        }
+
+        // Chan et al.'s pairwise update
+        auto n = static_cast<double>(count_ + other.count_);
+        auto delta = other.mean_ - mean_;
+        mean_ += delta * static_cast<double>(other.count_) / n;
+        m2_ += other.m2_ + delta * delta * static_cast<double>(count_) * static_cast<double>(other.count_) / n;
+        count_ += other.count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /** @brief Forgets all observations. */
+    void reset() noexcept {
+        *this = tally{};
+    }
+
+    /** @brief Returns the number of observations. */
+    std::uint64_t count() const noexcept {
+        return count_;
+    }
+
+    /** @brief Returns the sum of the observations. */
+    double sum() const noexcept {
+        return mean_ * static_cast<double>(count_);
+    }
+
+    /** @brief Returns the sample mean, or zero without observations. */
+    double mean() const noexcept {
+        return mean_;
+    }
+
+    /** @brief Returns the sample variance, or zero with fewer than two observations. */
+    double variance() const noexcept {
+        return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+    }
+
+    /** @brief Returns the sample standard deviation. */
+    double stddev() const noexcept {
+        return std::sqrt(variance());
+    }
+
+    /** @brief Returns the standard error of the mean, assuming independent observations. */
+    double standard_error() const noexcept {
+        return count_ > 1 ? std::sqrt(variance() / static_cast<double>(count_)) : 0.0;
+    }
+
+    /** @brief Returns the smallest observation, or infinity without observations. */
+    double min() const noexcept {
+        return min_;
+    }
+
+    /** @brief Returns the largest observation, or minus infinity without observations. */
+    double max() const noexcept {
+        return max_;
+    }
+
+private:
+    std::uint64_t count_ = 0;
+    double mean_ = 0;
+    double m2_ = 0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+} /* namespace stats */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_STATS_TALLY_HPP_INCLUDED */
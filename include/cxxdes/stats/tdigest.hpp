@@ -0,0 +1,211 @@
+/**
+ * @file tdigest.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Mergeable streaming quantile estimates (t-digest).
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_STATS_TDIGEST_HPP_INCLUDED
+#define CXXDES_STATS_TDIGEST_HPP_INCLUDED
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <numbers>
+#include <algorithm>
+#include <stdexcept>
+
+namespace cxxdes {
+namespace stats {
+
+/**
+ * @brief Sketch of a distribution that estimates its quantiles in bounded space.
+ *
+ * Observations are summarized by weighted centroids that are small near the
+ * tails and larger in the middle, so extreme quantiles are estimated most
+ * accurately (Dunning's merging t-digest with the arcsine scale function).
+ * The storage is allocated by the constructor; `add()` appends to a buffer
+ * that is merged into the centroids when it fills up, so updates take
+ * amortized constant time and never allocate. Sketches of independent
+ * replications can be merged.
+ */
+struct tdigest {
+    /**
+     * @brief Constructs an empty sketch.
+     *
+     * @param compression Larger values keep more centroids, which improves
+     *        accuracy; the sketch keeps at most about `compression` centroids.
+     * @throws std::runtime_error If @p compression is less than 10.
+     */
+    explicit tdigest(double compression = 100): compression_{compression} {
+        if (!(compression >= 10))
+            throw std::runtime_error("tdigest compression must be at least 10");
+
+        auto centroids = static_cast<std::size_t>(std::ceil(2 * compression)) + 10;
+        auto buffer = static_cast<std::size_t>(std::ceil(5 * compression));
+        points_.resize(centroids + buffer);
+    }
+
+    /** @brief Records @p x with weight @p w. */
+    void add(double x, double w = 1) noexcept {
+        if (used_ == points_.size())
+            compress_();
+
+        points_[used_++] = point{x, w};
+        total_ += w;
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+    }
+
+    /** @brief Adds the observations summarized by @p other. */
+    void merge(tdigest const &other) noexcept {
+        for (std::size_t i = 0; i < other.used_; ++i) {
+            if (used_ == points_.size())
+                compress_();
+
+            points_[used_++] = other.points_[i];
+            total_ += other.points_[i].weight;
+        }
+
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /** @brief Forgets all observations. */
+    void reset() noexcept {
+        used_ = 0;
+        centroids_ = 0;
+        total_ = 0;
+        min_ = std::numeric_limits<double>::infinity();
+        max_ = -std::numeric_limits<double>::infinity();
+    }
+
+    /** @brief Returns the total weight of the observations. */
+    double count() const noexcept {
+        return total_;
+    }
+
+    /** @brief Returns the smallest observation, or infinity without observations. */
+    double min() const noexcept {
+        return min_;
+    }
+
+    /** @brief Returns the largest observation, or minus infinity without observations. */
+    double max() const noexcept {
+        return max_;
+    }
+
+    /** @brief Returns the number of centroids, merging buffered observations first. */
+    std::size_t centroids() const noexcept {
+        compress_();
+        return centroids_;
+    }
+
+    /** @brief Returns an estimate of the @p q quantile, or zero without observations. */
+    double quantile(double q) const noexcept {
+        if (total_ == 0)
+            return 0;
+
+        compress_();
+
+        auto index = std::clamp(q, 0.0, 1.0) * total_;
+        if (index <= 0)
+            return min_;
+
+        if (index >= total_)
+            return max_;
+
+        if (centroids_ == 1)
+            return points_[0].mean;
+
+        // centroid i stands for its weight spread around its mean
+        double seen = 0;
+        for (std::size_t i = 0; i < centroids_; ++i) {
+            auto center = seen + points_[i].weight / 2;
+
+            if (index < center) {
+                if (i == 0)
+                    return min_ + (points_[0].mean - min_) * index / center;
+
+                auto previous = seen - points_[i - 1].weight / 2;
+                auto t = (index - previous) / (center - previous);
+                return points_[i - 1].mean + t * (points_[i].mean - points_[i - 1].mean);
+            }
+
+            seen += points_[i].weight;
+        }
+
+        auto last = points_[centroids_ - 1];
+        auto center = total_ - last.weight / 2;
+        return last.mean + (max_ - last.mean) * std::min((index - center) / (total_ - center), 1.0);
+    }
+
+private:
+    struct point {
+        double mean;
+        double weight;
+    };
+
+    // scale function k1 and its inverse
+    double k_(double q) const noexcept {
+        return compression_ / (2 * std::numbers::pi) * std::asin(2 * std::clamp(q, 0.0, 1.0) - 1);
+    }
+
+    double q_(double k) const noexcept {
+        k = std::min(k, compression_ / 4);
+        return (std::sin(k * 2 * std::numbers::pi / compression_) + 1) / 2;
+    }
+
+    // merges the buffer into the centroids, which stay at the front of points_
+    void compress_() const noexcept {
+        if (used_ == centroids_)
+            return ;
+
+        std::sort(points_.begin(), points_.begin() + used_, [](point const &a, point const &b) {
+            return a.mean < b.mean;
+        });
+
+        std::size_t out = 0;
+        auto current = points_[0];
+        double before = 0;
+        auto limit = total_ * q_(k_(0) + 1);
+
+        for (std::size_t i = 1; i < used_; ++i) {
+            auto const &p = points_[i];
+
+            if (before + current.weight + p.weight <= limit) {
+                current.weight += p.weight;
+                current.mean += (p.mean - current.mean) * p.weight / current.weight;
+            }
+            else {
+                before += current.weight;
+                points_[out++] = current;
+                limit = total_ * q_(k_(before / total_) + 1);
+                current = p;
+            }
+        }
+
+        points_[out++] = current;
+        centroids_ = out;
+        used_ = out;
+    }
+
+    double compression_;
+    double total_ = 0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+
+    // centroids, then buffered observations; merging them is not an observable change
+    mutable std::vector<point> points_;
+    mutable std::size_t used_ = 0;
+    mutable std::size_t centroids_ = 0;
+};
+
+} /* namespace stats */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_STATS_TDIGEST_HPP_INCLUDED */
@@ -0,0 +1,148 @@
+/**
+ * @file time_weighted.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Time averages of piecewise-constant quantities.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_STATS_TIME_WEIGHTED_HPP_INCLUDED
+#define CXXDES_STATS_TIME_WEIGHTED_HPP_INCLUDED
+
+#include <cmath>
+#include <algorithm>
+#include <cxxdes/core/core.hpp>
+
+namespace cxxdes {
+namespace stats {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Accumulator of a quantity that holds its value between changes, such as a queue length.
+ *
+ * Every value is weighted by how long it was held, measured with
+ * `environment::now()`; the value holds until the current time, so the
+ * statistics can be read at any point. Updates take constant time and never
+ * allocate. Accumulators of independent replications can be merged, which
+ * gives the same statistics as the replications run back to back.
+ */
+struct time_weighted {
+    /** @brief Starts averaging in @p env at the current time, from the value @p initial. */
+    explicit time_weighted(environment &env, double initial = 0) noexcept:
+        env_{&env}, value_{initial}, last_{env.now()}, min_{initial}, max_{initial} {
+    }
+
+    /** @brief Changes the value to @p x from now on. */
+    void set(double x) noexcept {
+        close_();
+        value_ = x;
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+    }
+
+    /** @brief Changes the value by @p dx from now on. */
+    void add(double dx) noexcept {
+        set(value_ + dx);
+    }
+
+    /** @brief Returns the current value. */
+    double value() const noexcept {
+        return value_;
+    }
+
+    /** @brief Returns the length of the averaging window, in ticks. */
+    time_integral duration() const noexcept {
+        return elapsed_ + (env_->now() - last_);
+    }
+
+    /** @brief Returns the time average, or the current value over an empty window. */
+    double mean() const noexcept {
+        auto d = duration();
+        if (d == 0)
+            return value_;
+
+        return (area_ + value_ * open_()) / static_cast<double>(d);
+    }
+
+    /** @brief Returns the time-weighted variance. */
+    double variance() const noexcept {
+        auto d = duration();
+        if (d == 0)
+            return 0;
+
+        auto m = mean();
+        return std::max((area2_ + value_ * value_ * open_()) / static_cast<double>(d) - m * m, 0.0);
+    }
+
+    /** @brief Returns the time-weighted standard deviation. */
+    double stddev() const noexcept {
+        return std::sqrt(variance());
+    }
+
+    /** @brief Returns the smallest value held in the window. */
+    double min() const noexcept {
+        return min_;
+    }
+
+    /** @brief Returns the largest value held in the window. */
+    double max() const noexcept {
+        return max_;
+    }
+
+    /** @brief Restarts the window now, for instance after a warm-up period; the value is kept. */
+    void reset() noexcept {
+        area_ = 0;
+        area2_ = 0;
+        elapsed_ = 0;
+        last_ = env_->now();
+        min_ = value_;
+        max_ = value_;
+    }
+
+    /** @brief Adds the window of @p other, up to the current time of its environment. */
+    void merge(time_weighted const &other) noexcept {
+        auto open = other.open_();
+        area_ += other.area_ + other.value_ * open;
+        area2_ += other.area2_ + other.value_ * other.value_ * open;
+        elapsed_ += other.duration();
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+private:
+    // length of the piece still being held
+    double open_() const noexcept {
+        return static_cast<double>(env_->now() - last_);
+    }
+
+    void close_() noexcept {
+        auto dt = open_();
+        area_ += value_ * dt;
+        area2_ += value_ * value_ * dt;
+        elapsed_ += env_->now() - last_;
+        last_ = env_->now();
+    }
+
+    environment *env_;
+    double value_;
+    time_integral last_;
+    time_integral elapsed_ = 0;
+    double area_ = 0;
+    double area2_ = 0;
+    double min_;
+    double max_;
+};
+
+} /* namespace detail */
+
+using detail::time_weighted;
+
+} /* namespace stats */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_STATS_TIME_WEIGHTED_HPP_INCLUDED */
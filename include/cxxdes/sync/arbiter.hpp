@@ -0,0 +1,512 @@
+/**
+ * @file arbiter.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Cycle-based arbiter for shared buses and crossbar ports.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_ARBITER_HPP_INCLUDED
+#define CXXDES_SYNC_ARBITER_HPP_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+using namespace cxxdes::core;
+
+/** @brief How an `arbiter` picks among requesting ports. */
+enum class arbiter_policy {
+    /** @brief The first requesting port after the last winner. */
+    round_robin,
+
+    /** @brief The requesting port with the lowest index. */
+    fixed_priority,
+
+    /** @brief Round-robin in which a port wins up to its weight in a row per round. */
+    weighted,
+
+    /** @brief The oldest request, whichever port it came from. */
+    age_based
+};
+
+/**
+ * @brief Arbiter granting a shared bus or crossbar output to requesting ports.
+ *
+ * Each requester belongs to one of `ports()` ports. `request(port)` suspends
+ * until the request is granted and returns a move-only grant, which must be
+ * released with `co_await grant.release()`. At most `capacity()` grants are
+ * held at a time.
+ *
+ * Grant decisions are made once per cycle: requests are gathered, and a
+ * single arbitration pass at the next cycle boundary, after every other
+ * event of that time, picks winners for all free slots according to the
+ * `arbiter_policy`. Exactly the winners are resumed, together with one
+ * scheduled event; losing requests stay queued untouched. A release frees its
+ * slot for the pass of the next cycle.
+ *
+ * `port(i)` returns an acquirable view for `_Co_with`. `request_for()` and
+ * `request_until()` give up at a deadline.
+ */
+struct arbiter {
+private:
+    struct request_awaitable;
+    struct release_awaitable;
+
+public:
+    /**
+     * @brief Move-only token representing a grant of an `arbiter`.
+     *
+     * A valid grant borrows the arbiter object and must not outlive it.
+     */
+    struct grant {
+        grant() = delete;
+
+        grant(grant const &) = delete;
+        grant &operator=(grant const &) = delete;
+
+        grant(grant &&other) {
+            *this = std::move(other);
+        }
+
+        grant &operator=(grant &&other) {
+            std::swap(a_, other.a_);
+            std::swap(port_, other.port_);
+            return *this;
+        }
+
+        /** @brief Returns whether this grant is still held. */
+        [[nodiscard]]
+        bool valid() const noexcept {
+            return a_ != nullptr;
+        }
+
+        /** @brief Equivalent to `valid()`. */
+        [[nodiscard]]
+        operator bool() const noexcept {
+            return valid();
+        }
+
+        /** @brief Returns the port this grant was issued to. */
+        [[nodiscard]]
+        std::size_t port() const noexcept {
+            return port_;
+        }
+
+        /**
+         * @brief Releases the grant; its slot is arbitrated in the next cycle.
+         *
+         * @throws std::runtime_error If the grant is invalid.
+         */
+        [[nodiscard("expected usage: co_await grant.release()")]]
+        auto release() {
+            if (!valid())
+                throw std::runtime_error("called release() on invalid arbiter grant");
+
+            auto a = a_;
+            a_ = nullptr;
+
+            return release_awaitable{a};
+        }
+
+    private:
+        friend struct arbiter;
+
+        grant(arbiter *a, std::size_t port): a_{a}, port_{port} {
+        }
+
+        arbiter *a_ = nullptr;
+        std::size_t port_ = 0;
+    };
+
+    /** @brief Acquirable view that requests a grant for one port; usable with `_Co_with`. */
+    struct port_view {
+        /** @brief Equivalent to `arbiter::request(port)`. */
+        [[nodiscard("expected usage: co_await view.acquire()")]]
+        auto acquire();
+
+    private:
+        friend struct arbiter;
+
+        port_view(arbiter *a, std::size_t port): a_{a}, port_{port} {
+        }
+
+        arbiter *a_;
+        std::size_t port_;
+    };
+
+    /**
+     * @brief Constructs an arbiter.
+     *
+     * @param ports Number of requesting ports.
+     * @param policy Arbitration policy.
+     * @param cycle Cycle length in ticks; arbitration passes happen at its multiples.
+     * @param capacity Number of grants that can be held at the same time.
+     * @throws std::runtime_error If any of @p ports, @p cycle, or @p capacity is not positive.
+     */
+    arbiter(
+        std::size_t ports,
+        arbiter_policy policy = arbiter_policy::round_robin,
+        time_integral cycle = 1,
+        std::size_t capacity = 1):
+        policy_{policy}, cycle_{cycle}, capacity_{capacity}, free_{capacity}, ports_(ports) {
+        if (ports == 0 || cycle <= 0 || capacity == 0)
+            throw std::runtime_error("arbiter ports, cycle, and capacity must be positive");
+
+        views_.reserve(ports);
+        for (std::size_t i = 0; i < ports; ++i)
+            views_.push_back(port_view{this, i});
+    }
+
+    CXXDES_NOT_COPIABLE(arbiter)
+    CXXDES_NOT_MOVABLE(arbiter)
+
+    /**
+     * @brief Waits until the next arbitration pass that grants @p port.
+     *
+     * Requests of the same port are granted in arrival order. The awaitable
+     * is also a selectable operation for `select`.
+     *
+     * @throws std::runtime_error If @p port is out of range.
+     */
+    [[nodiscard("expected usage: co_await arbiter.request(port)")]]
+    auto request(std::size_t port, priority_type priority = priority_consts::inherit) {
+        check_(port);
+        return request_awaitable{this, port, priority};
+    }
+
+    /**
+     * @brief Like `request()`, but gives up after @p d.
+     *
+     * @return A `timed_result<grant>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await arbiter.request_for(d, port)")]]
+    auto request_for(D &&d, std::size_t port, priority_type priority = priority_consts::inherit) {
+        return timed(request(port, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `request()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await arbiter.request_until(t, port)")]]
+    auto request_until(T &&t, std::size_t port, priority_type priority = priority_consts::inherit) {
+        return timed(request(port, priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns a view that requests grants for @p port, e.g. `_Co_with(arb.port(i))`. */
+    port_view &port(std::size_t port) {
+        check_(port);
+        return views_[port];
+    }
+
+    /**
+     * @brief Sets the weight of @p port under the `weighted` policy.
+     *
+     * The port wins up to @p weight times in a row before the others get a
+     * turn. The new weight applies from the next round.
+     *
+     * @throws std::runtime_error If @p port is out of range or @p weight is zero.
+     */
+    void set_weight(std::size_t port, std::size_t weight) {
+        check_(port);
+        if (weight == 0)
+            throw std::runtime_error("arbiter weight must be positive");
+
+        ports_[port].weight = weight;
+    }
+
+    /** @brief Returns the number of ports. */
+    [[nodiscard]]
+    std::size_t ports() const noexcept {
+        return ports_.size();
+    }
+
+    /** @brief Returns the arbitration policy. */
+    [[nodiscard]]
+    arbiter_policy policy() const noexcept {
+        return policy_;
+    }
+
+    /** @brief Returns the cycle length in ticks. */
+    [[nodiscard]]
+    time_integral cycle() const noexcept {
+        return cycle_;
+    }
+
+    /** @brief Returns the number of grants that can be held at the same time. */
+    [[nodiscard]]
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    /** @brief Returns the number of grants currently held. */
+    [[nodiscard]]
+    std::size_t granted() const noexcept {
+        return capacity_ - free_;
+    }
+
+    /** @brief Returns the number of pending requests of @p port. */
+    [[nodiscard]]
+    std::size_t waiting(std::size_t port) const {
+        check_(port);
+        return ports_[port].requests.size();
+    }
+
+    /** @brief Returns the number of grants issued to @p port so far. */
+    [[nodiscard]]
+    std::uint64_t grants(std::size_t port) const {
+        check_(port);
+        return ports_[port].grants;
+    }
+
+    ~arbiter() {
+        if (pass_)
+            pass_->a = nullptr;
+
+        for (auto &p: ports_)
+            detail::discard_all(p.requests);
+    }
+
+private:
+    struct port_state {
+        detail::waiter_list requests;
+        std::size_t weight = 1;
+        std::size_t credit = 0;
+        std::uint64_t grants = 0;
+    };
+
+    struct request_awaitable: detail::waiter {
+        arbiter *a;
+        std::size_t port;
+        priority_type priority;
+
+        environment *env = nullptr;
+        std::uint64_t seq = 0;
+
+        request_awaitable(arbiter *a_, std::size_t port_, priority_type priority_):
+            a{a_}, port{port_}, priority{priority_} {
+        }
+
+        request_awaitable(request_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() const noexcept {
+            // grants are only decided by arbitration passes
+            return false;
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            seq = a->next_seq_++;
+            this->suspend_(a->ports_[port].requests, coro_data, 0, priority, "arbiter grant");
+            a->schedule_pass_(env);
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        grant await_resume() noexcept {
+            return grant{a, port};
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() const noexcept {
+            return false;
+        }
+
+        void select_register(detail::select_core *core, std::size_t index) {
+            seq = a->next_seq_++;
+            this->register_(a->ports_[port].requests, core, index, priority);
+            a->schedule_pass_(env);
+        }
+
+        void select_withdraw() noexcept {
+            this->discard_();
+        }
+
+        grant select_resume() noexcept {
+            return grant{a, port};
+        }
+    };
+
+    struct release_awaitable {
+        arbiter *a;
+
+        environment *env = nullptr;
+
+        void await_bind(environment *env_, priority_type) noexcept {
+            env = env_;
+        }
+
+        bool await_ready() {
+            ++a->free_;
+            a->schedule_pass_(env);
+            return true;
+        }
+
+        void await_suspend(coroutine_data_ptr) const noexcept {  }
+        token *await_token() const noexcept { return nullptr; }
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+    };
+
+    struct pass_handler: token_handler {
+        arbiter *a;
+        environment *env;
+
+        pass_handler(arbiter *a_, environment *env_): a{a_}, env{env_} {
+        }
+
+        void invoke(token *) override {
+            if (a)
+                a->pass_now_(env);
+        }
+    };
+
+    void check_(std::size_t port) const {
+        if (port >= ports_.size())
+            throw std::runtime_error("arbiter port is out of range");
+    }
+
+    bool pending_() const noexcept {
+        for (auto &p: ports_)
+            if (!p.requests.empty())
+                return true;
+        return false;
+    }
+
+    // schedules the pass of the next cycle that has not been arbitrated yet
+    void schedule_pass_(environment *env) {
+        if (pass_ || free_ == 0 || !pending_())
+            return ;
+
+        auto t = env->now() + (cycle_ - env->now() % cycle_) % cycle_;
+        if (arbitrated_ && t <= last_pass_)
+            t = last_pass_ + cycle_;
+
+        // after every other event of that time, so that all requests are gathered
+        auto tkn = new token(t, priority_consts::lowest, nullptr, "arbiter pass");
+        pass_ = new pass_handler{this, env};
+        tkn->handler = pass_.get();
+        env->schedule_token(tkn);
+    }
+
+    void pass_now_(environment *env) {
+        pass_ = nullptr;
+        arbitrated_ = true;
+        last_pass_ = env->now();
+
+        detail::wake_batch batch;
+        while (free_ > 0) {
+            auto port = pick_();
+            if (port == ports_.size())
+                break ;
+
+            auto &p = ports_[port];
+            --free_;
+            ++p.grants;
+            p.requests.pop_front()->notify_(env, batch);
+        }
+
+        batch.schedule(env);
+    }
+
+    // the winning port among those with pending requests, or ports() if none
+    std::size_t pick_() {
+        auto n = ports_.size();
+
+        switch (policy_) {
+        case arbiter_policy::round_robin:
+            for (std::size_t i = 0; i < n; ++i) {
+                auto port = (next_ + i) % n;
+                if (!ports_[port].requests.empty()) {
+                    next_ = (port + 1) % n;
+                    return port;
+                }
+            }
+            return n;
+
+        case arbiter_policy::fixed_priority:
+            for (std::size_t port = 0; port < n; ++port)
+                if (!ports_[port].requests.empty())
+                    return port;
+            return n;
+
+        case arbiter_policy::weighted:
+            for (int round = 0; round < 2; ++round) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto port = (next_ + i) % n;
+                    auto &p = ports_[port];
+                    if (!p.requests.empty() && p.credit > 0) {
+                        // stay on this port while it has credit left
+                        next_ = --p.credit > 0 ? port : (port + 1) % n;
+                        return port;
+                    }
+                }
+
+                // every requesting port used up its weight: start a new round
+                for (auto &p: ports_)
+                    p.credit = p.weight;
+            }
+            return n;
+
+        case arbiter_policy::age_based: {
+            auto best = n;
+            std::uint64_t best_seq = 0;
+            for (std::size_t port = 0; port < n; ++port) {
+                auto &requests = ports_[port].requests;
+                if (requests.empty())
+                    continue ;
+
+                auto seq = static_cast<request_awaitable *>(requests.front())->seq;
+                if (best == n || seq < best_seq) {
+                    best = port;
+                    best_seq = seq;
+                }
+            }
+            return best;
+        }
+        }
+
+        return n;
+    }
+
+    arbiter_policy policy_;
+    time_integral cycle_;
+    std::size_t capacity_;
+    std::size_t free_;
+
+    std::vector<port_state> ports_;
+    std::vector<port_view> views_;
+
+    std::size_t next_ = 0;
+    std::uint64_t next_seq_ = 0;
+
+    bool arbitrated_ = false;
+    time_integral last_pass_ = 0;
+    memory::ptr<pass_handler> pass_;
+};
+
+inline auto arbiter::port_view::acquire() {
+    return a_->request(port_);
+}
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_ARBITER_HPP_INCLUDED */
@@ -0,0 +1,243 @@
+/**
+ * @file barrier.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Reusable (cyclic) barrier.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_BARRIER_HPP_INCLUDED
+#define CXXDES_SYNC_BARRIER_HPP_INCLUDED
+
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/** @brief Default barrier completion function; does nothing. */
+struct barrier_no_completion {
+    constexpr void operator()() const noexcept {  }
+};
+
+/**
+ * @brief Reusable barrier for a fixed number of participating processes.
+ *
+ * Each phase completes when `expected()` processes have arrived. The last
+ * arrival runs the completion function, starts the next phase, and releases
+ * every waiter of the finished phase with one scheduled event per distinct
+ * latency. Earlier arrivals only register their waiters; they do not wake
+ * anyone.
+ *
+ * `arrive_and_wait_for()` and `arrive_and_wait_until()` give up at a deadline.
+ * A process that gives up, or whose wait is otherwise abandoned, withdraws its
+ * arrival, so the phase then needs another arrival to complete.
+ *
+ * The barrier owns the tokens of waiters still registered when it is
+ * destroyed.
+ *
+ * @tparam CompletionFunction Nullary callable invoked once per phase by the
+ *         last arriving process, before the waiters are released.
+ */
+template <typename CompletionFunction = barrier_no_completion>
+struct barrier {
+    /**
+     * @brief Constructs a barrier expecting @p expected arrivals per phase.
+     *
+     * @param expected Number of arrivals that complete a phase.
+     * @param completion Callable run by the last arrival of each phase.
+     */
+    explicit
+    barrier(std::size_t expected, CompletionFunction completion = {}):
+        expected_{expected}, remaining_{expected}, completion_{std::move(completion)} {
+    }
+
+    CXXDES_NOT_COPIABLE(barrier)
+    CXXDES_NOT_MOVABLE(barrier)
+
+    /**
+     * @brief Arrives at the barrier and waits until the current phase completes.
+     *
+     * The last arriving process does not suspend. The awaitable is also a
+     * selectable operation for `select`.
+     *
+     * @param latency Additional delay, in simulation ticks, applied after the
+     *        phase completes before this waiter resumes.
+     * @param priority Resume priority for this waiter, or
+     *        `priority_consts::inherit`.
+     * @throws std::runtime_error If no arrivals are expected.
+     */
+    [[nodiscard("expected usage: co_await barrier.arrive_and_wait()")]]
+    auto arrive_and_wait(time_integral latency = 0, priority_type priority = priority_consts::inherit) {
+        return arrive_awaitable{this, false, latency, priority};
+    }
+
+    /**
+     * @brief Like `arrive_and_wait()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await barrier.arrive_and_wait_for(d)")]]
+    auto arrive_and_wait_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(arrive_and_wait(0, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `arrive_and_wait()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await barrier.arrive_and_wait_until(t)")]]
+    auto arrive_and_wait_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(arrive_and_wait(0, priority), until(std::forward<T>(t)));
+    }
+
+    /**
+     * @brief Arrives at the barrier and leaves it for all later phases.
+     *
+     * The calling process never suspends. The expected count of the next
+     * phases is decremented by one.
+     *
+     * @throws std::runtime_error If no arrivals are expected.
+     */
+    [[nodiscard("expected usage: co_await barrier.arrive_and_drop()")]]
+    auto arrive_and_drop() {
+        return arrive_awaitable{this, true, 0, priority_consts::inherit};
+    }
+
+    /** @brief Returns the number of arrivals that complete the current phase. */
+    [[nodiscard]]
+    std::size_t expected() const noexcept {
+        return expected_;
+    }
+
+    /** @brief Returns the number of arrivals still missing in the current phase. */
+    [[nodiscard]]
+    std::size_t remaining() const noexcept {
+        return remaining_;
+    }
+
+    /** @brief Returns the number of processes blocked on the current phase. */
+    [[nodiscard]]
+    std::size_t waiting() const noexcept {
+        return waiters_.size();
+    }
+
+    /** @brief Returns the number of completed phases. */
+    [[nodiscard]]
+    std::size_t phase() const noexcept {
+        return phase_;
+    }
+
+    ~barrier() {
+        discard_all(waiters_);
+    }
+
+private:
+    struct arrive_awaitable: waiter {
+        barrier *b;
+        bool drop;
+        time_integral latency;
+        priority_type priority;
+
+        environment *env = nullptr;
+
+        arrive_awaitable(barrier *b_, bool drop_, time_integral latency_, priority_type priority_):
+            b{b_}, drop{drop_}, latency{latency_}, priority{priority_} {
+        }
+
+        arrive_awaitable(arrive_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit) {
+                priority = priority_;
+            }
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(b->waiters_, coro_data, latency, priority, "barrier phase complete");
+        }
+
+        token *await_token() const noexcept { return this->token_(); }
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        bool select_ready() {
+            return b->arrive_(env, drop) || drop;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(b->waiters_, core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            withdraw_();
+        }
+
+        void select_resume() const noexcept {  }
+
+        ~arrive_awaitable() {
+            withdraw_();
+        }
+
+    private:
+        void withdraw_() noexcept {
+            if (!this->linked())
+                return ;
+
+            this->discard_();
+            ++b->remaining_;
+        }
+    };
+
+    bool arrive_(environment *env, bool drop) {
+        if (remaining_ == 0)
+            throw std::runtime_error("arrived at a barrier that expects no arrivals");
+
+        if (drop)
+            --expected_;
+
+        if (--remaining_ > 0)
+            return false;
+
+        completion_();
+
+        ++phase_;
+        remaining_ = expected_;
+
+        wake_batch batch;
+        while (!waiters_.empty())
+            waiters_.pop_front()->notify_(env, batch);
+
+        batch.schedule(env);
+
+        return true;
+    }
+
+    std::size_t expected_;
+    std::size_t remaining_;
+    std::size_t phase_ = 0;
+    CompletionFunction completion_;
+
+    waiter_list waiters_;
+};
+
+} /* namespace detail */
+
+using detail::barrier;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_BARRIER_HPP_INCLUDED */
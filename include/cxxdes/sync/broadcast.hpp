@@ -0,0 +1,427 @@
+/**
+ * @file broadcast.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Publish-subscribe channel with shared messages.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_BROADCAST_HPP_INCLUDED
+#define CXXDES_SYNC_BROADCAST_HPP_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/misc/intrusive_list.hpp>
+#include <cxxdes/misc/reference_counted.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/store.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+/** @brief What a `broadcast` does when a subscriber falls `capacity()` messages behind. */
+enum class broadcast_policy {
+    /** @brief The oldest message is dropped; slow subscribers skip it. */
+    drop,
+
+    /** @brief `publish()` waits until the slowest subscriber reads the oldest message. */
+    block,
+
+    /** @brief The slowest subscribers are detached; their next `recv()` throws. */
+    lag_limit
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Channel delivering every published message to every subscriber.
+ *
+ * Each message is stored once, in a reference-counted node inside a ring of
+ * `capacity()` slots, and subscribers receive shared handles to it instead of
+ * copies. A subscriber is a cursor into the ring; it sees the messages
+ * published after it subscribed. A slot is released as soon as every
+ * subscriber has read its message, and a message outlives its slot for as
+ * long as a subscriber holds its handle.
+ *
+ * When the ring is full, the `broadcast_policy` decides: `drop` overwrites the
+ * oldest message, `block` makes `publish()` wait, and `lag_limit` detaches
+ * the subscribers that have not read the oldest message.
+ *
+ * A publish hands the message to all subscribers blocked in `recv()` and
+ * resumes them together with a single scheduled event, in the order they
+ * blocked. All operations are selectable, so they can be used with `select`
+ * and `timed`.
+ *
+ * @tparam T Message type.
+ */
+template <typename T>
+struct broadcast {
+private:
+    struct node: memory::reference_counted_base<node> {
+        T value;
+
+        node(T &&value_): value{std::move(value_)} {
+        }
+    };
+
+    struct recv_awaitable;
+    using put_awaitable = store_put_awaitable<broadcast, T>;
+
+public:
+    /** @brief Shared, read-only handle to a published message. */
+    struct message {
+        message() = default;
+
+        /** @brief Returns the message; the handle must not be empty. */
+        T const &operator*() const noexcept {
+            return p_->value;
+        }
+
+        /** @copydoc operator* */
+        T const *operator->() const noexcept {
+            return &p_->value;
+        }
+
+        /** @brief Returns whether this handle refers to a message. */
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(p_);
+        }
+
+        /** @brief Returns the number of handles and ring slots referring to the message. */
+        std::size_t use_count() const noexcept {
+            return p_ ? p_->ref_count() : 0;
+        }
+
+    private:
+        friend struct broadcast;
+
+        explicit message(memory::ptr<node> p): p_{std::move(p)} {
+        }
+
+        memory::ptr<node> p_;
+    };
+
+    /**
+     * @brief Cursor of one reader into a `broadcast`.
+     *
+     * Subscribers are created by `broadcast::subscribe()` and unsubscribe when
+     * they are destroyed. They must not outlive their broadcast.
+     */
+    struct subscriber: util::intrusive_list_node<subscriber> {
+        CXXDES_NOT_COPIABLE(subscriber)
+        CXXDES_NOT_MOVABLE(subscriber)
+
+        /**
+         * @brief Waits for the next message and returns a handle to it.
+         *
+         * @throws std::runtime_error If the subscriber was detached by the
+         *         `lag_limit` policy.
+         */
+        [[nodiscard("expected usage: co_await subscriber.recv()")]]
+        auto recv(priority_type priority = priority_consts::inherit) {
+            return recv_awaitable{this, priority};
+        }
+
+        /**
+         * @brief Like `recv()`, but gives up after @p d.
+         *
+         * @return A `timed_result<message>` that is empty on timeout.
+         */
+        template <typename D>
+        [[nodiscard("expected usage: co_await subscriber.recv_for(d)")]]
+        auto recv_for(D &&d, priority_type priority = priority_consts::inherit) {
+            return timed(recv(priority), delay(std::forward<D>(d)));
+        }
+
+        /** @brief Like `recv()`, but gives up at the absolute time @p t. */
+        template <typename U>
+        [[nodiscard("expected usage: co_await subscriber.recv_until(t)")]]
+        auto recv_until(U &&t, priority_type priority = priority_consts::inherit) {
+            return timed(recv(priority), until(std::forward<U>(t)));
+        }
+
+        /** @brief Returns the number of stored messages this subscriber has not read. */
+        std::size_t lag() const noexcept {
+            if (!b_ || detached_)
+                return 0;
+
+            return static_cast<std::size_t>(b_->tail_ - std::max(cursor_, b_->head_));
+        }
+
+        /** @brief Returns the number of messages this subscriber missed under `drop`. */
+        std::uint64_t dropped() const noexcept {
+            return dropped_;
+        }
+
+        /** @brief Returns whether the `lag_limit` policy detached this subscriber. */
+        bool detached() const noexcept {
+            return detached_;
+        }
+
+        ~subscriber() {
+            if (b_ && !detached_)
+                b_->unsubscribe_(this);
+        }
+
+    private:
+        friend struct broadcast;
+
+        subscriber(broadcast *b): b_{b}, cursor_{b->tail_} {
+            b_->subscribers_.push_back(this);
+        }
+
+        broadcast *b_;
+        std::uint64_t cursor_;
+        std::uint64_t dropped_ = 0;
+        bool detached_ = false;
+    };
+
+    /**
+     * @brief Constructs a broadcast with @p capacity ring slots.
+     *
+     * @throws std::runtime_error If @p capacity is zero.
+     */
+    broadcast(std::size_t capacity, broadcast_policy policy = broadcast_policy::block):
+        policy_{policy}, ring_(capacity), pending_(capacity) {
+        if (capacity == 0)
+            throw std::runtime_error("broadcast capacity must be positive");
+    }
+
+    CXXDES_NOT_COPIABLE(broadcast)
+    CXXDES_NOT_MOVABLE(broadcast)
+
+    /**
+     * @brief Publishes @p value to all current subscribers.
+     *
+     * Under the `block` policy, waits while the ring is full; otherwise
+     * completes immediately. A message published without subscribers is
+     * discarded.
+     */
+    [[nodiscard("expected usage: co_await broadcast.publish(value)")]]
+    auto publish(T value) {
+        return put_awaitable{this, std::move(value)};
+    }
+
+    /** @brief Returns a subscriber that receives the messages published from now on. */
+    [[nodiscard]]
+    subscriber subscribe() {
+        return subscriber{this};
+    }
+
+    /** @brief Returns the number of messages some subscriber has not read yet. */
+    std::size_t size() const noexcept {
+        return static_cast<std::size_t>(tail_ - head_);
+    }
+
+    /** @brief Returns the number of ring slots. */
+    std::size_t capacity() const noexcept {
+        return ring_.size();
+    }
+
+    /** @brief Returns the slow-consumer policy. */
+    broadcast_policy policy() const noexcept {
+        return policy_;
+    }
+
+    /** @brief Returns the number of attached subscribers. */
+    std::size_t subscribers() const noexcept {
+        return subscribers_.size();
+    }
+
+    /** @brief Returns the number of subscribers blocked in `recv()`. */
+    std::size_t waiting_subscribers() const noexcept {
+        return receivers_.size();
+    }
+
+    /** @brief Returns the number of processes blocked in `publish()`. */
+    std::size_t waiting_publishers() const noexcept {
+        return putters_.size();
+    }
+
+    ~broadcast() {
+        discard_all(receivers_);
+        discard_all(putters_);
+
+        while (!subscribers_.empty())
+            subscribers_.pop_front()->b_ = nullptr;
+    }
+
+private:
+    friend put_awaitable;
+
+    struct recv_awaitable: waiter {
+        subscriber *sub;
+        priority_type priority;
+        message value;
+
+        environment *env = nullptr;
+
+        recv_awaitable(subscriber *sub_, priority_type priority_):
+            sub{sub_}, priority{priority_} {
+        }
+
+        recv_awaitable(recv_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(sub->b_->receivers_, coro_data, 0, priority, "broadcast recv");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        message await_resume() {
+            return std::move(value);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() {
+            return sub->b_->take_(sub, value, env);
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(sub->b_->receivers_, core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            this->discard_();
+        }
+
+        message select_resume() {
+            return std::move(value);
+        }
+    };
+
+    std::size_t slot_(std::uint64_t seq) const noexcept {
+        return static_cast<std::size_t>(seq % ring_.size());
+    }
+
+    bool can_put() const noexcept {
+        return policy_ != broadcast_policy::block || size() < capacity();
+    }
+
+    void insert_(T &&value, environment *env) {
+        if (size() == capacity())
+            overflow_();
+
+        auto slot = slot_(tail_++);
+        ring_[slot] = memory::ptr<node>{new node{std::move(value)}};
+        pending_[slot] = subscribers_.size();
+
+        // blocked receivers have read everything else, so this is their message
+        wake_batch batch;
+        while (!receivers_.empty()) {
+            auto r = static_cast<recv_awaitable *>(receivers_.pop_front());
+            r->value = message{ring_[slot]};
+            ++r->sub->cursor_;
+            --pending_[slot];
+            r->notify_(env, batch);
+        }
+
+        batch.schedule(env);
+        release_();
+    }
+
+    // only reached under drop and lag_limit
+    void overflow_() {
+        if (policy_ == broadcast_policy::drop) {
+            // subscribers still behind the new head skip ahead on their next recv
+            ring_[slot_(head_++)] = nullptr;
+            return ;
+        }
+
+        for (auto sub = subscribers_.front(); sub; ) {
+            auto next = util::intrusive_list<subscriber>::next(sub);
+            if (sub->cursor_ <= head_) {
+                forget_(sub);
+                sub->detached_ = true;
+            }
+            sub = next;
+        }
+
+        release_();
+    }
+
+    bool take_(subscriber *sub, message &out, environment *env) {
+        if (sub->detached_)
+            throw std::runtime_error("broadcast subscriber fell behind the lag limit");
+
+        if (sub->cursor_ < head_) {
+            sub->dropped_ += head_ - sub->cursor_;
+            sub->cursor_ = head_;
+        }
+
+        if (sub->cursor_ == tail_)
+            return false;
+
+        auto slot = slot_(sub->cursor_++);
+        out = message{ring_[slot]};
+        --pending_[slot];
+
+        release_();
+        put_awaitable::admit(this, env);
+        return true;
+    }
+
+    // removes the unread messages of sub from the pending counts and unlinks it
+    void forget_(subscriber *sub) noexcept {
+        for (auto seq = std::max(sub->cursor_, head_); seq < tail_; ++seq)
+            --pending_[slot_(seq)];
+
+        sub->unlink();
+    }
+
+    void unsubscribe_(subscriber *sub) {
+        forget_(sub);
+        release_();
+
+        if (!putters_.empty())
+            put_awaitable::admit(this, static_cast<put_awaitable *>(putters_.front())->env);
+    }
+
+    // frees the oldest slots once every subscriber has read them
+    void release_() noexcept {
+        while (head_ < tail_ && pending_[slot_(head_)] == 0)
+            ring_[slot_(head_++)] = nullptr;
+    }
+
+    broadcast_policy policy_;
+
+    std::vector<memory::ptr<node>> ring_;
+    std::vector<std::size_t> pending_;
+    std::uint64_t head_ = 0;
+    std::uint64_t tail_ = 0;
+
+    util::intrusive_list<subscriber> subscribers_;
+    waiter_list receivers_;
+    waiter_list putters_;
+};
+
+} /* namespace detail */
+
+using detail::broadcast;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_BROADCAST_HPP_INCLUDED */
@@ -0,0 +1,422 @@
+/**
+ * @file container.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Container holding a continuous or discrete level.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_CONTAINER_HPP_INCLUDED
+#define CXXDES_SYNC_CONTAINER_HPP_INCLUDED
+
+#include <bit>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+/** @brief Order in which a `container` serves blocked operations. */
+enum class container_policy {
+    /** @brief Only the oldest blocked operation of each kind may complete. */
+    fifo,
+
+    /** @brief The oldest blocked operation of each kind that fits completes. */
+    first_fit
+};
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Level of a homogeneous quantity, such as a tank level or buffer bytes.
+ *
+ * `put(amount)` waits until @p amount fits below the capacity and adds it to
+ * the level; `get(amount)` waits until the level is at least @p amount and
+ * removes it. Both take the whole amount at once, so an operation costs the
+ * same whatever the amount is.
+ *
+ * Amounts are handed over directly: an operation that changes the level
+ * completes blocked operations for as long as they can be satisfied, so a
+ * woken process has already completed its operation when it resumes. With
+ * `container_policy::fifo`, operations never overtake earlier blocked
+ * operations of the same kind, and a large request holds back smaller ones
+ * behind it. With `container_policy::first_fit`, the oldest blocked
+ * operation whose amount fits completes; blocked operations are indexed by
+ * arrival in a min tree over their amounts, so it is found in logarithmic
+ * time.
+ *
+ * All operations are selectable, so they can be used with `select`, and
+ * `put_for()`, `put_until()`, `get_for()` and `get_until()` give up at a
+ * deadline.
+ *
+ * @tparam Amount Arithmetic type of the level.
+ */
+template <typename Amount = double>
+requires std::is_arithmetic_v<Amount>
+struct container {
+private:
+    struct op_awaitable;
+
+public:
+    /**
+     * @brief Constructs a container with a capacity, an initial level, and a policy.
+     *
+     * @throws std::runtime_error If @p level is negative or exceeds @p capacity.
+     */
+    container(
+        Amount capacity = std::numeric_limits<Amount>::max(),
+        Amount level = 0,
+        container_policy policy = container_policy::fifo):
+        capacity_{capacity}, level_{level}, policy_{policy} {
+        if (negative_(level_) || level_ > capacity_)
+            throw std::runtime_error("container level is out of range");
+    }
+
+    container(container const &) = delete;
+    container &operator=(container const &) = delete;
+
+    /**
+     * @brief Waits until @p amount fits below the capacity, then adds it.
+     *
+     * @throws std::runtime_error If @p amount is negative or exceeds the capacity.
+     */
+    [[nodiscard("expected usage: co_await container.put(amount)")]]
+    auto put(Amount amount, priority_type priority = priority_consts::inherit) {
+        check_(amount);
+        return op_awaitable{this, true, amount, priority};
+    }
+
+    /**
+     * @brief Waits until the level is at least @p amount, then removes it.
+     *
+     * @throws std::runtime_error If @p amount is negative or exceeds the capacity.
+     */
+    [[nodiscard("expected usage: co_await container.get(amount)")]]
+    auto get(Amount amount, priority_type priority = priority_consts::inherit) {
+        check_(amount);
+        return op_awaitable{this, false, amount, priority};
+    }
+
+    /**
+     * @brief Like `put()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout, in which case
+     *         the level was not changed.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await container.put_for(d, amount)")]]
+    auto put_for(D &&d, Amount amount, priority_type priority = priority_consts::inherit) {
+        return timed(put(amount, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `put()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await container.put_until(t, amount)")]]
+    auto put_until(T &&t, Amount amount, priority_type priority = priority_consts::inherit) {
+        return timed(put(amount, priority), until(std::forward<T>(t)));
+    }
+
+    /**
+     * @brief Like `get()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout, in which case
+     *         the level was not changed.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await container.get_for(d, amount)")]]
+    auto get_for(D &&d, Amount amount, priority_type priority = priority_consts::inherit) {
+        return timed(get(amount, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `get()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await container.get_until(t, amount)")]]
+    auto get_until(T &&t, Amount amount, priority_type priority = priority_consts::inherit) {
+        return timed(get(amount, priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the current level. */
+    Amount level() const noexcept {
+        return level_;
+    }
+
+    /** @brief Returns the capacity. */
+    Amount capacity() const noexcept {
+        return capacity_;
+    }
+
+    /** @brief Returns the waiter policy. */
+    container_policy policy() const noexcept {
+        return policy_;
+    }
+
+    /** @brief Returns the number of processes blocked in `get()`. */
+    std::size_t waiting_getters() const noexcept {
+        return getters_.size();
+    }
+
+    /** @brief Returns the number of processes blocked in `put()`. */
+    std::size_t waiting_putters() const noexcept {
+        return putters_.size();
+    }
+
+    ~container() {
+        discard_all(getters_);
+        discard_all(putters_);
+    }
+
+private:
+    // blocked operations in arrival order, with a min tree over their amounts
+    struct fit_index {
+        void insert(op_awaitable *op) {
+            if (next_ == slots_.size())
+                rebuild_();
+
+            op->slot = next_++;
+            slots_[op->slot] = op;
+            update_(op->slot, op->amount);
+        }
+
+        void erase(op_awaitable *op) noexcept {
+            slots_[op->slot] = nullptr;
+            update_(op->slot, empty_);
+        }
+
+        // the oldest operation with an amount of at most limit, if any
+        op_awaitable *first_fit(Amount limit) const noexcept {
+            auto n = slots_.size();
+            if (n == 0 || tree_[1] > limit)
+                return nullptr;
+
+            std::size_t i = 1;
+            while (i < n)
+                i = tree_[2 * i] <= limit ? 2 * i : 2 * i + 1;
+
+            return slots_[i - n];
+        }
+
+        // amount of an empty slot; no limit below it matches one
+        static constexpr Amount empty_ =
+            std::numeric_limits<Amount>::has_infinity ?
+            std::numeric_limits<Amount>::infinity() :
+            std::numeric_limits<Amount>::max();
+
+    private:
+        void update_(std::size_t slot, Amount amount) noexcept {
+            auto i = slot + slots_.size();
+            tree_[i] = amount;
+
+            for (i /= 2; i > 0; i /= 2)
+                tree_[i] = std::min(tree_[2 * i], tree_[2 * i + 1]);
+        }
+
+        // compacts the live operations to the front, growing the tree if needed
+        void rebuild_() {
+            std::vector<op_awaitable *> live;
+            for (std::size_t i = 0; i < next_; ++i)
+                if (slots_[i])
+                    live.push_back(slots_[i]);
+
+            auto n = std::bit_ceil(std::max<std::size_t>(8, 2 * live.size()));
+            slots_.assign(n, nullptr);
+            tree_.assign(2 * n, empty_);
+
+            for (std::size_t i = 0; i < live.size(); ++i) {
+                slots_[i] = live[i];
+                live[i]->slot = i;
+                tree_[n + i] = live[i]->amount;
+            }
+
+            for (auto i = n - 1; i > 0; --i)
+                tree_[i] = std::min(tree_[2 * i], tree_[2 * i + 1]);
+
+            next_ = live.size();
+        }
+
+        std::vector<op_awaitable *> slots_;
+        std::vector<Amount> tree_;
+        std::size_t next_ = 0;
+    };
+
+    struct op_awaitable: waiter {
+        container *c;
+        bool up;
+        Amount amount;
+        priority_type priority;
+
+        environment *env = nullptr;
+        std::size_t slot = 0;
+
+        op_awaitable(container *c_, bool up_, Amount amount_, priority_type priority_):
+            c{c_}, up{up_}, amount{amount_}, priority{priority_} {
+        }
+
+        op_awaitable(op_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(c->list_(up), coro_data, 0, priority, up ? "container put" : "container get");
+            c->index_(this);
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        bool select_ready() {
+            // blocked operations do not fit, so under first_fit a fitting one may pass them
+            if (c->policy_ == container_policy::fifo && !c->list_(up).empty())
+                return false;
+
+            if (!c->fits_(up, amount))
+                return false;
+
+            c->apply_(up, amount);
+            c->pump_(env);
+            return true;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(c->list_(up), core, index, priority);
+            c->index_(this);
+        }
+
+        void select_withdraw() noexcept {
+            withdraw_();
+        }
+
+        void select_resume() const noexcept {  }
+
+        ~op_awaitable() {
+            withdraw_();
+        }
+
+    private:
+        void withdraw_() noexcept {
+            if (!this->linked())
+                return ;
+
+            if (c->policy_ == container_policy::first_fit)
+                c->fit_(up).erase(this);
+
+            this->discard_();
+        }
+    };
+
+    void check_(Amount amount) const {
+        if (negative_(amount) || amount > capacity_)
+            throw std::runtime_error("container amount is out of range");
+    }
+
+    static bool negative_(Amount x) noexcept {
+        if constexpr (std::is_signed_v<Amount>)
+            return x < 0;
+        else
+            return false;
+    }
+
+    waiter_list &list_(bool up) noexcept {
+        return up ? putters_ : getters_;
+    }
+
+    fit_index &fit_(bool up) noexcept {
+        return up ? fit_putters_ : fit_getters_;
+    }
+
+    void index_(op_awaitable *op) {
+        if (policy_ == container_policy::first_fit)
+            fit_(op->up).insert(op);
+    }
+
+    bool fits_(bool up, Amount amount) const noexcept {
+        return up ? amount <= capacity_ - level_ : amount <= level_;
+    }
+
+    void apply_(bool up, Amount amount) noexcept {
+        if (up)
+            level_ += amount;
+        else
+            level_ -= amount;
+    }
+
+    // the next blocked operation of a kind to complete, if it fits
+    op_awaitable *next_(bool up) noexcept {
+        auto &list = list_(up);
+        if (list.empty())
+            return nullptr;
+
+        if (policy_ == container_policy::fifo) {
+            auto op = static_cast<op_awaitable *>(list.front());
+            return fits_(up, op->amount) ? op : nullptr;
+        }
+
+        auto limit = up ? capacity_ - level_ : level_;
+        if (limit >= fit_index::empty_) {
+            // everything fits, including what an empty slot would
+            return static_cast<op_awaitable *>(list.front());
+        }
+
+        return fit_(up).first_fit(limit);
+    }
+
+    // completes blocked operations until none of them fits
+    void pump_(environment *env) {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+
+            for (bool up: { false, true }) {
+                while (auto op = next_(up)) {
+                    if (policy_ == container_policy::first_fit)
+                        fit_(up).erase(op);
+
+                    op->unlink();
+                    apply_(up, op->amount);
+                    op->notify_(env);
+                    progress = true;
+                }
+            }
+        }
+    }
+
+    Amount capacity_;
+    Amount level_;
+    container_policy policy_;
+
+    waiter_list getters_;
+    waiter_list putters_;
+
+    fit_index fit_getters_;
+    fit_index fit_putters_;
+};
+
+} /* namespace detail */
+
+using detail::container;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_CONTAINER_HPP_INCLUDED */
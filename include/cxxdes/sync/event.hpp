@@ -3,17 +3,18 @@
  * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
  * @brief Synchronization primitive event.
  * @date 2022-04-12
- * 
+ *
  * Copyright (c) Canberk Sönmez 2022
- * 
+ *
  */
 
 #ifndef CXXDES_SYNC_EVENT_HPP_INCLUDED
 #define CXXDES_SYNC_EVENT_HPP_INCLUDED
 
-#include <vector>
 #include <stdexcept>
 #include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
 
 namespace cxxdes {
 namespace sync {
@@ -43,17 +44,15 @@ private:
     environment *env_ = nullptr;
 };
 
-struct wait_awaitable {
-    constexpr wait_awaitable(
+struct wait_awaitable: waiter {
+    wait_awaitable(
         event *evt,
         time_integral latency,
         priority_type priority = priority_consts::inherit):
         evt_{evt}, latency_{latency}, priority_{priority} {
     }
 
-    void await_bind(environment *env, priority_type priority) noexcept {
-        env_ = env;
-
+    void await_bind(environment *, priority_type priority) noexcept {
         if (priority_ == priority_consts::inherit) {
             priority_ = priority;
         }
@@ -61,14 +60,17 @@ struct wait_awaitable {
 
     bool await_ready() const noexcept { return false; }
     void await_suspend(coroutine_data_ptr coro_data);
-    token *await_token() const noexcept { return tkn_; }
+    token *await_token() const noexcept { return token_(); }
     void await_resume(no_return_value_tag = {}) const noexcept {  }
 
+    bool select_ready() const noexcept { return false; }
+    void select_register(select_core *core, std::size_t index);
+    void select_withdraw() noexcept { discard_(); }
+    void select_resume() const noexcept {  }
+
 private:
     event *evt_ = nullptr;
 
-    environment *env_ = nullptr;
-    token *tkn_ = nullptr;
     time_integral latency_;
     priority_type priority_;
 };
@@ -80,11 +82,16 @@ private:
  * waiters currently registered with the event. A wake does not persist; a
  * process that starts waiting after a wake must wait for a later wake.
  *
- * The event owns waiter tokens while processes are blocked on it, so the event
- * must outlive all blocked waiters unless the whole environment is being torn
- * down.
+ * `wait_for()` and `wait_until()` give up at a deadline. A waiter that gives
+ * up, or whose process is destroyed, is removed from the event right away.
+ * The event owns the tokens of waiters still registered when it is destroyed.
  */
 struct event {
+    event() = default;
+
+    event(event const &) = delete;
+    event &operator=(event const &) = delete;
+
     /**
      * @brief Returns an awaitable that wakes all current waiters.
      *
@@ -99,6 +106,8 @@ struct event {
     /**
      * @brief Returns an awaitable that waits for the next wake.
      *
+     * The awaitable is also a selectable operation for `select`.
+     *
      * @param latency Additional delay, in simulation ticks, applied after the
      *        wake time before this waiter resumes.
      * @param priority Resume priority for this waiter, or
@@ -109,33 +118,55 @@ struct event {
         return wait_awaitable(this, latency, priority);
     }
 
+    /**
+     * @brief Waits for the next wake for at most @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await event.wait_for(d)")]]
+    auto wait_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(wait(0, priority), delay(std::forward<D>(d)));
+    }
+
+    /**
+     * @brief Waits for the next wake until the absolute time @p t.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename T>
+    [[nodiscard("expected usage: co_await event.wait_until(t)")]]
+    auto wait_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(wait(0, priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the number of processes waiting on this event. */
+    [[nodiscard]]
+    std::size_t waiting() const noexcept {
+        return waiters_.size();
+    }
+
     ~event() {
-        for (auto tkn: tokens_)
-            delete tkn;
-        
-        tokens_.clear();
+        discard_all(waiters_);
     }
 private:
     friend struct wake_awaitable;
     friend struct wait_awaitable;
 
-    std::vector<token *> tokens_;
+    waiter_list waiters_;
 };
 
 inline bool wake_awaitable::await_ready() {
-    for (auto tkn: evt_->tokens_) {
-        tkn->time += env_->now();
-        env_->schedule_token(tkn);
-    }
-
-    evt_->tokens_.clear();
-
+    notify_all(evt_->waiters_, env_);
     return true;
 }
 
 inline void wait_awaitable::await_suspend(coroutine_data_ptr coro_data) {
-    tkn_ = new token(latency_, priority_, coro_data, "woke up");
-    evt_->tokens_.push_back(tkn_);
+    suspend_(evt_->waiters_, coro_data, latency_, priority_, "woke up");
+}
+
+inline void wait_awaitable::select_register(select_core *core, std::size_t index) {
+    register_(evt_->waiters_, core, index, priority_);
 }
 
 } /* namespace detail */
@@ -0,0 +1,438 @@
+/**
+ * @file filter_store.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Store whose consumers select items by key or predicate.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_FILTER_STORE_HPP_INCLUDED
+#define CXXDES_SYNC_FILTER_STORE_HPP_INCLUDED
+
+#include <deque>
+#include <limits>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/store.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+template <typename T, typename KeyOf>
+using filter_store_key_t = std::remove_cvref_t<std::invoke_result_t<KeyOf const &, T const &>>;
+
+/**
+ * @brief Item store whose consumers wait for a specific key or a predicate.
+ *
+ * Every item has a key computed by `KeyOf`. `get(key)` waits for the oldest
+ * item with that key, `get_if(pred)` waits for the oldest item satisfying
+ * `pred`, and `get()` waits for the oldest item. `put()` suspends while a
+ * bounded store is full; a `max_size` of zero means the store is unbounded.
+ *
+ * Stored items and blocked `get(key)` operations are indexed by key, so a
+ * new item is offered only to the waiters of its own key and to the
+ * `get_if()`/`get()` waiters; it goes to the oldest matching one, and no
+ * other waiter is woken. `put()` and `get(key)` take constant expected time
+ * plus the number of blocked `get_if()`/`get()` operations that are tested;
+ * `get_if()` and `get()` scan the stored items.
+ *
+ * All operations are selectable, so they can be used with `select` and
+ * `timed`.
+ *
+ * @tparam T Item type.
+ * @tparam KeyOf Function object computing the key of an item.
+ * @tparam Hash Hash function of the key type.
+ */
+template <
+    typename T,
+    typename KeyOf = std::identity,
+    typename Hash = std::hash<filter_store_key_t<T, KeyOf>>>
+struct filter_store {
+    using key_type = filter_store_key_t<T, KeyOf>;
+
+private:
+    struct get_waiter;
+
+    template <typename Derived>
+    struct get_base;
+
+    struct get_any_awaitable;
+    struct get_key_awaitable;
+
+    template <typename Predicate>
+    struct get_if_awaitable;
+
+    using put_awaitable = store_put_awaitable<filter_store, T>;
+
+public:
+    /** @brief Constructs an empty store; zero @p max_size means unbounded. */
+    filter_store(std::size_t max_size = 0 /* infinite */, KeyOf key_of = KeyOf{}):
+        max_size_{max_size}, key_of_{std::move(key_of)} {
+    }
+
+    filter_store(filter_store const &) = delete;
+    filter_store &operator=(filter_store const &) = delete;
+
+    /** @brief Waits for capacity and inserts @p item. */
+    [[nodiscard("expected usage: co_await store.put(item)")]]
+    auto put(T item) {
+        return put_awaitable{this, std::move(item)};
+    }
+
+    /** @brief Waits for any item and removes the oldest one. */
+    [[nodiscard("expected usage: co_await store.get()")]]
+    auto get() {
+        return get_any_awaitable{this};
+    }
+
+    /** @brief Waits for an item with key @p key and removes the oldest such item. */
+    [[nodiscard("expected usage: co_await store.get(key)")]]
+    auto get(key_type key) {
+        return get_key_awaitable{this, std::move(key)};
+    }
+
+    /**
+     * @brief Waits for an item satisfying @p pred and removes the oldest such item.
+     *
+     * @p pred is called with `T const &` on stored items and on items put
+     * while the operation is blocked.
+     */
+    template <typename Predicate>
+    [[nodiscard("expected usage: co_await store.get_if(pred)")]]
+    auto get_if(Predicate pred) {
+        return get_if_awaitable<Predicate>{this, std::move(pred)};
+    }
+
+    /** @brief Returns the number of stored items. */
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /** @brief Returns the number of stored items with key @p key. */
+    std::size_t count(key_type const &key) const {
+        auto it = items_.find(key);
+        return it == items_.end() ? 0 : it->second.size();
+    }
+
+    /** @brief Returns whether no items are stored. */
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /** @brief Returns the configured maximum size, or zero when unbounded. */
+    std::size_t max_size() const noexcept {
+        return max_size_;
+    }
+
+    /** @brief Returns whether this store has a finite capacity. */
+    bool bounded() const noexcept {
+        return max_size() > 0;
+    }
+
+    /** @brief Returns whether an item fits right now. */
+    bool can_put() const noexcept {
+        return !bounded() || size() < max_size();
+    }
+
+    /** @brief Returns the number of processes blocked in `get()`, `get(key)`, or `get_if()`. */
+    std::size_t waiting_getters() const noexcept {
+        auto n = filtered_.size();
+        for (auto &kv: keyed_)
+            n += kv.second.size();
+        return n;
+    }
+
+    /** @brief Returns the number of processes blocked in `put()`. */
+    std::size_t waiting_putters() const noexcept {
+        return putters_.size();
+    }
+
+    ~filter_store() {
+        for (auto &kv: keyed_)
+            discard_all(kv.second);
+
+        discard_all(filtered_);
+        discard_all(putters_);
+    }
+
+private:
+    friend put_awaitable;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct entry {
+        std::uint64_t seq;
+        T value;
+    };
+
+    using bucket = std::deque<entry>;
+
+    struct get_waiter: waiter {
+        std::uint64_t seq = 0;
+        std::optional<T> value;
+
+        virtual bool matches_(T const &item) const = 0;
+    };
+
+    template <typename Derived>
+    struct get_base: get_waiter {
+        filter_store *s;
+
+        environment *env = nullptr;
+        priority_type priority = priority_consts::inherit;
+
+        get_base(filter_store *s_): s{s_} {
+        }
+
+        get_base(get_base &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->seq = s->next_seq_++;
+            this->suspend_(derived().list_(), coro_data, 0, priority, "store get");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        T await_resume() {
+            return std::move(*this->value);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() {
+            // no stored item matches a blocked operation, so this cannot overtake one
+            if (!derived().claim_())
+                return false;
+
+            put_awaitable::admit(s, env);
+            return true;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->seq = s->next_seq_++;
+            this->register_(derived().list_(), core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            this->discard_();
+        }
+
+        T select_resume() {
+            return std::move(*this->value);
+        }
+
+    private:
+        Derived &derived() noexcept {
+            return static_cast<Derived &>(*this);
+        }
+    };
+
+    struct get_any_awaitable: get_base<get_any_awaitable> {
+        using get_base<get_any_awaitable>::get_base;
+
+        bool matches_(T const &) const override {
+            return true;
+        }
+
+        waiter_list &list_() {
+            return this->s->filtered_;
+        }
+
+        bool claim_() {
+            return this->s->take_first_([](T const &) { return true; }, this->value);
+        }
+    };
+
+    struct get_key_awaitable: get_base<get_key_awaitable> {
+        key_type key;
+
+        get_key_awaitable(filter_store *s_, key_type key_):
+            get_base<get_key_awaitable>{s_}, key{std::move(key_)} {
+        }
+
+        get_key_awaitable(get_key_awaitable &&) = default;
+
+        ~get_key_awaitable() {
+            withdraw_();
+        }
+
+        bool matches_(T const &item) const override {
+            return this->s->key_of_(item) == key;
+        }
+
+        waiter_list &list_() {
+            return this->s->keyed_[key];
+        }
+
+        void select_withdraw() noexcept {
+            withdraw_();
+        }
+
+        bool claim_() {
+            auto it = this->s->items_.find(key);
+            if (it == this->s->items_.end())
+                return false;
+
+            this->value.emplace(std::move(it->second.front().value));
+            this->s->erase_(it, 0);
+            return true;
+        }
+
+    private:
+        // the list of a key is dropped with its last waiter, so keys that
+        // time out do not accumulate
+        void withdraw_() noexcept {
+            if (!this->linked())
+                return ;
+
+            this->discard_();
+
+            auto it = this->s->keyed_.find(key);
+            if (it != this->s->keyed_.end() && it->second.empty())
+                this->s->keyed_.erase(it);
+        }
+    };
+
+    template <typename Predicate>
+    struct get_if_awaitable: get_base<get_if_awaitable<Predicate>> {
+        Predicate pred;
+
+        get_if_awaitable(filter_store *s_, Predicate pred_):
+            get_base<get_if_awaitable>{s_}, pred{std::move(pred_)} {
+        }
+
+        get_if_awaitable(get_if_awaitable &&) = default;
+
+        bool matches_(T const &item) const override {
+            return static_cast<bool>(std::invoke(pred, item));
+        }
+
+        waiter_list &list_() {
+            return this->s->filtered_;
+        }
+
+        bool claim_() {
+            return this->s->take_first_(pred, this->value);
+        }
+    };
+
+    // hands the item to the oldest matching waiter, or stores it
+    void insert_(T &&item, environment *env) {
+        auto key = key_of_(item);
+        get_waiter *best = nullptr;
+
+        // lists of keys are never empty
+        auto keyed = keyed_.find(key);
+        if (keyed != keyed_.end())
+            best = static_cast<get_waiter *>(keyed->second.front());
+
+        for (auto &w: filtered_) {
+            auto &g = static_cast<get_waiter &>(w);
+            if (best && g.seq > best->seq)
+                break ;
+
+            if (g.matches_(item)) {
+                best = &g;
+                break ;
+            }
+        }
+
+        if (best) {
+            best->unlink();
+
+            if (keyed != keyed_.end() && keyed->second.empty())
+                keyed_.erase(keyed);
+
+            best->value.emplace(std::move(item));
+            best->notify_(env);
+            return ;
+        }
+
+        items_[key].push_back(entry{ next_seq_++, std::move(item) });
+        ++size_;
+    }
+
+    template <typename Predicate>
+    bool take_first_(Predicate &&pred, std::optional<T> &out) {
+        typename decltype(items_)::iterator best;
+        std::size_t best_pos = npos;
+        std::uint64_t best_seq = 0;
+
+        for (auto it = items_.begin(); it != items_.end(); ++it) {
+            auto &b = it->second;
+            for (std::size_t i = 0; i < b.size(); ++i) {
+                // buckets are in arrival order
+                if (best_pos != npos && b[i].seq > best_seq)
+                    break ;
+
+                if (std::invoke(pred, std::as_const(b[i].value))) {
+                    best = it;
+                    best_pos = i;
+                    best_seq = b[i].seq;
+                    break ;
+                }
+            }
+        }
+
+        if (best_pos == npos)
+            return false;
+
+        out.emplace(std::move(best->second[best_pos].value));
+        erase_(best, best_pos);
+        return true;
+    }
+
+    void erase_(typename std::unordered_map<key_type, bucket, Hash>::iterator it, std::size_t pos) {
+        auto &b = it->second;
+        b.erase(b.begin() + static_cast<std::ptrdiff_t>(pos));
+
+        if (b.empty())
+            items_.erase(it);
+
+        --size_;
+    }
+
+    std::size_t max_size_;
+    KeyOf key_of_;
+
+    std::unordered_map<key_type, bucket, Hash> items_;
+    std::size_t size_ = 0;
+    std::uint64_t next_seq_ = 0;
+
+    std::unordered_map<key_type, waiter_list, Hash> keyed_;
+    waiter_list filtered_;
+    waiter_list putters_;
+};
+
+} /* namespace detail */
+
+using detail::filter_store;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_FILTER_STORE_HPP_INCLUDED */
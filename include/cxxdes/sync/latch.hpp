@@ -0,0 +1,232 @@
+/**
+ * @file latch.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Single-use countdown latch.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_LATCH_HPP_INCLUDED
+#define CXXDES_SYNC_LATCH_HPP_INCLUDED
+
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+struct latch;
+
+struct count_down_awaitable {
+    constexpr count_down_awaitable(latch *l, std::size_t n):
+        l_{l}, n_{n} {
+    }
+
+    void await_bind(environment *env, priority_type) noexcept {
+        env_ = env;
+    }
+
+    bool await_ready();
+    void await_suspend(coroutine_data_ptr) const noexcept {  }
+    token *await_token() const noexcept { return nullptr; }
+    void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+private:
+    latch *l_ = nullptr;
+    std::size_t n_;
+    environment *env_ = nullptr;
+};
+
+struct latch_wait_awaitable: waiter {
+    latch_wait_awaitable(
+        latch *l,
+        std::size_t n,
+        time_integral latency,
+        priority_type priority = priority_consts::inherit):
+        l_{l}, n_{n}, latency_{latency}, priority_{priority} {
+    }
+
+    void await_bind(environment *env, priority_type priority) noexcept {
+        env_ = env;
+
+        if (priority_ == priority_consts::inherit) {
+            priority_ = priority;
+        }
+    }
+
+    bool await_ready() { return select_ready(); }
+    void await_suspend(coroutine_data_ptr coro_data);
+    token *await_token() const noexcept { return token_(); }
+    void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+    bool select_ready();
+    void select_register(select_core *core, std::size_t index);
+    void select_withdraw() noexcept { discard_(); }
+    void select_resume() const noexcept {  }
+
+private:
+    latch *l_ = nullptr;
+    std::size_t n_;
+
+    environment *env_ = nullptr;
+    time_integral latency_;
+    priority_type priority_;
+};
+
+/**
+ * @brief Single-use countdown that releases its waiters when it reaches zero.
+ *
+ * `count_down()` never suspends. Only the call that brings the counter to zero
+ * releases the waiters, with one scheduled event per distinct latency; earlier
+ * calls wake no one. Once the counter is zero, `wait()` completes immediately.
+ *
+ * `wait_for()` and `wait_until()` give up at a deadline; a waiter that gives
+ * up is removed from the latch right away. Counting down is never undone.
+ *
+ * The latch owns the tokens of waiters still registered when it is destroyed.
+ */
+struct latch {
+    /** @brief Constructs a latch with @p count pending arrivals. */
+    explicit
+    latch(std::size_t count): count_{count} {
+    }
+
+    CXXDES_NOT_COPIABLE(latch)
+    CXXDES_NOT_MOVABLE(latch)
+
+    /**
+     * @brief Returns an awaitable that decrements the counter by @p n.
+     *
+     * @throws std::runtime_error If @p n is greater than the current counter.
+     */
+    [[nodiscard("expected usage: co_await latch.count_down()")]]
+    auto count_down(std::size_t n = 1) {
+        return count_down_awaitable(this, n);
+    }
+
+    /**
+     * @brief Returns an awaitable that waits until the counter reaches zero.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     *
+     * @param latency Additional delay, in simulation ticks, applied after the
+     *        release before this waiter resumes.
+     * @param priority Resume priority for this waiter, or
+     *        `priority_consts::inherit`.
+     */
+    [[nodiscard("expected usage: co_await latch.wait()")]]
+    auto wait(time_integral latency = 0, priority_type priority = priority_consts::inherit) {
+        return latch_wait_awaitable(this, 0, latency, priority);
+    }
+
+    /**
+     * @brief Waits until the counter reaches zero for at most @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await latch.wait_for(d)")]]
+    auto wait_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(wait(0, priority), delay(std::forward<D>(d)));
+    }
+
+    /**
+     * @brief Waits until the counter reaches zero, or until the absolute time @p t.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename T>
+    [[nodiscard("expected usage: co_await latch.wait_until(t)")]]
+    auto wait_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(wait(0, priority), until(std::forward<T>(t)));
+    }
+
+    /**
+     * @brief Decrements the counter by @p n and waits until it reaches zero.
+     *
+     * @throws std::runtime_error If @p n is greater than the current counter.
+     */
+    [[nodiscard("expected usage: co_await latch.arrive_and_wait()")]]
+    auto arrive_and_wait(
+        std::size_t n = 1,
+        time_integral latency = 0,
+        priority_type priority = priority_consts::inherit) {
+        return latch_wait_awaitable(this, n, latency, priority);
+    }
+
+    /** @brief Returns whether the counter has reached zero. */
+    [[nodiscard]]
+    bool try_wait() const noexcept {
+        return count_ == 0;
+    }
+
+    /** @brief Returns the current counter value. */
+    [[nodiscard]]
+    std::size_t count() const noexcept {
+        return count_;
+    }
+
+    ~latch() {
+        discard_all(waiters_);
+    }
+private:
+    friend struct count_down_awaitable;
+    friend struct latch_wait_awaitable;
+
+    void count_down_(environment *env, std::size_t n) {
+        if (n > count_)
+            throw std::runtime_error("latch counted down below zero");
+
+        if (n == 0)
+            return ;
+
+        count_ -= n;
+
+        if (count_ > 0)
+            return ;
+
+        wake_batch batch;
+        while (!waiters_.empty())
+            waiters_.pop_front()->notify_(env, batch);
+
+        batch.schedule(env);
+    }
+
+    std::size_t count_;
+    waiter_list waiters_;
+};
+
+inline bool count_down_awaitable::await_ready() {
+    l_->count_down_(env_, n_);
+    return true;
+}
+
+inline bool latch_wait_awaitable::select_ready() {
+    l_->count_down_(env_, n_);
+    return l_->try_wait();
+}
+
+inline void latch_wait_awaitable::select_register(select_core *core, std::size_t index) {
+    register_(l_->waiters_, core, index, priority_);
+}
+
+inline void latch_wait_awaitable::await_suspend(coroutine_data_ptr coro_data) {
+    suspend_(l_->waiters_, coro_data, latency_, priority_, "latch released");
+}
+
+} /* namespace detail */
+
+using detail::latch;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_LATCH_HPP_INCLUDED */
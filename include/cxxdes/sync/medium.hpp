@@ -0,0 +1,411 @@
+/**
+ * @file medium.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Shared transmission medium with collision detection and carrier sense.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_MEDIUM_HPP_INCLUDED
+#define CXXDES_SYNC_MEDIUM_HPP_INCLUDED
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/misc/intrusive_list.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Broadcast bus or radio channel shared by a set of nodes.
+ *
+ * Nodes have positions in the plane, and two nodes interfere when they are
+ * at most `range()` apart; with the default infinite range, the medium is a
+ * bus on which every node hears every other. A transmission collides when
+ * another interfering transmission overlaps it in time: beginning a
+ * transmission marks it and every interfering active transmission as
+ * collided, and `end_transmission()` reports whether it went through.
+ * `busy()` is carrier sense, and `wait_idle()` waits until it clears.
+ *
+ * Active transmissions and `wait_idle()` operations are kept in a uniform
+ * grid whose cells are `range()` wide, so a node only looks at the 3x3 cells
+ * around it. Each operation therefore costs the number of transmissions and
+ * waiters near the node, independent of the total number of nodes. On a bus,
+ * collisions are detected in constant time.
+ */
+struct medium {
+private:
+    struct node_state;
+    struct cell;
+    struct idle_awaitable;
+
+public:
+    /** @brief Identifier of a node of a medium. */
+    using node_id = std::size_t;
+
+    /** @brief Constructs a medium whose nodes interfere up to @p range apart. */
+    explicit medium(double range = std::numeric_limits<double>::infinity()):
+        range_{range}, bus_{std::isinf(range)} {
+        if (!(range > 0))
+            throw std::runtime_error("medium range must be positive");
+    }
+
+    CXXDES_NOT_COPIABLE(medium)
+    CXXDES_NOT_MOVABLE(medium)
+
+    /** @brief Adds a node at (@p x, @p y) and returns its identifier. */
+    node_id add_node(double x = 0, double y = 0) {
+        auto &n = nodes_.emplace_back();
+        n.id = nodes_.size() - 1;
+        place_(n, x, y);
+        return n.id;
+    }
+
+    /**
+     * @brief Moves node @p id to (@p x, @p y).
+     *
+     * @throws std::runtime_error If the node is transmitting or waiting.
+     */
+    void move_node(node_id id, double x, double y) {
+        auto &n = node_(id);
+        if (n.transmitting || n.waiters > 0)
+            throw std::runtime_error("medium cannot move a transmitting or waiting node");
+
+        place_(n, x, y);
+    }
+
+    /**
+     * @brief Starts a transmission of node @p id.
+     *
+     * The transmission, and every active transmission it interferes with,
+     * is marked as collided.
+     *
+     * @throws std::runtime_error If the node is already transmitting.
+     */
+    void begin_transmission(node_id id) {
+        auto &n = node_(id);
+        if (n.transmitting)
+            throw std::runtime_error("medium node is already transmitting");
+
+        n.transmitting = true;
+        n.collided = false;
+
+        if (bus_) {
+            // on a bus, two active transmissions have already collided with each other
+            auto &active = n.home->active;
+            if (active.size() == 1)
+                active.front()->collided = true;
+            n.collided = !active.empty();
+        }
+        else {
+            for_neighbors_(n, [&](cell &c) {
+                for (auto &other: c.active) {
+                    if (interferes_(n, other)) {
+                        n.collided = true;
+                        other.collided = true;
+                    }
+                }
+            });
+        }
+
+        n.home->active.push_back(&n);
+        ++transmissions_;
+    }
+
+    /**
+     * @brief Ends the transmission of node @p id.
+     *
+     * Resumes the `wait_idle()` operations of nodes whose carrier became idle.
+     *
+     * @return Whether the transmission completed without a collision.
+     * @throws std::runtime_error If the node is not transmitting.
+     */
+    bool end_transmission(node_id id) {
+        auto &n = node_(id);
+        if (!n.transmitting)
+            throw std::runtime_error("medium node is not transmitting");
+
+        n.transmitting = false;
+        n.unlink();
+
+        if (n.collided)
+            ++collisions_;
+
+        wake_batch batch;
+        environment *env = nullptr;
+
+        for_neighbors_(n, [&](cell &c) {
+            for (auto w = c.idle_waiters.front(); w; ) {
+                auto next = waiter_list::next(w);
+                auto &op = static_cast<idle_awaitable &>(*w);
+                if (!busy(op.id)) {
+                    env = op.env;
+                    op.unlink();
+                    op.release_();
+                    op.notify_(env, batch);
+                }
+                w = next;
+            }
+        });
+
+        if (env)
+            batch.schedule(env);
+
+        return !n.collided;
+    }
+
+    /** @brief Returns whether another transmission interfering with node @p id is active. */
+    bool busy(node_id id) const {
+        auto &n = node_(id);
+
+        if (bus_)
+            return n.home->active.size() > (n.transmitting ? 1u : 0u);
+
+        bool result = false;
+        for_neighbors_(n, [&](cell &c) {
+            for (auto &other: c.active) {
+                if (&other != &n && interferes_(n, other)) {
+                    result = true;
+                    return ;
+                }
+            }
+        });
+
+        return result;
+    }
+
+    /** @brief Returns whether node @p id is transmitting. */
+    bool transmitting(node_id id) const {
+        return node_(id).transmitting;
+    }
+
+    /** @brief Returns whether the current transmission of node @p id has collided. */
+    bool collided(node_id id) const {
+        return node_(id).collided;
+    }
+
+    /**
+     * @brief Waits until the carrier at node @p id is idle.
+     *
+     * Completes immediately if `busy(id)` is false. The awaitable is also a
+     * selectable operation for `select`.
+     */
+    [[nodiscard("expected usage: co_await medium.wait_idle(id)")]]
+    auto wait_idle(node_id id, priority_type priority = priority_consts::inherit) {
+        return idle_awaitable{this, id, priority};
+    }
+
+    /**
+     * @brief Like `wait_idle()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await medium.wait_idle_for(d, id)")]]
+    auto wait_idle_for(D &&d, node_id id, priority_type priority = priority_consts::inherit) {
+        return timed(wait_idle(id, priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `wait_idle()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await medium.wait_idle_until(t, id)")]]
+    auto wait_idle_until(T &&t, node_id id, priority_type priority = priority_consts::inherit) {
+        return timed(wait_idle(id, priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the interference range. */
+    double range() const noexcept {
+        return range_;
+    }
+
+    /** @brief Returns the number of nodes. */
+    std::size_t nodes() const noexcept {
+        return nodes_.size();
+    }
+
+    /** @brief Returns the number of transmissions begun so far. */
+    std::size_t transmissions() const noexcept {
+        return transmissions_;
+    }
+
+    /** @brief Returns the number of transmissions that ended collided. */
+    std::size_t collisions() const noexcept {
+        return collisions_;
+    }
+
+    ~medium() {
+        for (auto &kv: cells_)
+            discard_all(kv.second.idle_waiters);
+    }
+
+private:
+    struct node_state: util::intrusive_list_node<node_state> {
+        node_id id = 0;
+        double x = 0;
+        double y = 0;
+        std::int64_t cx = 0;
+        std::int64_t cy = 0;
+        cell *home = nullptr;
+        bool transmitting = false;
+        bool collided = false;
+        std::size_t waiters = 0;
+    };
+
+    struct cell {
+        util::intrusive_list<node_state> active;
+        waiter_list idle_waiters;
+    };
+
+    struct idle_awaitable: waiter {
+        medium *m;
+        node_id id;
+        priority_type priority;
+
+        environment *env = nullptr;
+
+        idle_awaitable(medium *m_, node_id id_, priority_type priority_):
+            m{m_}, id{id_}, priority{priority_} {
+        }
+
+        idle_awaitable(idle_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(list_(), coro_data, 0, priority, "medium wait idle");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        bool select_ready() {
+            return !m->busy(id);
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(list_(), core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            if (this->linked())
+                release_();
+            this->discard_();
+        }
+
+        void select_resume() const noexcept {  }
+
+        // forgets the waiter count of the node once the waiter is unlinked
+        void release_() noexcept {
+            --m->nodes_[id].waiters;
+        }
+
+        ~idle_awaitable() {
+            if (this->linked())
+                release_();
+        }
+
+    private:
+        waiter_list &list_() {
+            auto &n = m->node_(id);
+            ++n.waiters;
+            return n.home->idle_waiters;
+        }
+    };
+
+    node_state &node_(node_id id) {
+        if (id >= nodes_.size())
+            throw std::runtime_error("medium node does not exist");
+        return nodes_[id];
+    }
+
+    node_state const &node_(node_id id) const {
+        if (id >= nodes_.size())
+            throw std::runtime_error("medium node does not exist");
+        return nodes_[id];
+    }
+
+    static std::uint64_t key_(std::int64_t cx, std::int64_t cy) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+            static_cast<std::uint32_t>(cy);
+    }
+
+    void place_(node_state &n, double x, double y) {
+        n.x = x;
+        n.y = y;
+
+        if (!bus_) {
+            n.cx = static_cast<std::int64_t>(std::floor(x / range_));
+            n.cy = static_cast<std::int64_t>(std::floor(y / range_));
+        }
+
+        n.home = &cells_[key_(n.cx, n.cy)];
+    }
+
+    template <typename F>
+    void for_neighbors_(node_state const &n, F &&f) const {
+        if (bus_) {
+            f(*n.home);
+            return ;
+        }
+
+        for (auto dx = -1; dx <= 1; ++dx) {
+            for (auto dy = -1; dy <= 1; ++dy) {
+                auto it = cells_.find(key_(n.cx + dx, n.cy + dy));
+                if (it != cells_.end())
+                    f(it->second);
+            }
+        }
+    }
+
+    bool interferes_(node_state const &a, node_state const &b) const noexcept {
+        auto dx = a.x - b.x;
+        auto dy = a.y - b.y;
+        return dx * dx + dy * dy <= range_ * range_;
+    }
+
+    double range_;
+    bool bus_;
+
+    std::deque<node_state> nodes_;
+
+    // cells are never erased, so nodes can point to their home cell
+    mutable std::unordered_map<std::uint64_t, cell> cells_;
+
+    std::size_t transmissions_ = 0;
+    std::size_t collisions_ = 0;
+};
+
+} /* namespace detail */
+
+using detail::medium;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_MEDIUM_HPP_INCLUDED */
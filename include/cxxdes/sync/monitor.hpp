@@ -0,0 +1,285 @@
+/**
+ * @file monitor.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Monitor policies recording the statistics of synchronization primitives.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_MONITOR_HPP_INCLUDED
+#define CXXDES_SYNC_MONITOR_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <concepts>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/stats/tally.hpp>
+#include <cxxdes/stats/tdigest.hpp>
+#include <cxxdes/stats/time_weighted.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Monitor policy that records nothing; the default of every primitive.
+ *
+ * Its hooks are empty and its state is empty, so a primitive using it has the
+ * same size and code as one without a monitor.
+ */
+struct unmonitored {
+    static constexpr bool enabled = false;
+
+    /** @brief State kept by each operation between its arrival and its completion. */
+    struct ticket {  };
+
+    ticket on_arrival(environment *) noexcept { return {}; }
+    void on_served(environment *, ticket) noexcept {  }
+    void on_balk() noexcept {  }
+    void on_timeout() noexcept {  }
+    void on_level(environment *, double) noexcept {  }
+};
+
+struct monitor_registry;
+
+/**
+ * @brief Monitor policy that records the operations on a primitive.
+ *
+ * An arrival is an operation that may wait: a put or pop of a `queue`, an up
+ * or down of a `semaphore`, or an acquisition of a `mutex` or `resource`.
+ * The monitor records
+ *
+ * - the number of arrivals,
+ * - the number of balks, operations that were refused instead of waiting,
+ *   such as a `queue::try_put()` into a full queue,
+ * - the number of timeouts, waiting operations that gave up, because the
+ *   deadline of a timed wait passed or another operation of a `select` won,
+ * - the waiting time of every completed operation, zero for those that did
+ *   not wait, in model units,
+ * - and the level of the primitive over time: the number of stored items of a
+ *   queue, the count of a semaphore, the available units of a resource, and
+ *   whether a mutex is acquired.
+ *
+ * The statistics are allocated by the constructor, and updates never
+ * allocate. The level is averaged from the first operation on, as the
+ * primitive learns its environment from its operations.
+ */
+struct monitored {
+    static constexpr bool enabled = true;
+
+    using ticket = time_integral;
+
+    monitored() = default;
+
+    CXXDES_NOT_COPIABLE(monitored)
+    CXXDES_NOT_MOVABLE(monitored)
+
+    ~monitored();
+
+    ticket on_arrival(environment *env) noexcept {
+        ++arrivals_;
+        return env->now();
+    }
+
+    void on_served(environment *env, ticket since) noexcept {
+        auto x = static_cast<double>(env->now() - since) / static_cast<double>(env->real_to_sim(1));
+        waits_.add(x);
+        wait_quantiles_.add(x);
+    }
+
+    void on_balk() noexcept {
+        ++balks_;
+    }
+
+    void on_timeout() noexcept {
+        ++timeouts_;
+    }
+
+    void on_level(environment *env, double x) noexcept {
+        if (level_)
+            level_->set(x);
+        else
+            level_.emplace(*env, x);
+    }
+
+    /** @brief Returns the number of operations that may wait. */
+    std::uint64_t arrivals() const noexcept {
+        return arrivals_;
+    }
+
+    /** @brief Returns the number of operations refused instead of waiting. */
+    std::uint64_t balks() const noexcept {
+        return balks_;
+    }
+
+    /** @brief Returns the number of waiting operations that gave up. */
+    std::uint64_t timeouts() const noexcept {
+        return timeouts_;
+    }
+
+    /** @brief Returns the waiting times of the completed operations, in model units. */
+    stats::tally const &waits() const noexcept {
+        return waits_;
+    }
+
+    /** @brief Returns the quantiles of the waiting times, in model units. */
+    stats::tdigest const &wait_quantiles() const noexcept {
+        return wait_quantiles_;
+    }
+
+    /** @brief Returns whether the level was recorded, which it is from the first operation on. */
+    bool has_level() const noexcept {
+        return level_.has_value();
+    }
+
+    /**
+     * @brief Returns the level of the primitive over time.
+     *
+     * @throws std::runtime_error If no operation recorded the level yet.
+     */
+    stats::time_weighted const &level() const {
+        if (!level_)
+            throw std::runtime_error("monitored primitive has not recorded its level yet");
+
+        return *level_;
+    }
+
+    /** @brief Forgets the operations so far and restarts the level average now, for instance after a warm-up period. */
+    void reset() noexcept {
+        arrivals_ = 0;
+        balks_ = 0;
+        timeouts_ = 0;
+        waits_.reset();
+        wait_quantiles_.reset();
+
+        if (level_)
+            level_->reset();
+    }
+
+private:
+    friend struct monitor_registry;
+
+    std::uint64_t arrivals_ = 0;
+    std::uint64_t balks_ = 0;
+    std::uint64_t timeouts_ = 0;
+    stats::tally waits_;
+    stats::tdigest wait_quantiles_;
+    std::optional<stats::time_weighted> level_;
+
+    monitor_registry *registry_ = nullptr;
+};
+
+/**
+ * @brief Named collection of monitored primitives, for end-of-run reports.
+ *
+ * The registry refers to the monitors of its primitives; a primitive that is
+ * destroyed leaves the registry, and a destroyed registry releases its
+ * primitives.
+ */
+struct monitor_registry {
+    /** @brief A registered monitor. */
+    struct entry {
+        std::string name;
+        monitored *monitor;
+    };
+
+    monitor_registry() = default;
+
+    CXXDES_NOT_COPIABLE(monitor_registry)
+    CXXDES_NOT_MOVABLE(monitor_registry)
+
+    /**
+     * @brief Registers the monitor of @p primitive under @p name.
+     *
+     * @throws std::runtime_error If the monitor is already in a registry.
+     */
+    template <typename Primitive>
+        requires requires (Primitive &p) { { p.monitor() } -> std::same_as<monitored &>; }
+    void add(std::string name, Primitive &primitive) {
+        add(std::move(name), primitive.monitor());
+    }
+
+    /** @copydoc add(std::string, Primitive &) */
+    void add(std::string name, monitored &m) {
+        if (m.registry_)
+            throw std::runtime_error("monitor is already registered");
+
+        entries_.push_back(entry{std::move(name), &m});
+        m.registry_ = this;
+    }
+
+    /** @brief Returns the registered monitors, in order of registration. */
+    std::vector<entry> const &entries() const noexcept {
+        return entries_;
+    }
+
+    /** @brief Returns the number of registered monitors. */
+    std::size_t size() const noexcept {
+        return entries_.size();
+    }
+
+    /** @brief Resets every registered monitor. */
+    void reset() noexcept {
+        for (auto &e: entries_)
+            e.monitor->reset();
+    }
+
+    /**
+     * @brief Formats a table with one row per registered monitor.
+     *
+     * The columns are the counts, the mean and maximum level, and the mean,
+     * 99th percentile, and maximum waiting time.
+     */
+    std::string report() const {
+        auto out = fmt::format(
+            "{:<20} {:>10} {:>8} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+            "name", "arrivals", "balks", "timeouts", "level", "max level", "wait", "p99 wait", "max wait");
+
+        for (auto const &e: entries_) {
+            auto const &m = *e.monitor;
+            auto level = m.has_level() ? m.level().mean() : 0.0;
+            auto max_level = m.has_level() ? m.level().max() : 0.0;
+            auto max_wait = m.waits().count() > 0 ? m.waits().max() : 0.0;
+
+            out += fmt::format(
+                "{:<20} {:>10} {:>8} {:>8} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}\n",
+                e.name, m.arrivals(), m.balks(), m.timeouts(),
+                level, max_level, m.waits().mean(), m.wait_quantiles().quantile(0.99), max_wait);
+        }
+
+        return out;
+    }
+
+    ~monitor_registry() {
+        for (auto &e: entries_)
+            e.monitor->registry_ = nullptr;
+    }
+
+private:
+    friend struct monitored;
+
+    void remove_(monitored *m) noexcept {
+        std::erase_if(entries_, [m](entry const &e) { return e.monitor == m; });
+    }
+
+    std::vector<entry> entries_;
+};
+
+inline monitored::~monitored() {
+    if (registry_)
+        registry_->remove_(this);
+}
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_MONITOR_HPP_INCLUDED */
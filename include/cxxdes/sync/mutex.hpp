@@ -3,18 +3,20 @@
  * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
  * @brief Mutex.
  * @date 2022-04-13
- * 
+ *
  * Copyright (c) Canberk Sönmez 2022
- * 
+ *
  */
 
 #ifndef CXXDES_SYNC_MUTEX_HPP_INCLUDED
 #define CXXDES_SYNC_MUTEX_HPP_INCLUDED
 
-#include <queue>
-#include <cxxdes/sync/event.hpp>
+#include <stdexcept>
 #include <cxxdes/core/core.hpp>
 #include <cxxdes/misc/utils.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+#include <cxxdes/sync/monitor.hpp>
 
 namespace cxxdes {
 namespace sync {
@@ -27,8 +29,19 @@ using namespace cxxdes::core;
  * `acquire()` suspends until the mutex is free and returns a move-only handle.
  * The handle must be released with `co_await handle.release()`; destroying the
  * handle does not release the mutex.
+ *
+ * Ownership is handed over at release time to the blocked process with the
+ * highest priority, or the oldest one among equal priorities. `acquire_for()`
+ * and `acquire_until()` give up at a deadline; a process that gives up is
+ * removed from the mutex right away.
+ *
+ * With the `monitored` policy, the mutex records its acquisitions, their
+ * waiting times, and whether it is acquired over time; see `monitor()`.
+ *
+ * @tparam Monitor Monitor policy, `unmonitored` or `monitored`.
  */
-struct mutex {
+template <typename Monitor = unmonitored>
+struct basic_mutex {
     /**
      * @brief Move-only token representing ownership of a `mutex`.
      *
@@ -62,40 +75,60 @@ struct mutex {
         }
 
         /**
-         * @brief Releases the owned mutex and wakes waiters.
+         * @brief Releases the owned mutex and hands it over to the next waiter.
          *
          * @throws std::runtime_error If the handle is invalid.
          */
         [[nodiscard("expected usage: co_await handle.release()")]]
-        subroutine<> release() {
+        auto release() {
             if (!valid())
                 throw std::runtime_error("called release() on invalid mutex handle");
-            
+
             auto x = x_;
             x_ = nullptr;
 
-            x->owned_ = false;
-            co_await x->event_.wake();
+            return release_awaitable{x};
         }
     private:
-        friend struct mutex;
+        friend struct basic_mutex;
 
-        handle(mutex *x): x_{x} {
+        handle(basic_mutex *x): x_{x} {
         }
 
-        mutex *x_ = nullptr;
+        basic_mutex *x_ = nullptr;
     };
 
-    /** @brief Waits until the mutex is free and returns an ownership handle. */
+    basic_mutex() = default;
+
+    CXXDES_NOT_COPIABLE(basic_mutex)
+    CXXDES_NOT_MOVABLE(basic_mutex)
+
+    /**
+     * @brief Waits until the mutex is free and returns an ownership handle.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     */
     [[nodiscard("expected usage: co_await mtx.acquire()")]]
-    subroutine<handle> acquire() {
-        while (true) {
-            if (!owned_)
-                break ;
-            co_await event_.wait();
-        }
-        owned_ = true;
-        co_return handle(this);
+    auto acquire(priority_type priority = priority_consts::inherit) {
+        return acquire_awaitable{this, priority};
+    }
+
+    /**
+     * @brief Like `acquire()`, but gives up after @p d.
+     *
+     * @return A `timed_result<handle>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await mtx.acquire_for(d)")]]
+    auto acquire_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(acquire(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `acquire()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await mtx.acquire_until(t)")]]
+    auto acquire_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(acquire(priority), until(std::forward<T>(t)));
     }
 
     /** @brief Returns whether the mutex is currently acquired. */
@@ -104,11 +137,131 @@ struct mutex {
         return owned_;
     }
 
+    /** @brief Returns the number of processes waiting for the mutex. */
+    [[nodiscard]]
+    std::size_t waiting() const noexcept {
+        return waiters_.size();
+    }
+
+    /** @brief Returns the monitor of this mutex. */
+    Monitor &monitor() noexcept {
+        return monitor_;
+    }
+
+    /** @copydoc monitor() */
+    Monitor const &monitor() const noexcept {
+        return monitor_;
+    }
+
+    ~basic_mutex() {
+        detail::discard_all(waiters_);
+    }
+
 private:
+    struct acquire_awaitable: detail::waiter {
+        basic_mutex *x;
+        priority_type priority;
+
+        environment *env = nullptr;
+        [[no_unique_address]] typename Monitor::ticket ticket{};
+
+        acquire_awaitable(basic_mutex *x_, priority_type priority_):
+            x{x_}, priority{priority_} {
+        }
+
+        acquire_awaitable(acquire_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() noexcept {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(x->waiters_, coro_data, 0, priority, "mutex acquired", true);
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        handle await_resume() noexcept {
+            return handle(x);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() noexcept {
+            ticket = x->monitor_.on_arrival(env);
+
+            if (x->owned_)
+                return false;
+
+            x->owned_ = true;
+            x->monitor_.on_served(env, ticket);
+            x->monitor_.on_level(env, 1);
+            return true;
+        }
+
+        void select_register(detail::select_core *core, std::size_t index) {
+            this->register_(x->waiters_, core, index, priority, true);
+        }
+
+        void select_withdraw() noexcept {
+            if (this->linked())
+                x->monitor_.on_timeout();
+
+            this->discard_();
+        }
+
+        handle select_resume() noexcept {
+            return handle(x);
+        }
+    };
+
+    struct release_awaitable {
+        basic_mutex *x;
+
+        environment *env = nullptr;
+
+        void await_bind(environment *env_, priority_type) noexcept {
+            env = env_;
+        }
+
+        bool await_ready() {
+            // the mutex stays owned when it is handed over
+            if (x->waiters_.empty()) {
+                x->owned_ = false;
+                x->monitor_.on_level(env, 0);
+            }
+            else {
+                auto next = static_cast<acquire_awaitable *>(x->waiters_.front());
+                x->monitor_.on_served(env, next->ticket);
+                detail::notify_one(x->waiters_, env);
+            }
+
+            return true;
+        }
+
+        void await_suspend(coroutine_data_ptr) const noexcept {  }
+        token *await_token() const noexcept { return nullptr; }
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+    };
+
     bool owned_ = false;
-    sync::event event_;
+    detail::waiter_list waiters_;
+
+    [[no_unique_address]] Monitor monitor_;
 };
 
+/** @brief Mutex without a monitor. */
+using mutex = basic_mutex<>;
+
 } /* namespace sync */
 } /* namespace cxxdes */
 
@@ -0,0 +1,235 @@
+/**
+ * @file priority_store.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Store that returns items in priority order.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_PRIORITY_STORE_HPP_INCLUDED
+#define CXXDES_SYNC_PRIORITY_STORE_HPP_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/store.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Item store whose `get()` returns the first item in `Compare` order.
+ *
+ * Items are kept in a binary heap, so `put()` and `get()` take logarithmic
+ * time. With the default `std::less<T>`, the smallest item is returned
+ * first; equal items are returned in insertion order. `get()` suspends while
+ * the store is empty, and `put()` suspends while a bounded store is full.
+ * A `max_size` of zero means the store is unbounded.
+ *
+ * Items are handed over directly: a `put()` that finds a blocked `get()`
+ * gives it the item, and a `get()` that frees a slot admits the oldest
+ * blocked `put()`. Both operations are selectable, so they can be used with
+ * `select` and `timed`.
+ *
+ * @tparam T Item type.
+ * @tparam Compare Strict weak ordering; the first item in this order is
+ *         returned first.
+ */
+template <typename T, typename Compare = std::less<T>>
+struct priority_store {
+private:
+    struct get_awaitable;
+    using put_awaitable = store_put_awaitable<priority_store, T>;
+
+public:
+    /** @brief Constructs an empty store; zero @p max_size means unbounded. */
+    priority_store(std::size_t max_size = 0 /* infinite */, Compare compare = Compare{}):
+        max_size_{max_size}, compare_{std::move(compare)} {
+        if (max_size_ > 0)
+            heap_.reserve(max_size_);
+    }
+
+    priority_store(priority_store const &) = delete;
+    priority_store &operator=(priority_store const &) = delete;
+
+    /** @brief Waits for capacity and inserts @p item. */
+    [[nodiscard("expected usage: co_await store.put(item)")]]
+    auto put(T item) {
+        return put_awaitable{this, std::move(item)};
+    }
+
+    /** @brief Waits for an item and removes the first one in `Compare` order. */
+    [[nodiscard("expected usage: co_await store.get()")]]
+    auto get() {
+        return get_awaitable{this};
+    }
+
+    /** @brief Returns the first item in `Compare` order; the store must not be empty. */
+    T const &top() const noexcept {
+        return heap_.front().value;
+    }
+
+    /** @brief Returns the number of stored items. */
+    std::size_t size() const noexcept {
+        return heap_.size();
+    }
+
+    /** @brief Returns whether no items are stored. */
+    bool empty() const noexcept {
+        return heap_.empty();
+    }
+
+    /** @brief Returns the configured maximum size, or zero when unbounded. */
+    std::size_t max_size() const noexcept {
+        return max_size_;
+    }
+
+    /** @brief Returns whether this store has a finite capacity. */
+    bool bounded() const noexcept {
+        return max_size() > 0;
+    }
+
+    /** @brief Returns whether an item fits right now. */
+    bool can_put() const noexcept {
+        return !bounded() || size() < max_size();
+    }
+
+    /** @brief Returns the number of processes blocked in `get()`. */
+    std::size_t waiting_getters() const noexcept {
+        return getters_.size();
+    }
+
+    /** @brief Returns the number of processes blocked in `put()`. */
+    std::size_t waiting_putters() const noexcept {
+        return putters_.size();
+    }
+
+    ~priority_store() {
+        discard_all(getters_);
+        discard_all(putters_);
+    }
+
+private:
+    friend put_awaitable;
+
+    struct entry {
+        T value;
+        std::uint64_t seq;
+    };
+
+    struct get_awaitable: waiter {
+        priority_store *s;
+        std::optional<T> value;
+
+        environment *env = nullptr;
+        priority_type priority = priority_consts::inherit;
+
+        get_awaitable(priority_store *s_): s{s_} {
+        }
+
+        get_awaitable(get_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(s->getters_, coro_data, 0, priority, "store get");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        T await_resume() {
+            return std::move(*value);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() {
+            if (s->empty())
+                return false;
+
+            value.emplace(s->take_());
+            put_awaitable::admit(s, env);
+            return true;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(s->getters_, core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            this->discard_();
+        }
+
+        T select_resume() {
+            return std::move(*value);
+        }
+    };
+
+    // heap order: the root is the first item in Compare order, oldest first among equals
+    bool after_(entry const &a, entry const &b) const {
+        if (compare_(b.value, a.value))
+            return true;
+        if (compare_(a.value, b.value))
+            return false;
+        return a.seq > b.seq;
+    }
+
+    void insert_(T &&item, environment *env) {
+        if (!getters_.empty()) {
+            // getters only wait while the store is empty
+            auto getter = static_cast<get_awaitable *>(getters_.pop_front());
+            getter->value.emplace(std::move(item));
+            getter->notify_(env);
+            return ;
+        }
+
+        heap_.push_back(entry{ std::move(item), next_seq_++ });
+        std::push_heap(heap_.begin(), heap_.end(), [this](auto const &a, auto const &b) { return after_(a, b); });
+    }
+
+    T take_() {
+        std::pop_heap(heap_.begin(), heap_.end(), [this](auto const &a, auto const &b) { return after_(a, b); });
+        auto v = std::move(heap_.back().value);
+        heap_.pop_back();
+        return v;
+    }
+
+    std::size_t max_size_;
+    Compare compare_;
+
+    std::vector<entry> heap_;
+    std::uint64_t next_seq_ = 0;
+
+    waiter_list getters_;
+    waiter_list putters_;
+};
+
+} /* namespace detail */
+
+using detail::priority_store;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_PRIORITY_STORE_HPP_INCLUDED */
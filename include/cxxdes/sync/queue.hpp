@@ -3,70 +3,217 @@
  * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
  * @brief Queue class.
  * @date 2022-04-17
- * 
+ *
  * Copyright (c) Canberk Sönmez 2022
- * 
+ *
  */
 
 #ifndef CXXDES_SYNC_QUEUE_HPP_INCLUDED
 #define CXXDES_SYNC_QUEUE_HPP_INCLUDED
 
-#include <queue>
+#include <tuple>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <cxxdes/core/core.hpp>
-#include <cxxdes/sync/event.hpp>
+#include <cxxdes/misc/ring_buffer.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+#include <cxxdes/sync/monitor.hpp>
 
 namespace cxxdes {
 namespace sync {
 
 namespace detail {
 
-using core::timeout;
-using core::coroutine;
-using core::operator&&;
+using namespace cxxdes::core;
 
 /**
  * @brief Coroutine-friendly FIFO queue with optional bounded capacity.
  *
  * `put()` suspends while a bounded queue is full. `pop()` suspends while the
  * queue is empty. A `max_size` of zero means the queue is unbounded.
+ * `put_range()` and `pop_n()` move a whole batch with at most one suspension:
+ * they suspend until the entire batch fits or is available.
+ *
+ * Items are stored in a ring buffer, which a bounded queue allocates once at
+ * construction. Items are handed over directly: an operation that makes room
+ * or adds items completes blocked operations in arrival order for as long as
+ * they can be satisfied. A woken process has therefore already completed its
+ * operation when it resumes, and each item is claimed by exactly one
+ * consumer. Operations never overtake earlier blocked operations of the same
+ * kind. `pop_op()` returns a pop operation that can be raced against other
+ * queues with `select`; all other operations can be raced as well.
+ *
+ * `put_for()`, `put_until()`, `pop_for()` and `pop_until()` give up at a
+ * deadline. Blocked operations are unlinked from the queue when they
+ * complete, time out, or are destroyed, and the queue owns the tokens of
+ * operations still blocked when it is destroyed.
+ *
+ * With the `monitored` policy, the queue records its puts and pops, their
+ * waiting times, and its size over time; see `monitor()`.
  *
  * @tparam T Stored value type.
+ * @tparam Monitor Monitor policy, `unmonitored` or `monitored`.
  */
-template <typename T>
+template <typename T, typename Monitor = unmonitored>
 struct queue {
-    /** @brief Constructs an empty queue; zero @p max_size means unbounded. */
+private:
+    struct pop_waiter;
+    struct put_waiter;
+
+    struct pop_awaitable;
+
+    template <typename OutputIterator>
+    struct pop_n_awaitable;
+
+    template <typename ...Args>
+    struct put_awaitable;
+
+    template <typename ForwardIterator>
+    struct put_range_awaitable;
+
+public:
+    /**
+     * @brief Constructs an empty queue; zero @p max_size means unbounded.
+     *
+     * A bounded queue allocates room for @p max_size items up front.
+     */
     queue(std::size_t max_size = 0 /* infinite */): max_size_{max_size} {
+        buffer_.reserve(max_size_);
     }
 
+    queue(queue const &) = delete;
+    queue &operator=(queue const &) = delete;
+
     /**
      * @brief Waits for capacity and constructs an item at the back of the queue.
      *
-     * @param args Arguments forwarded to `std::queue<T>::emplace`.
+     * @param args Arguments forwarded to the constructor of `T`. They are
+     *        referenced, not copied, until the operation completes.
      */
     template <typename ...Args>
     [[nodiscard("expected usage: co_await queue.put(args...)")]]
-    subroutine<> put(Args && ...args) {
-        while (!can_put())
-            co_await event_.wait();
-        q_.emplace(std::forward<Args>(args)...);
-        co_await event_.wake();
+    auto put(Args && ...args) {
+        return put_awaitable<Args &&...>{this, std::forward_as_tuple(std::forward<Args>(args)...)};
     }
 
+    /**
+     * @brief Waits until all items of `[first, last)` fit, then appends them.
+     *
+     * The range is referenced, not copied, until the operation completes.
+     *
+     * @throws std::runtime_error If the range is larger than a bounded queue.
+     */
+    template <std::forward_iterator ForwardIterator>
+    [[nodiscard("expected usage: co_await queue.put_range(first, last)")]]
+    auto put_range(ForwardIterator first, ForwardIterator last) {
+        auto n = static_cast<std::size_t>(std::distance(first, last));
+
+        if (bounded() && n > max_size())
+            throw std::runtime_error("queue put_range() is larger than the queue capacity");
+
+        return put_range_awaitable<ForwardIterator>{this, first, last, n};
+    }
+
+    /**
+     * @brief Constructs an item at the back of the queue if it fits without waiting.
+     *
+     * For code that cannot suspend, such as event handlers. Blocked consumers
+     * are resumed in @p env, the environment of the processes using the queue.
+     * The item does not overtake blocked producers.
+     *
+     * @return Whether the item was inserted.
+     */
+    template <typename ...Args>
+    bool try_put(environment &env, Args && ...args) {
+        auto ticket = monitor_.on_arrival(&env);
+
+        if (!producers_.empty() || !can_put()) {
+            monitor_.on_balk();
+            return false;
+        }
+
+        buffer_.emplace_back(std::forward<Args>(args)...);
+        monitor_.on_served(&env, ticket);
+        pump_(&env);
+        return true;
+    }
 
     /** @brief Waits for an item, removes the front item, and returns it. */
     [[nodiscard("expected usage: co_await queue.pop()")]]
-    subroutine<T> pop() {
-        while (!can_pop())
-            co_await event_.wait();
-        auto v = std::move(q_.front());
-        q_.pop();
-        co_await event_.wake();
-        co_return v;
+    auto pop() {
+        return pop_awaitable{this};
+    }
+
+    /**
+     * @brief Returns a pop operation for `select`.
+     *
+     * The operation can also be awaited directly, in which case it behaves
+     * exactly like `pop()`.
+     */
+    [[nodiscard("expected usage: co_await select(queue.pop_op(), ...)")]]
+    auto pop_op() {
+        return pop_awaitable{this};
+    }
+
+    /**
+     * @brief Waits until @p n items are stored, then moves them to @p out.
+     *
+     * @return The output iterator past the last written item.
+     * @throws std::runtime_error If @p n is larger than a bounded queue.
+     */
+    template <typename OutputIterator>
+    [[nodiscard("expected usage: co_await queue.pop_n(out, n)")]]
+    auto pop_n(OutputIterator out, std::size_t n) {
+        if (bounded() && n > max_size())
+            throw std::runtime_error("queue pop_n() is larger than the queue capacity");
+
+        return pop_n_awaitable<OutputIterator>{this, std::move(out), n};
+    }
+
+    /**
+     * @brief Waits at most @p d for capacity, then constructs an item.
+     *
+     * @return A `timed_result<void>` that is empty on timeout, in which case
+     *         no item was inserted.
+     */
+    template <typename D, typename ...Args>
+    [[nodiscard("expected usage: co_await queue.put_for(d, args...)")]]
+    auto put_for(D &&d, Args && ...args) {
+        return timed(put(std::forward<Args>(args)...), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Waits until the absolute time @p t for capacity, then constructs an item. */
+    template <typename U, typename ...Args>
+    [[nodiscard("expected usage: co_await queue.put_until(t, args...)")]]
+    auto put_until(U &&t, Args && ...args) {
+        return timed(put(std::forward<Args>(args)...), until(std::forward<U>(t)));
+    }
+
+    /**
+     * @brief Waits at most @p d for an item, then removes and returns it.
+     *
+     * @return A `timed_result<T>` holding the item, or empty on timeout, in
+     *         which case no item was removed.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await queue.pop_for(d)")]]
+    auto pop_for(D &&d) {
+        return timed(pop_op(), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Waits until the absolute time @p t for an item, then removes and returns it. */
+    template <typename U>
+    [[nodiscard("expected usage: co_await queue.pop_until(t)")]]
+    auto pop_until(U &&t) {
+        return timed(pop_op(), until(std::forward<U>(t)));
     }
 
     /** @brief Returns the number of currently stored items. */
     std::size_t size() const noexcept {
-        return q_.size();
+        return buffer_.size();
     }
 
     /** @brief Returns the configured maximum size, or zero when unbounded. */
@@ -79,25 +226,278 @@ struct queue {
         return max_size() > 0;
     }
 
-    /** @brief Returns whether a producer can insert without blocking now. */
-    bool can_put() const noexcept {
-        return !bounded() || (max_size() > size());
+    /** @brief Returns whether @p n more items fit right now. */
+    bool can_put(std::size_t n = 1) const noexcept {
+        return !bounded() || (max_size() >= size() + n);
+    }
+
+    /** @brief Returns whether at least @p n items are stored right now. */
+    bool can_pop(std::size_t n = 1) const noexcept {
+        return size() >= n;
+    }
+
+    /** @brief Returns the number of consumers blocked on this queue. */
+    std::size_t waiting_consumers() const noexcept {
+        return consumers_.size();
+    }
+
+    /** @brief Returns the number of producers blocked on this queue. */
+    std::size_t waiting_producers() const noexcept {
+        return producers_.size();
     }
 
-    /** @brief Returns whether a consumer can pop without blocking now. */
-    bool can_pop() const noexcept {
-        return size() > 0;
+    /** @brief Returns the monitor of this queue. */
+    Monitor &monitor() noexcept {
+        return monitor_;
     }
 
-    /** @brief Returns a const reference to the underlying `std::queue`. */
-    const std::queue<T> &underlying_queue() const noexcept {
-        return q_;
+    /** @copydoc monitor() */
+    Monitor const &monitor() const noexcept {
+        return monitor_;
+    }
+
+    /** @brief Returns a const reference to the underlying ring buffer. */
+    const util::ring_buffer<T> &underlying_buffer() const noexcept {
+        return buffer_;
+    }
+
+    ~queue() {
+        discard_all(consumers_);
+        discard_all(producers_);
     }
 private:
+    struct pop_waiter: waiter {
+        std::size_t count = 1;
+        [[no_unique_address]] typename Monitor::ticket ticket{};
+
+        // moves `count` items out of the buffer
+        virtual void receive_(queue *q) = 0;
+    };
+
+    struct put_waiter: waiter {
+        std::size_t count = 1;
+        [[no_unique_address]] typename Monitor::ticket ticket{};
+
+        // moves `count` items into the buffer
+        virtual void transfer_(queue *q) = 0;
+    };
+
+    template <typename Derived, typename Base>
+    struct op_base: Base {
+        static constexpr bool pop = std::is_same_v<Base, pop_waiter>;
+
+        queue *q;
+        environment *env = nullptr;
+        priority_type priority = priority_consts::inherit;
+
+        op_base(queue *q_, std::size_t count): q{q_} {
+            this->count = count;
+        }
+
+        op_base(op_base &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(list_(), coro_data, 0, priority, Derived::what);
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        bool select_ready() {
+            this->ticket = q->monitor_.on_arrival(env);
+
+            if (!list_().empty())
+                return false;
+
+            if constexpr (pop) {
+                if (!q->can_pop(this->count))
+                    return false;
+
+                this->receive_(q);
+            }
+            else {
+                if (!q->can_put(this->count))
+                    return false;
+
+                this->transfer_(q);
+            }
+
+            q->monitor_.on_served(env, this->ticket);
+            q->pump_(env);
+            return true;
+        }
+
+        void select_register(select_core *core, std::size_t index) {
+            this->register_(list_(), core, index, priority);
+        }
+
+        void select_withdraw() noexcept {
+            if (this->linked())
+                q->monitor_.on_timeout();
+
+            this->discard_();
+        }
+
+    private:
+        waiter_list &list_() const noexcept {
+            if constexpr (pop)
+                return q->consumers_;
+            else
+                return q->producers_;
+        }
+    };
+
+    struct pop_awaitable: op_base<pop_awaitable, pop_waiter> {
+        static constexpr const char *what = "queue pop";
+
+        std::optional<T> value;
+
+        pop_awaitable(queue *q_): op_base<pop_awaitable, pop_waiter>{q_, 1} {
+        }
+
+        pop_awaitable(pop_awaitable &&) = default;
+
+        T await_resume() {
+            return std::move(*value);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        T select_resume() {
+            return std::move(*value);
+        }
+
+        void receive_(queue *q_) override {
+            value.emplace(std::move(q_->buffer_.front()));
+            q_->buffer_.pop_front();
+        }
+    };
+
+    template <typename OutputIterator>
+    struct pop_n_awaitable: op_base<pop_n_awaitable<OutputIterator>, pop_waiter> {
+        static constexpr const char *what = "queue pop_n";
+
+        OutputIterator out;
+
+        pop_n_awaitable(queue *q_, OutputIterator out_, std::size_t n):
+            op_base<pop_n_awaitable, pop_waiter>{q_, n}, out{std::move(out_)} {
+        }
+
+        pop_n_awaitable(pop_n_awaitable &&) = default;
+
+        OutputIterator await_resume() {
+            return std::move(out);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        OutputIterator select_resume() {
+            return std::move(out);
+        }
+
+        void receive_(queue *q_) override {
+            for (std::size_t i = 0; i < this->count; ++i) {
+                *out = std::move(q_->buffer_.front());
+                ++out;
+                q_->buffer_.pop_front();
+            }
+        }
+    };
+
+    template <typename ...Args>
+    struct put_awaitable: op_base<put_awaitable<Args...>, put_waiter> {
+        static constexpr const char *what = "queue put";
+
+        std::tuple<Args...> args;
+
+        put_awaitable(queue *q_, std::tuple<Args...> args_):
+            op_base<put_awaitable, put_waiter>{q_, 1}, args{std::move(args_)} {
+        }
+
+        put_awaitable(put_awaitable &&) = default;
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        void select_resume() const noexcept {  }
+
+        void transfer_(queue *q_) override {
+            std::apply([&](auto && ...xs) { q_->buffer_.emplace_back(std::forward<decltype(xs)>(xs)...); }, std::move(args));
+        }
+    };
+
+    template <typename ForwardIterator>
+    struct put_range_awaitable: op_base<put_range_awaitable<ForwardIterator>, put_waiter> {
+        static constexpr const char *what = "queue put_range";
+
+        ForwardIterator first;
+        ForwardIterator last;
+
+        put_range_awaitable(queue *q_, ForwardIterator first_, ForwardIterator last_, std::size_t n):
+            op_base<put_range_awaitable, put_waiter>{q_, n}, first{first_}, last{last_} {
+        }
+
+        put_range_awaitable(put_range_awaitable &&) = default;
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        void select_resume() const noexcept {  }
+
+        void transfer_(queue *q_) override {
+            for (auto it = first; it != last; ++it)
+                q_->buffer_.emplace_back(*it);
+        }
+    };
+
+    // completes blocked operations in order for as long as they can be satisfied
+    void pump_(environment *env) {
+        while (true) {
+            if (!consumers_.empty()) {
+                auto consumer = static_cast<pop_waiter *>(consumers_.front());
+                if (can_pop(consumer->count)) {
+                    consumers_.pop_front();
+                    consumer->receive_(this);
+                    monitor_.on_served(env, consumer->ticket);
+                    consumer->notify_(env);
+                    continue ;
+                }
+            }
+
+            if (!producers_.empty()) {
+                auto producer = static_cast<put_waiter *>(producers_.front());
+                if (can_put(producer->count)) {
+                    producers_.pop_front();
+                    producer->transfer_(this);
+                    monitor_.on_served(env, producer->ticket);
+                    producer->notify_(env);
+                    continue ;
+                }
+            }
+
+            break ;
+        }
+
+        monitor_.on_level(env, static_cast<double>(size()));
+    }
+
     std::size_t max_size_;
-    std::queue<T> q_;
+    util::ring_buffer<T> buffer_;
+
+    waiter_list consumers_;
+    waiter_list producers_;
 
-    sync::event event_;
+    [[no_unique_address]] Monitor monitor_;
 };
 
 } /* namespace detail */
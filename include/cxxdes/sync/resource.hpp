@@ -12,12 +12,13 @@
 #define CXXDES_SYNC_RESOURCE_HPP_INCLUDED
 
 #include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/monitor.hpp>
 #include <cxxdes/sync/semaphore.hpp>
 
 namespace cxxdes {
 namespace sync {
 
-using core::coroutine;
+using namespace cxxdes::core;
 
 /**
  * @brief Counted resource implemented on top of a semaphore.
@@ -25,9 +26,16 @@ using core::coroutine;
  * A resource models a fixed number of identical units. `acquire()` waits until
  * a unit is available and returns a move-only handle. The handle must be
  * released with `co_await handle.release()`; destroying the handle does not
- * release the resource.
+ * release the resource. `acquire_for()` and `acquire_until()` give up at a
+ * deadline.
+ *
+ * With the `monitored` policy, the resource records its acquisitions, their
+ * waiting times, and its available units over time; see `monitor()`.
+ *
+ * @tparam Monitor Monitor policy, `unmonitored` or `monitored`.
  */
-struct resource {
+template <typename Monitor = unmonitored>
+struct basic_resource {
     /**
      * @brief Move-only token representing one acquired resource unit.
      *
@@ -62,44 +70,141 @@ struct resource {
         }
 
         /**
-         * @brief Releases the resource unit and wakes waiters.
+         * @brief Releases the resource unit and hands it over to the next waiter.
          *
          * @throws std::runtime_error If the handle is invalid.
          */
         [[nodiscard("expected usage: co_await resource_handle.release()")]]
-        subroutine<> release() {
+        auto release() {
             if (!valid())
                 throw std::runtime_error("called release() on invalid resource handle");
-            
+
             auto x = x_;
             x_ = nullptr;
 
-            co_await x->s_.up();
+            return release_awaitable{x};
         }
 
     private:
-        friend struct resource;
+        friend struct basic_resource;
 
-        handle(resource *x): x_{x} {
+        handle(basic_resource *x): x_{x} {
         }
 
-        resource *x_ = nullptr;
+        basic_resource *x_ = nullptr;
     };
 
     /** @brief Constructs a resource with @p count initially available units. */
-    resource(std::size_t count): s_{count, count} {
+    basic_resource(std::size_t count): s_{count, count} {
     }
 
-    /** @brief Waits for and acquires one resource unit. */
+    basic_resource(basic_resource const &) = delete;
+    basic_resource &operator=(basic_resource const &) = delete;
+
+    /**
+     * @brief Waits for and acquires one resource unit.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     */
     [[nodiscard("expected usage: co_await resource.acquire()")]]
-    subroutine<handle> acquire() {
-        co_await s_.down();
-        co_return handle(this);
+    auto acquire(priority_type priority = priority_consts::inherit) {
+        return acquire_awaitable{this, priority};
+    }
+
+    /**
+     * @brief Like `acquire()`, but gives up after @p d.
+     *
+     * @return A `timed_result<handle>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await resource.acquire_for(d)")]]
+    auto acquire_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(acquire(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `acquire()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await resource.acquire_until(t)")]]
+    auto acquire_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(acquire(priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the number of currently available units. */
+    [[nodiscard]]
+    std::size_t available() const noexcept {
+        return s_.value();
+    }
+
+    /** @brief Returns the number of units. */
+    [[nodiscard]]
+    std::size_t capacity() const noexcept {
+        return s_.max();
+    }
+
+    /** @brief Returns the number of processes waiting for a unit. */
+    [[nodiscard]]
+    std::size_t waiting() const noexcept {
+        return s_.waiting_down();
+    }
+
+    /** @brief Returns the monitor of this resource; its level is the number of available units. */
+    Monitor &monitor() noexcept {
+        return s_.monitor();
+    }
+
+    /** @copydoc monitor() */
+    Monitor const &monitor() const noexcept {
+        return s_.monitor();
     }
 private:
-    semaphore<> s_;
+    using semaphore_type = semaphore<std::size_t, Monitor>;
+
+    struct acquire_awaitable: semaphore_type::op_awaitable {
+        using base = typename semaphore_type::op_awaitable;
+
+        basic_resource *x;
+
+        acquire_awaitable(basic_resource *x_, priority_type priority):
+            base{&x_->s_, false, priority}, x{x_} {
+        }
+
+        handle await_resume() noexcept {
+            return handle(x);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        handle select_resume() noexcept {
+            return handle(x);
+        }
+    };
+
+    // never blocks: the released unit is below the maximum
+    struct release_awaitable {
+        basic_resource *x;
+
+        environment *env = nullptr;
+
+        void await_bind(environment *env_, priority_type) noexcept {
+            env = env_;
+        }
+
+        bool await_ready() {
+            x->s_.try_up_(env);
+            return true;
+        }
+
+        void await_suspend(coroutine_data_ptr) const noexcept {  }
+        token *await_token() const noexcept { return nullptr; }
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+    };
+
+    semaphore_type s_;
 };
 
+/** @brief Resource without a monitor. */
+using resource = basic_resource<>;
+
 } /* namespace sync */
 } /* namespace cxxdes */
 
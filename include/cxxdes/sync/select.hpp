@@ -0,0 +1,379 @@
+/**
+ * @file select.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Waiting on the first of several synchronization operations.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_SELECT_HPP_INCLUDED
+#define CXXDES_SYNC_SELECT_HPP_INCLUDED
+
+#include <tuple>
+#include <limits>
+#include <stdexcept>
+#include <variant>
+#include <cassert>
+#include <utility>
+#include <type_traits>
+#include <cxxdes/core/core.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Interface of a pending `select` that can withdraw its operations.
+ */
+struct select_base {
+    virtual void withdraw_(std::size_t winner) = 0;
+    virtual ~select_base() = default;
+};
+
+/**
+ * @brief Shared completion state of one suspended `select`.
+ *
+ * Sources complete a select by calling `complete()` with their index. Only the
+ * first call wins: it withdraws all other operations from their sources and
+ * schedules the resume token of the selecting process. The state is reference
+ * counted because timers and processes raced by the select may fire after the
+ * select itself is gone.
+ */
+struct select_core: memory::reference_counted_base<select_core> {
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    environment *env = nullptr;
+    memory::ptr<token> tkn = nullptr;
+    select_base *owner = nullptr;
+    std::size_t index = npos;
+
+    [[nodiscard]]
+    bool done() const noexcept {
+        return index != npos;
+    }
+
+    /**
+     * @brief Completes the select on behalf of operation @p i.
+     *
+     * @retval true Operation @p i won the select.
+     * @retval false The select was already completed or abandoned.
+     */
+    bool complete(std::size_t i) {
+        if (done())
+            return false;
+
+        index = i;
+
+        if (owner)
+            owner->withdraw_(i);
+
+        tkn->time += env->now();
+        env->schedule_token(tkn.get());
+        tkn = nullptr;
+
+        return true;
+    }
+};
+
+struct select_handler: token_handler {
+    memory::ptr<select_core> core;
+    std::size_t index;
+
+    select_handler(memory::ptr<select_core> core_, std::size_t index_):
+        core{std::move(core_)}, index{index_} {
+    }
+
+    void invoke(token *) override {
+        core->complete(index);
+    }
+};
+
+/**
+ * @brief Concept for operations that `select` can claim atomically.
+ *
+ * A selectable operation is bound like an awaitable. `select_ready()` claims a
+ * value immediately if one is available. Otherwise `select_register()` enqueues
+ * the operation at its source, which later stores a value into the operation
+ * and calls `select_core::complete()`. `select_withdraw()` removes a registered
+ * operation from its source, and `select_resume()` returns the claimed value.
+ */
+template <typename T>
+concept selectable = requires(
+    T t,
+    environment *env,
+    priority_type inherited_priority,
+    select_core *core,
+    std::size_t index) {
+    { t.await_bind(env, inherited_priority) };
+    { t.select_ready() } -> std::same_as<bool>;
+    { t.select_register(core, index) };
+    { t.select_withdraw() };
+    { t.select_resume() };
+};
+
+template <typename T>
+concept select_operand = selectable<T> || awaitable<T>;
+
+template <typename T>
+struct select_value {
+    using type = decltype(std::declval<T &>().await_resume());
+};
+
+template <selectable T>
+struct select_value<T> {
+    using type = decltype(std::declval<T &>().select_resume());
+};
+
+template <typename T>
+using select_value_t = std::conditional_t<
+    std::is_void_v<typename select_value<T>::type>,
+    std::monostate,
+    std::remove_cvref_t<typename select_value<T>::type>>;
+
+/**
+ * @brief Result of a `select`.
+ *
+ * @tparam Ts Value types of the operations, with `void` mapped to
+ *         `std::monostate`.
+ */
+template <typename ...Ts>
+struct select_result {
+    /** @brief Index of the operation that completed the select. */
+    std::size_t index;
+
+    /** @brief Value of the winning operation; `value.index() == index`. */
+    std::variant<Ts...> value;
+
+    /** @brief Returns the value of operation @p I; it must be the winner. */
+    template <std::size_t I>
+    auto &get() noexcept {
+        assert(I == index);
+        return *std::get_if<I>(&value);
+    }
+};
+
+template <select_operand ...Ops>
+struct select_awaitable: select_base {
+    using result_type = select_result<select_value_t<Ops>...>;
+
+    template <typename ...Args>
+    select_awaitable(Args && ...args): ops_{std::forward<Args>(args)...} {
+    }
+
+    select_awaitable(select_awaitable &&other):
+        ops_{std::move(other.ops_)}, priority_{other.priority_} {
+        assert(!other.core_ && "cannot move a suspended select");
+    }
+
+    select_awaitable(select_awaitable const &) = delete;
+    select_awaitable &operator=(select_awaitable const &) = delete;
+    select_awaitable &operator=(select_awaitable &&) = delete;
+
+    /** @brief Sets the priority used to resume the selecting process. */
+    auto &priority(priority_type priority) noexcept {
+        priority_ = priority;
+        return *this;
+    }
+
+    void await_bind(environment *env, priority_type priority) {
+        env_ = env;
+
+        if (priority_ == priority_consts::inherit)
+            priority_ = priority;
+
+        apply([&](auto &op, std::size_t) { op.await_bind(env, priority_); });
+    }
+
+    bool await_ready() {
+        // stop at the first ready operation, so that at most one is claimed
+        apply([&](auto &op, std::size_t i) {
+            if (index_ != select_core::npos)
+                return ;
+
+            bool ready = false;
+            if constexpr (selectable<std::remove_cvref_t<decltype(op)>>)
+                ready = op.select_ready();
+            else
+                ready = op.await_ready();
+
+            if (ready)
+                index_ = i;
+        });
+
+        return index_ != select_core::npos;
+    }
+
+    void await_suspend(coroutine_data_ptr coro_data) {
+        core_ = new select_core;
+        core_->env = env_;
+        core_->tkn = tkn_ = new token(0, priority_, coro_data, "select");
+        core_->owner = this;
+
+        apply([&](auto &op, std::size_t i) {
+            if (core_->done())
+                return ;
+
+            if constexpr (selectable<std::remove_cvref_t<decltype(op)>>) {
+                op.select_register(core_.get(), i);
+            }
+            else {
+                op.await_suspend(coro_data);
+                suspended_[i] = true;
+                if (op.await_token())
+                    op.await_token()->handler = new select_handler(core_, i);
+            }
+        });
+    }
+
+    token *await_token() const noexcept {
+        return tkn_;
+    }
+
+    result_type await_resume() {
+        finish_();
+        return resume_<0>();
+    }
+
+    void await_resume(no_return_value_tag) {
+        finish_();
+        apply([&](auto &op, std::size_t i) {
+            if constexpr (!selectable<std::remove_cvref_t<decltype(op)>>) {
+                if (i == index_ || suspended_[i])
+                    op.await_resume(no_return_value_tag{});
+            }
+        });
+    }
+
+    ~select_awaitable() {
+        finish_();
+    }
+
+private:
+    template <typename F>
+    void apply(F f) {
+        std::apply(
+            [&](auto & ...ops) {
+                std::size_t i = 0;
+                (f(ops, i++), ...);
+            },
+            ops_);
+    }
+
+    void withdraw_(std::size_t winner) override {
+        apply([&](auto &op, std::size_t i) {
+            if (i == winner)
+                return ;
+
+            if constexpr (selectable<std::remove_cvref_t<decltype(op)>>) {
+                op.select_withdraw();
+            }
+            else if (suspended_[i] && op.await_token()) {
+                // a losing timer would otherwise stay scheduled and advance time when it fires
+                env_->cancel_token(op.await_token());
+            }
+        });
+    }
+
+    void finish_() {
+        if (core_) {
+            core_->owner = nullptr;
+
+            if (!core_->done()) {
+                // abandoned before completion, e.g. by an outer any_of
+                core_->index = sizeof...(Ops);
+                withdraw_(sizeof...(Ops));
+            }
+
+            index_ = core_->index;
+            core_ = nullptr;
+        }
+    }
+
+    template <std::size_t I>
+    result_type resume_() {
+        if constexpr (I == sizeof...(Ops)) {
+            throw std::runtime_error("select resumed without a winning operation");
+        }
+        else {
+            if (I != index_)
+                return resume_<I + 1>();
+
+            auto &op = std::get<I>(ops_);
+            using op_type = std::remove_cvref_t<decltype(op)>;
+
+            // losers that were suspended as ordinary awaitables are finalized
+            apply([&](auto &other, std::size_t i) {
+                if constexpr (!selectable<std::remove_cvref_t<decltype(other)>>) {
+                    if (i != I && suspended_[i])
+                        other.await_resume(no_return_value_tag{});
+                }
+            });
+
+            if constexpr (selectable<op_type>) {
+                if constexpr (std::is_void_v<typename select_value<op_type>::type>) {
+                    op.select_resume();
+                    return result_type{ I, std::variant<select_value_t<Ops>...>{ std::in_place_index<I> } };
+                }
+                else {
+                    return result_type{ I, std::variant<select_value_t<Ops>...>{ std::in_place_index<I>, op.select_resume() } };
+                }
+            }
+            else if constexpr (std::is_void_v<typename select_value<op_type>::type>) {
+                op.await_resume();
+                return result_type{ I, std::variant<select_value_t<Ops>...>{ std::in_place_index<I> } };
+            }
+            else {
+                return result_type{ I, std::variant<select_value_t<Ops>...>{ std::in_place_index<I>, op.await_resume() } };
+            }
+        }
+    }
+
+    std::tuple<Ops...> ops_;
+    bool suspended_[sizeof...(Ops)] = {};
+
+    environment *env_ = nullptr;
+    token *tkn_ = nullptr;
+    priority_type priority_ = priority_consts::inherit;
+    std::size_t index_ = select_core::npos;
+    memory::ptr<select_core> core_ = nullptr;
+};
+
+struct select_functor {
+    /**
+     * @brief Waits for the first of several operations and returns its value.
+     *
+     * Selectable operations, such as `queue<T>::pop_op()`, share one waiter:
+     * exactly one of them claims a value, and the others are withdrawn from
+     * their sources as soon as the select completes. Ordinary awaitables, such
+     * as `timeout(t)`, may also be mixed in; when one of them completes first,
+     * the select resumes and the remaining selectable operations are
+     * withdrawn. The tokens of the ordinary awaitables that lost, such as
+     * that of a timer, are cancelled, so they neither run nor advance time.
+     * When several operations are ready right away, the leftmost one wins.
+     *
+     * @return A `select_result` holding the index and value of the winner.
+     */
+    template <typename ...Ts>
+    [[nodiscard("expected usage: co_await select(ops...)")]]
+    auto operator()(Ts && ...ts) const {
+        static_assert(sizeof...(Ts) > 0, "select needs at least one operation");
+        return select_awaitable<std::remove_cvref_t<Ts>...>{ std::forward<Ts>(ts)... };
+    }
+};
+
+} /* namespace detail */
+
+using detail::select_result;
+
+/** @brief Awaitable that completes with exactly one of its operations. */
+inline constexpr detail::select_functor select;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_SELECT_HPP_INCLUDED */
@@ -3,9 +3,9 @@
  * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
  * @brief Semaphore class.
  * @date 2022-04-20
- * 
+ *
  * Copyright (c) Canberk Sönmez 2022
- * 
+ *
  */
 
 #ifndef CXXDES_SYNC_SEMAPHORE_HPP_INCLUDED
@@ -14,24 +14,46 @@
 #include <limits>
 #include <concepts>
 #include <cxxdes/core/core.hpp>
-#include <cxxdes/sync/event.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+#include <cxxdes/sync/monitor.hpp>
 
 namespace cxxdes {
 namespace sync {
 
-using core::coroutine;
+using namespace cxxdes::core;
+
+template <typename Monitor>
+struct basic_resource;
 
 /**
  * @brief Counting semaphore for coordinating simulation processes.
  *
  * `down()` waits until the count is positive and then decrements it. `up()`
  * waits until the count is below the configured maximum and then increments it.
- * Both operations wake other waiters after changing the count.
+ *
+ * Permits are handed over directly: an `up()` that finds a blocked `down()`
+ * completes it instead of incrementing the count, and vice versa, so a woken
+ * process has already completed its operation when it resumes. Blocked
+ * operations are served in priority order, and in arrival order among equal
+ * priorities.
+ *
+ * `down_for()`, `down_until()`, `up_for()` and `up_until()` give up at a
+ * deadline. Blocked operations are removed from the semaphore when they time
+ * out or are destroyed.
+ *
+ * With the `monitored` policy, the semaphore records its ups and downs, their
+ * waiting times, and its count over time; see `monitor()`.
  *
  * @tparam U Unsigned integer type used for the permit count.
+ * @tparam Monitor Monitor policy, `unmonitored` or `monitored`.
  */
-template <std::unsigned_integral U = std::size_t>
+template <std::unsigned_integral U = std::size_t, typename Monitor = unmonitored>
 struct semaphore {
+private:
+    struct op_awaitable;
+
+public:
     /**
      * @brief Constructs a semaphore with an initial count and maximum count.
      *
@@ -40,9 +62,12 @@ struct semaphore {
      */
     semaphore(U value = 0, U max = std::numeric_limits<U>::max()):
         value_{value}, max_{max} {
-        
+
     }
 
+    semaphore(semaphore const &) = delete;
+    semaphore &operator=(semaphore const &) = delete;
+
     /** @brief Returns the maximum permit count. */
     U max() const {
         return max_;
@@ -53,35 +78,210 @@ struct semaphore {
         return value_;
     }
 
-    /** @brief Waits until the count can be incremented, then increments it. */
+    /**
+     * @brief Waits until the count can be incremented, then increments it.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     */
     [[nodiscard("expected usage: co_await semaphore.up()")]]
-    subroutine<> up() {
-        while (true) {
-            if (value_ < max_)
-                break ;
-            co_await event_.wait();
-        }
-        ++value_;
-        co_await event_.wake();
+    auto up(priority_type priority = priority_consts::inherit) {
+        return op_awaitable{this, true, priority};
     }
 
-    /** @brief Waits until a permit is available, then decrements the count. */
+    /**
+     * @brief Waits until a permit is available, then decrements the count.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     */
     [[nodiscard("expected usage: co_await semaphore.down()")]]
-    subroutine<> down() {
-        while (true) {
-            if (value_ > 0)
-                break ;
-            co_await event_.wait();
-        }
-        --value_;
-        co_await event_.wake();
+    auto down(priority_type priority = priority_consts::inherit) {
+        return op_awaitable{this, false, priority};
+    }
+
+    /**
+     * @brief Like `up()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout, in which case
+     *         the count was not changed.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await semaphore.up_for(d)")]]
+    auto up_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(up(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `up()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await semaphore.up_until(t)")]]
+    auto up_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(up(priority), until(std::forward<T>(t)));
+    }
+
+    /**
+     * @brief Like `down()`, but gives up after @p d.
+     *
+     * @return A `timed_result<void>` that is empty on timeout, in which case
+     *         the count was not changed.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await semaphore.down_for(d)")]]
+    auto down_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(down(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `down()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await semaphore.down_until(t)")]]
+    auto down_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(down(priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Returns the number of processes blocked in `down()`. */
+    [[nodiscard]]
+    std::size_t waiting_down() const noexcept {
+        return downs_.size();
+    }
+
+    /** @brief Returns the number of processes blocked in `up()`. */
+    [[nodiscard]]
+    std::size_t waiting_up() const noexcept {
+        return ups_.size();
+    }
+
+    /** @brief Returns the monitor of this semaphore. */
+    Monitor &monitor() noexcept {
+        return monitor_;
+    }
+
+    /** @copydoc monitor() */
+    Monitor const &monitor() const noexcept {
+        return monitor_;
+    }
+
+    ~semaphore() {
+        detail::discard_all(downs_);
+        detail::discard_all(ups_);
     }
 
 protected:
     U value_;
     U max_;
 
-    sync::event event_;
+private:
+    template <typename>
+    friend struct basic_resource;
+
+    struct op_awaitable: detail::waiter {
+        semaphore *s;
+        bool up;
+        priority_type priority;
+
+        environment *env = nullptr;
+        [[no_unique_address]] typename Monitor::ticket ticket{};
+
+        op_awaitable(semaphore *s_, bool up_, priority_type priority_):
+            s{s_}, up{up_}, priority{priority_} {
+        }
+
+        op_awaitable(op_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(list_(), coro_data, 0, priority, up ? "semaphore up" : "semaphore down", true);
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+        bool select_ready() {
+            ticket = s->monitor_.on_arrival(env);
+
+            if (!(up ? s->try_up_(env) : s->try_down_(env)))
+                return false;
+
+            s->monitor_.on_served(env, ticket);
+            return true;
+        }
+
+        void select_register(detail::select_core *core, std::size_t index) {
+            this->register_(list_(), core, index, priority, true);
+        }
+
+        void select_withdraw() noexcept {
+            if (this->linked())
+                s->monitor_.on_timeout();
+
+            this->discard_();
+        }
+
+        void select_resume() const noexcept {  }
+
+    private:
+        detail::waiter_list &list_() const noexcept {
+            return up ? s->ups_ : s->downs_;
+        }
+    };
+
+    bool try_down_(environment *env) {
+        if (value_ > 0) {
+            --value_;
+
+            // a blocked up() refills the permit
+            if (!ups_.empty()) {
+                ++value_;
+                wake_(ups_, env);
+            }
+
+            monitor_.on_level(env, static_cast<double>(value_));
+            return true;
+        }
+
+        if (!ups_.empty()) {
+            // only when max() is zero: take the permit of a blocked up()
+            wake_(ups_, env);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool try_up_(environment *env) {
+        if (!downs_.empty()) {
+            wake_(downs_, env);
+            return true;
+        }
+
+        if (value_ < max_) {
+            ++value_;
+            monitor_.on_level(env, static_cast<double>(value_));
+            return true;
+        }
+
+        return false;
+    }
+
+    void wake_(detail::waiter_list &list, environment *env) {
+        monitor_.on_served(env, static_cast<op_awaitable *>(list.front())->ticket);
+        detail::notify_one(list, env);
+    }
+
+    detail::waiter_list downs_;
+    detail::waiter_list ups_;
+
+    [[no_unique_address]] Monitor monitor_;
 };
 
 } /* namespace sync */
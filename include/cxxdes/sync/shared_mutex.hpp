@@ -0,0 +1,478 @@
+/**
+ * @file shared_mutex.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Reader-writer mutex.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_SHARED_MUTEX_HPP_INCLUDED
+#define CXXDES_SYNC_SHARED_MUTEX_HPP_INCLUDED
+
+#include <stdexcept>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/utils.hpp>
+#include <cxxdes/sync/waiter.hpp>
+#include <cxxdes/sync/timed.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+using namespace cxxdes::core;
+
+/** @brief Admission policy of a `shared_mutex`. */
+enum class shared_mutex_policy {
+    /**
+     * New readers are admitted whenever no writer holds the mutex. Writers may
+     * starve under a continuous stream of readers.
+     */
+    reader_preference,
+
+    /**
+     * New readers queue up behind waiting writers. A released writer hands the
+     * mutex to the next writer; queued readers are admitted only when no
+     * writer is waiting. Readers may starve under a continuous stream of
+     * writers.
+     */
+    writer_preference,
+
+    /**
+     * New readers queue up behind waiting writers, and a released writer
+     * admits all queued readers before the next writer (phase-fair). Neither
+     * side starves.
+     */
+    phase_fair
+};
+
+/**
+ * @brief Reader-writer mutex with shared and exclusive ownership.
+ *
+ * `acquire_shared()` and `acquire_exclusive()` suspend until the requested
+ * ownership is granted and return a move-only handle that must be released
+ * with `co_await handle.release()`. Ownership is handed over at release time:
+ * a woken waiter already owns the mutex when it resumes, so waiters never wake
+ * up just to recheck the state. Queued readers are admitted in one batch that
+ * resumes them with a single scheduled event, and writers are woken one at a
+ * time.
+ *
+ * Both acquisitions are selectable operations for `select`, and the `_for()`
+ * and `_until()` variants give up at a deadline. A process that gives up is
+ * removed from the mutex right away; if it was the last waiting writer,
+ * readers queued behind it are admitted.
+ *
+ * `shared()` and `exclusive()` return acquirable views for `_Co_with`; the
+ * mutex itself acquires exclusively, just like `mutex`.
+ */
+struct shared_mutex {
+    /**
+     * @brief Move-only token representing shared or exclusive ownership.
+     *
+     * A valid handle borrows the mutex object and must not outlive it.
+     */
+    struct handle {
+        /** @brief Constructs an invalid handle. */
+        handle() = default;
+
+        handle(handle const &) = delete;
+        handle &operator=(handle const &) = delete;
+
+        handle(handle &&other) {
+            *this = std::move(other);
+        }
+
+        handle &operator=(handle &&other) {
+            std::swap(x_, other.x_);
+            std::swap(exclusive_, other.exclusive_);
+            return *this;
+        }
+
+        /** @brief Returns whether this handle currently owns the mutex. */
+        [[nodiscard]]
+        bool valid() const noexcept {
+            return x_ != nullptr;
+        }
+
+        /** @brief Equivalent to `valid()`. */
+        [[nodiscard]]
+        operator bool() const noexcept {
+            return valid();
+        }
+
+        /** @brief Returns whether this handle owns the mutex exclusively. */
+        [[nodiscard]]
+        bool exclusive() const noexcept {
+            return exclusive_;
+        }
+
+        /**
+         * @brief Releases the owned mutex and hands it over to waiters.
+         *
+         * @throws std::runtime_error If the handle is invalid.
+         */
+        [[nodiscard("expected usage: co_await handle.release()")]]
+        auto release() {
+            if (!valid())
+                throw std::runtime_error("called release() on invalid shared_mutex handle");
+
+            auto x = x_;
+            x_ = nullptr;
+
+            return release_awaitable{x, exclusive_};
+        }
+    private:
+        friend struct shared_mutex;
+
+        handle(shared_mutex *x, bool exclusive): x_{x}, exclusive_{exclusive} {
+        }
+
+        shared_mutex *x_ = nullptr;
+        bool exclusive_ = false;
+    };
+
+    /** @brief Acquirable view that takes shared ownership; usable with `_Co_with`. */
+    struct shared_view {
+        /** @brief Equivalent to `shared_mutex::acquire_shared()`. */
+        [[nodiscard("expected usage: co_await view.acquire()")]]
+        auto acquire();
+    private:
+        friend struct shared_mutex;
+
+        shared_view(shared_mutex *x): x_{x} {
+        }
+
+        shared_mutex *x_;
+    };
+
+    /** @brief Acquirable view that takes exclusive ownership; usable with `_Co_with`. */
+    struct exclusive_view {
+        /** @brief Equivalent to `shared_mutex::acquire_exclusive()`. */
+        [[nodiscard("expected usage: co_await view.acquire()")]]
+        auto acquire();
+    private:
+        friend struct shared_mutex;
+
+        exclusive_view(shared_mutex *x): x_{x} {
+        }
+
+        shared_mutex *x_;
+    };
+
+    /** @brief Constructs an unlocked mutex with the given admission policy. */
+    shared_mutex(shared_mutex_policy policy = shared_mutex_policy::writer_preference):
+        policy_{policy} {
+    }
+
+    CXXDES_NOT_COPIABLE(shared_mutex)
+    CXXDES_NOT_MOVABLE(shared_mutex)
+
+    /**
+     * @brief Waits until shared ownership is granted and returns a handle.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     *
+     * @param priority Resume priority for this waiter, or
+     *        `priority_consts::inherit`.
+     */
+    [[nodiscard("expected usage: co_await mtx.acquire_shared()")]]
+    auto acquire_shared(priority_type priority = priority_consts::inherit) {
+        return acquire_awaitable{this, false, priority};
+    }
+
+    /**
+     * @brief Like `acquire_shared()`, but gives up after @p d.
+     *
+     * @return A `timed_result<handle>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await mtx.acquire_shared_for(d)")]]
+    auto acquire_shared_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(acquire_shared(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `acquire_shared()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await mtx.acquire_shared_until(t)")]]
+    auto acquire_shared_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(acquire_shared(priority), until(std::forward<T>(t)));
+    }
+
+    /**
+     * @brief Waits until exclusive ownership is granted and returns a handle.
+     *
+     * The awaitable is also a selectable operation for `select`.
+     *
+     * @param priority Resume priority for this waiter, or
+     *        `priority_consts::inherit`.
+     */
+    [[nodiscard("expected usage: co_await mtx.acquire_exclusive()")]]
+    auto acquire_exclusive(priority_type priority = priority_consts::inherit) {
+        return acquire_awaitable{this, true, priority};
+    }
+
+    /**
+     * @brief Like `acquire_exclusive()`, but gives up after @p d.
+     *
+     * @return A `timed_result<handle>` that is empty on timeout.
+     */
+    template <typename D>
+    [[nodiscard("expected usage: co_await mtx.acquire_exclusive_for(d)")]]
+    auto acquire_exclusive_for(D &&d, priority_type priority = priority_consts::inherit) {
+        return timed(acquire_exclusive(priority), delay(std::forward<D>(d)));
+    }
+
+    /** @brief Like `acquire_exclusive()`, but gives up at the absolute time @p t. */
+    template <typename T>
+    [[nodiscard("expected usage: co_await mtx.acquire_exclusive_until(t)")]]
+    auto acquire_exclusive_until(T &&t, priority_type priority = priority_consts::inherit) {
+        return timed(acquire_exclusive(priority), until(std::forward<T>(t)));
+    }
+
+    /** @brief Equivalent to `acquire_exclusive()`. */
+    [[nodiscard("expected usage: co_await mtx.acquire()")]]
+    auto acquire() {
+        return acquire_exclusive();
+    }
+
+    /** @brief Returns a view that acquires shared ownership, e.g. `_Co_with(mtx.shared())`. */
+    shared_view &shared() noexcept {
+        return shared_view_;
+    }
+
+    /** @brief Returns a view that acquires exclusive ownership, e.g. `_Co_with(mtx.exclusive())`. */
+    exclusive_view &exclusive() noexcept {
+        return exclusive_view_;
+    }
+
+    /** @brief Returns the admission policy. */
+    [[nodiscard]]
+    shared_mutex_policy policy() const noexcept {
+        return policy_;
+    }
+
+    /** @brief Returns the number of processes holding shared ownership. */
+    [[nodiscard]]
+    std::size_t readers() const noexcept {
+        return readers_;
+    }
+
+    /** @brief Returns whether a process holds exclusive ownership. */
+    [[nodiscard]]
+    bool is_acquired_exclusive() const noexcept {
+        return writer_;
+    }
+
+    /** @brief Returns whether any process holds the mutex. */
+    [[nodiscard]]
+    bool is_acquired() const noexcept {
+        return writer_ || readers_ > 0;
+    }
+
+    /** @brief Returns the number of readers waiting for shared ownership. */
+    [[nodiscard]]
+    std::size_t waiting_readers() const noexcept {
+        return waiting_readers_.size();
+    }
+
+    /** @brief Returns the number of writers waiting for exclusive ownership. */
+    [[nodiscard]]
+    std::size_t waiting_writers() const noexcept {
+        return waiting_writers_.size();
+    }
+
+    ~shared_mutex() {
+        detail::discard_all(waiting_readers_);
+        detail::discard_all(waiting_writers_);
+    }
+
+private:
+    struct acquire_awaitable: detail::waiter {
+        shared_mutex *x;
+        bool exclusive;
+        priority_type priority;
+
+        environment *env = nullptr;
+
+        acquire_awaitable(shared_mutex *x_, bool exclusive_, priority_type priority_):
+            x{x_}, exclusive{exclusive_}, priority{priority_} {
+        }
+
+        acquire_awaitable(acquire_awaitable &&) = default;
+
+        void await_bind(environment *env_, priority_type priority_) noexcept {
+            env = env_;
+
+            if (priority == priority_consts::inherit)
+                priority = priority_;
+        }
+
+        bool await_ready() noexcept {
+            return select_ready();
+        }
+
+        void await_suspend(coroutine_data_ptr coro_data) {
+            this->suspend_(x->list_(exclusive), coro_data, 0, priority, "shared_mutex acquired");
+        }
+
+        token *await_token() const noexcept {
+            return this->token_();
+        }
+
+        handle await_resume() noexcept {
+            return handle(x, exclusive);
+        }
+
+        void await_resume(no_return_value_tag) const noexcept {  }
+
+        bool select_ready() noexcept {
+            return exclusive ? x->try_acquire_exclusive_() : x->try_acquire_shared_();
+        }
+
+        void select_register(detail::select_core *core, std::size_t index) {
+            this->register_(x->list_(exclusive), core, index, priority);
+        }
+
+        void select_withdraw() {
+            withdraw_();
+        }
+
+        handle select_resume() noexcept {
+            return handle(x, exclusive);
+        }
+
+        ~acquire_awaitable() {
+            withdraw_();
+        }
+
+    private:
+        void withdraw_() {
+            if (!this->linked())
+                return ;
+
+            this->discard_();
+
+            // readers may have been queued only because of this writer
+            if (exclusive)
+                x->admit_(env);
+        }
+    };
+
+    struct release_awaitable {
+        shared_mutex *x;
+        bool exclusive;
+
+        environment *env = nullptr;
+
+        void await_bind(environment *env_, priority_type) noexcept {
+            env = env_;
+        }
+
+        bool await_ready() {
+            if (exclusive)
+                x->release_exclusive_(env);
+            else
+                x->release_shared_(env);
+            return true;
+        }
+
+        void await_suspend(coroutine_data_ptr) const noexcept {  }
+        token *await_token() const noexcept { return nullptr; }
+        void await_resume(no_return_value_tag = {}) const noexcept {  }
+    };
+
+    detail::waiter_list &list_(bool exclusive) noexcept {
+        return exclusive ? waiting_writers_ : waiting_readers_;
+    }
+
+    bool try_acquire_shared_() noexcept {
+        if (writer_)
+            return false;
+
+        if (policy_ != shared_mutex_policy::reader_preference && !waiting_writers_.empty())
+            return false;
+
+        ++readers_;
+        return true;
+    }
+
+    bool try_acquire_exclusive_() noexcept {
+        if (is_acquired() || !waiting_writers_.empty())
+            return false;
+
+        writer_ = true;
+        return true;
+    }
+
+    void release_shared_(environment *env) {
+        --readers_;
+        admit_(env);
+    }
+
+    void release_exclusive_(environment *env) {
+        writer_ = false;
+
+        bool readers_first =
+            policy_ != shared_mutex_policy::writer_preference ||
+            waiting_writers_.empty();
+
+        if (readers_first && !waiting_readers_.empty())
+            admit_readers_(env);
+        else if (!waiting_writers_.empty())
+            admit_writer_(env);
+    }
+
+    // admits waiters after the last reader left or a waiting writer gave up
+    void admit_(environment *env) {
+        if (writer_)
+            return ;
+
+        if (!waiting_writers_.empty()) {
+            if (readers_ == 0)
+                admit_writer_(env);
+        }
+        else if (!waiting_readers_.empty()) {
+            admit_readers_(env);
+        }
+    }
+
+    void admit_readers_(environment *env) {
+        // counted one by one: completing a select may withdraw its other operations
+        detail::wake_batch batch;
+        while (!waiting_readers_.empty()) {
+            ++readers_;
+            waiting_readers_.pop_front()->notify_(env, batch);
+        }
+
+        batch.schedule(env);
+    }
+
+    void admit_writer_(environment *env) {
+        writer_ = true;
+        detail::notify_one(waiting_writers_, env);
+    }
+
+    shared_mutex_policy policy_;
+
+    std::size_t readers_ = 0;
+    bool writer_ = false;
+
+    detail::waiter_list waiting_readers_;
+    detail::waiter_list waiting_writers_;
+
+    shared_view shared_view_{this};
+    exclusive_view exclusive_view_{this};
+};
+
+inline auto shared_mutex::shared_view::acquire() {
+    return x_->acquire_shared();
+}
+
+inline auto shared_mutex::exclusive_view::acquire() {
+    return x_->acquire_exclusive();
+}
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_SHARED_MUTEX_HPP_INCLUDED */
@@ -0,0 +1,100 @@
+/**
+ * @file store.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Common parts of item stores.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_STORE_HPP_INCLUDED
+#define CXXDES_SYNC_STORE_HPP_INCLUDED
+
+#include <optional>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/waiter.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+/**
+ * @brief Put operation of an item store with optional bounded capacity.
+ *
+ * @tparam Store Store type. It provides `can_put()`, `insert_(T &&, env)`,
+ *         which hands the item to a waiting consumer or stores it, and a
+ *         `putters_` waiter list.
+ * @tparam T Item type.
+ */
+template <typename Store, typename T>
+struct store_put_awaitable: waiter {
+    Store *s;
+    T item;
+
+    environment *env = nullptr;
+    priority_type priority = priority_consts::inherit;
+
+    store_put_awaitable(Store *s_, T item_): s{s_}, item{std::move(item_)} {
+    }
+
+    store_put_awaitable(store_put_awaitable &&) = default;
+
+    void await_bind(environment *env_, priority_type priority_) noexcept {
+        env = env_;
+
+        if (priority == priority_consts::inherit)
+            priority = priority_;
+    }
+
+    bool await_ready() {
+        return select_ready();
+    }
+
+    void await_suspend(coroutine_data_ptr coro_data) {
+        this->suspend_(s->putters_, coro_data, 0, priority, "store put");
+    }
+
+    token *await_token() const noexcept {
+        return this->token_();
+    }
+
+    void await_resume(no_return_value_tag = {}) const noexcept {  }
+
+    bool select_ready() {
+        if (!s->putters_.empty() || !s->can_put())
+            return false;
+
+        s->insert_(std::move(item), env);
+        return true;
+    }
+
+    void select_register(select_core *core, std::size_t index) {
+        this->register_(s->putters_, core, index, priority);
+    }
+
+    void select_withdraw() noexcept {
+        this->discard_();
+    }
+
+    void select_resume() const noexcept {  }
+
+    /** @brief Completes blocked put operations of @p s while there is room. */
+    static void admit(Store *s, environment *env) {
+        while (!s->putters_.empty() && s->can_put()) {
+            auto putter = static_cast<store_put_awaitable *>(s->putters_.pop_front());
+            s->insert_(std::move(putter->item), env);
+            putter->notify_(env);
+        }
+    }
+};
+
+} /* namespace detail */
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_STORE_HPP_INCLUDED */
@@ -0,0 +1,212 @@
+/**
+ * @file timed.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Timed waits on synchronization primitives.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_TIMED_HPP_INCLUDED
+#define CXXDES_SYNC_TIMED_HPP_INCLUDED
+
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/sync/select.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+/** @brief Reason a timed wait completed without a value. */
+enum class wait_errc {
+    /** The deadline passed before the operation completed. */
+    timeout
+};
+
+/**
+ * @brief Result of a timed wait: either the value of the operation or an error.
+ *
+ * @tparam T Value type of the operation.
+ */
+template <typename T>
+struct timed_result {
+    /** @brief Constructs a successful result. */
+    timed_result(T value): value_{std::move(value)} {
+    }
+
+    /** @brief Constructs a failed result. */
+    timed_result(wait_errc error): error_{error} {
+    }
+
+    /** @brief Returns whether the operation completed before the deadline. */
+    [[nodiscard]]
+    bool has_value() const noexcept {
+        return value_.has_value();
+    }
+
+    /** @brief Equivalent to `has_value()`. */
+    [[nodiscard]]
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    /** @brief Returns whether the deadline passed first. */
+    [[nodiscard]]
+    bool timed_out() const noexcept {
+        return !has_value();
+    }
+
+    /**
+     * @brief Returns the value of the operation.
+     *
+     * @throws std::runtime_error If the wait timed out.
+     */
+    T &value() & {
+        check_();
+        return *value_;
+    }
+
+    /** @copydoc value() */
+    T const &value() const & {
+        check_();
+        return *value_;
+    }
+
+    /** @copydoc value() */
+    T &&value() && {
+        check_();
+        return std::move(*value_);
+    }
+
+    /** @brief Returns the value of the operation; it must be present. */
+    T &operator*() & noexcept { return *value_; }
+    T const &operator*() const & noexcept { return *value_; }
+    T &&operator*() && noexcept { return std::move(*value_); }
+
+    T *operator->() noexcept { return &*value_; }
+    T const *operator->() const noexcept { return &*value_; }
+
+    /** @brief Returns the error; the result must not have a value. */
+    [[nodiscard]]
+    wait_errc error() const noexcept {
+        return error_;
+    }
+
+private:
+    void check_() const {
+        if (!has_value())
+            throw std::runtime_error("accessed the value of a timed out wait");
+    }
+
+    std::optional<T> value_;
+    wait_errc error_ = wait_errc::timeout;
+};
+
+/** @brief Result of a timed wait for an operation without a value. */
+template <>
+struct timed_result<void> {
+    /** @brief Constructs a successful result. */
+    timed_result() = default;
+
+    /** @brief Constructs a failed result. */
+    timed_result(wait_errc error): ok_{false}, error_{error} {
+    }
+
+    /** @brief Returns whether the operation completed before the deadline. */
+    [[nodiscard]]
+    bool has_value() const noexcept {
+        return ok_;
+    }
+
+    /** @brief Equivalent to `has_value()`. */
+    [[nodiscard]]
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    /** @brief Returns whether the deadline passed first. */
+    [[nodiscard]]
+    bool timed_out() const noexcept {
+        return !has_value();
+    }
+
+    /**
+     * @brief Checks that the operation completed.
+     *
+     * @throws std::runtime_error If the wait timed out.
+     */
+    void value() const {
+        if (!has_value())
+            throw std::runtime_error("accessed the value of a timed out wait");
+    }
+
+    /** @brief Returns the error; the result must not have a value. */
+    [[nodiscard]]
+    wait_errc error() const noexcept {
+        return error_;
+    }
+
+private:
+    bool ok_ = true;
+    wait_errc error_ = wait_errc::timeout;
+};
+
+namespace detail {
+
+template <selectable Op, awaitable Timer>
+struct timed_awaitable: select_awaitable<Op, Timer> {
+    using base = select_awaitable<Op, Timer>;
+    using value_type = std::remove_cvref_t<typename select_value<Op>::type>;
+    using result_type = timed_result<value_type>;
+
+    using base::base;
+    using base::await_resume;
+
+    result_type await_resume() {
+        auto r = base::await_resume();
+
+        if (r.index != 0)
+            return result_type{ wait_errc::timeout };
+
+        if constexpr (std::is_void_v<value_type>)
+            return result_type{};
+        else
+            return result_type{ std::move(r.template get<0>()) };
+    }
+};
+
+struct timed_functor {
+    /**
+     * @brief Waits for @p op until @p timer completes.
+     *
+     * @p op is raced against @p timer with `select`. If the operation
+     * completes first, the timer is cancelled, so it neither stays in the
+     * event queue nor advances time. If the timer completes first, the
+     * operation is removed from the waiter list of its primitive before the
+     * process resumes, so it can no longer claim a value. An operation that is ready right away completes without waiting,
+     * even if the deadline has already passed.
+     *
+     * @param op Selectable operation, such as `queue<T>::pop_op()`.
+     * @param timer Awaitable deadline, such as `delay(t)` or `until(t)`.
+     * @return A `timed_result` holding the value of @p op or `wait_errc::timeout`.
+     */
+    template <typename Op, typename Timer>
+    [[nodiscard("expected usage: co_await timed(op, timer)")]]
+    auto operator()(Op &&op, Timer &&timer) const {
+        return timed_awaitable<std::remove_cvref_t<Op>, std::remove_cvref_t<Timer>>{
+            std::forward<Op>(op), std::forward<Timer>(timer) };
+    }
+};
+
+} /* namespace detail */
+
+/** @brief Awaitable that waits for a selectable operation with a deadline. */
+inline constexpr detail::timed_functor timed;
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_TIMED_HPP_INCLUDED */
@@ -0,0 +1,275 @@
+/**
+ * @file waiter.hpp
+ * @author Canberk Sönmez (canberk.sonmez.409@gmail.com)
+ * @brief Blocked operations of synchronization primitives.
+ * @date 2026-10-18
+ *
+ * Copyright (c) Canberk Sönmez 2022
+ *
+ */
+
+#ifndef CXXDES_SYNC_WAITER_HPP_INCLUDED
+#define CXXDES_SYNC_WAITER_HPP_INCLUDED
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cxxdes/core/core.hpp>
+#include <cxxdes/misc/intrusive_list.hpp>
+#include <cxxdes/sync/select.hpp>
+
+namespace cxxdes {
+namespace sync {
+
+namespace detail {
+
+using namespace cxxdes::core;
+
+struct waiter;
+struct wake_batch;
+
+/** @brief List of operations blocked on a synchronization primitive. */
+using waiter_list = util::intrusive_list<waiter>;
+
+/**
+ * @brief Base class of an operation blocked on a synchronization primitive.
+ *
+ * A waiter is linked into a `waiter_list` of its primitive while it is blocked.
+ * It is either a standalone awaitable, in which case it owns the resume token
+ * of the suspended process until it is notified, or a registration of a
+ * `select`, in which case notifying it completes the select.
+ *
+ * Waiters live inside the awaitables of the blocked processes. Removing one
+ * from its list is constant time, so a primitive never keeps entries of
+ * processes that stopped waiting: a waiter unlinks itself when it is
+ * withdrawn by a `select` or destroyed.
+ */
+struct waiter: util::intrusive_list_node<waiter> {
+    waiter() = default;
+
+    waiter(waiter &&) noexcept {
+        // only unsuspended waiters are moved
+    }
+
+    waiter &operator=(waiter &&) = delete;
+
+    ~waiter() {
+        discard_();
+    }
+
+protected:
+    /**
+     * @brief Suspends @p coro_data on @p list until `notify_()` is called.
+     *
+     * With @p by_priority, the list is kept ordered by resume priority, and
+     * waiters with equal priorities are kept in arrival order.
+     */
+    void suspend_(
+        waiter_list &list,
+        coroutine_data_ptr coro_data,
+        time_integral latency,
+        priority_type priority,
+        const char *what,
+        bool by_priority = false) {
+        tkn_ = new token(latency, priority, coro_data, what);
+        priority_ = priority;
+        enqueue_(list, by_priority);
+    }
+
+    /** @brief Registers this waiter as operation @p index of a `select`. */
+    void register_(
+        waiter_list &list,
+        select_core *core,
+        std::size_t index,
+        priority_type priority,
+        bool by_priority = false) {
+        core_ = core;
+        index_ = index;
+        priority_ = priority;
+        enqueue_(list, by_priority);
+    }
+
+    /** @brief Returns the resume token of a standalone waiter. */
+    token *token_() const noexcept {
+        return tkn_;
+    }
+
+public:
+    /**
+     * @brief Resumes the blocked operation; the waiter must be unlinked.
+     *
+     * A standalone waiter schedules its resume token at the current time plus
+     * its latency; a `select` registration completes its select.
+     */
+    void notify_(environment *env) {
+        if (core_) {
+            [[maybe_unused]] bool won = core_->complete(index_);
+            assert(won && "a completed select still had a registered operation");
+        }
+        else {
+            tkn_->time += env->now();
+            env->schedule_token(tkn_);
+            tkn_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief Like `notify_()`, but a standalone waiter is resumed by @p batch.
+     *
+     * A `select` registration still completes its select right away.
+     */
+    void notify_(environment *env, wake_batch &batch);
+
+    /** @brief Unlinks this waiter and frees its token without resuming it. */
+    void discard_() noexcept {
+        if (this->linked()) {
+            this->unlink();
+            if (!core_)
+                delete tkn_;
+            tkn_ = nullptr;
+        }
+    }
+
+private:
+    void enqueue_(waiter_list &list, bool by_priority) {
+        if (!by_priority) {
+            list.push_back(this);
+            return ;
+        }
+
+        // stable: after every waiter with the same or a higher priority
+        auto pos = list.back();
+        while (pos && pos->priority_ > priority_)
+            pos = waiter_list::prev(pos);
+
+        list.insert_before(pos ? waiter_list::next(pos) : list.front(), this);
+    }
+
+    token *tkn_ = nullptr;
+    select_core *core_ = nullptr;
+    std::size_t index_ = 0;
+    priority_type priority_ = 0;
+};
+
+/**
+ * @brief Resumes several waiters with a single scheduled event.
+ *
+ * Waiters added with `waiter::notify_(env, batch)` hand their resume tokens
+ * to the batch. `schedule()` then schedules one token per distinct resume
+ * time whose handler processes the tokens due at that time in the order they
+ * were added, so waking `n` processes with equal latencies costs one event
+ * queue insertion instead of `n`. Each such token runs at the highest
+ * priority among the tokens it carries.
+ */
+struct wake_batch {
+    wake_batch() = default;
+
+    wake_batch(wake_batch const &) = delete;
+    wake_batch &operator=(wake_batch const &) = delete;
+
+    /** @brief Returns the number of collected tokens. */
+    std::size_t size() const noexcept {
+        return tokens_.size();
+    }
+
+    /** @brief Schedules the collected tokens and empties the batch. */
+    void schedule(environment *env) {
+        // waiters with a latency resume later, in a group of their own
+        std::stable_sort(tokens_.begin(), tokens_.end(), [](auto const &a, auto const &b) {
+            return a->time < b->time;
+        });
+
+        for (auto first = tokens_.begin(); first != tokens_.end(); ) {
+            auto last = first;
+            auto time = (*first)->time;
+            auto priority = (*first)->priority;
+
+            for (; last != tokens_.end() && (*last)->time == time; ++last)
+                priority = std::min(priority, (*last)->priority);
+
+            if (last - first == 1) {
+                env->schedule_token(*first);
+            }
+            else {
+                std::vector<memory::ptr<token>> group(std::make_move_iterator(first), std::make_move_iterator(last));
+
+                auto tkn = new token(time, priority, nullptr, "wake batch");
+                tkn->handler = new handler{env, std::move(group)};
+                env->schedule_token(tkn);
+            }
+
+            first = last;
+        }
+
+        tokens_.clear();
+    }
+
+private:
+    friend struct waiter;
+
+    struct handler: token_handler {
+        environment *env;
+        std::vector<memory::ptr<token>> tokens;
+
+        handler(environment *env_, std::vector<memory::ptr<token>> tokens_):
+            env{env_}, tokens{std::move(tokens_)} {
+        }
+
+        void invoke(token *) override {
+            std::size_t k = 0;
+
+            try {
+                for (; k < tokens.size(); ++k)
+                    env->dispatch(tokens[k]);
+            }
+            catch (...) {
+                // as after a throwing step(), the tokens not run yet stay scheduled
+                for (++k; k < tokens.size(); ++k)
+                    env->schedule_token(tokens[k]);
+
+                throw;
+            }
+        }
+    };
+
+    void add_(token *tkn) {
+        tokens_.emplace_back(tkn);
+    }
+
+    std::vector<memory::ptr<token>> tokens_;
+};
+
+inline void waiter::notify_(environment *env, wake_batch &batch) {
+    if (core_) {
+        notify_(env);
+        return ;
+    }
+
+    tkn_->time += env->now();
+    batch.add_(tkn_);
+    tkn_ = nullptr;
+}
+
+/** @brief Notifies and unlinks the first waiter of @p list; it must not be empty. */
+inline void notify_one(waiter_list &list, environment *env) {
+    list.pop_front()->notify_(env);
+}
+
+/** @brief Notifies and unlinks all waiters of @p list in order. */
+inline void notify_all(waiter_list &list, environment *env) {
+    while (!list.empty())
+        notify_one(list, env);
+}
+
+/** @brief Unlinks all waiters of @p list without resuming them. */
+inline void discard_all(waiter_list &list) noexcept {
+    while (!list.empty())
+        list.front()->discard_();
+}
+
+} /* namespace detail */
+
+} /* namespace sync */
+} /* namespace cxxdes */
+
+#endif /* CXXDES_SYNC_WAITER_HPP_INCLUDED */
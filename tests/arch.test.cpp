@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+namespace {
+
+// next level with a fixed latency that counts its accesses
+struct flat_memory: cxxdes::arch::level {
+    flat_memory(time_integral latency_): latency{latency_} {
+    }
+
+    coroutine<> access(cxxdes::arch::addr_type, cxxdes::arch::access_kind kind) override {
+        ++(kind == cxxdes::arch::access_kind::read ? reads : writes);
+        co_await delay(latency);
+    }
+
+    time_integral latency;
+    std::size_t reads = 0;
+    std::size_t writes = 0;
+};
+
+} /* namespace */
+
+TEST(ReplacementTest, Policies) {
+    cxxdes::arch::lru lru{1, 4};
+    for (std::size_t way = 0; way < 4; ++way)
+        lru.fill(0, way);
+    lru.touch(0, 0);
+    EXPECT_EQ(lru.victim(0), 1u);
+
+    cxxdes::arch::tree_plru plru{1, 4};
+    for (std::size_t way = 0; way < 4; ++way)
+        plru.fill(0, way);
+    EXPECT_EQ(plru.victim(0), 0u);
+    plru.touch(0, 0);
+    EXPECT_EQ(plru.victim(0), 2u);
+    EXPECT_THROW((cxxdes::arch::tree_plru{1, 3}), std::runtime_error);
+
+    // the reused way survives while the others are replaced
+    cxxdes::arch::srrip rrip{1, 4};
+    for (std::size_t way = 0; way < 4; ++way)
+        rrip.fill(0, way);
+    rrip.touch(0, 1);
+    EXPECT_EQ(rrip.victim(0), 0u);
+    rrip.fill(0, 0);
+    EXPECT_EQ(rrip.victim(0), 2u);
+    rrip.fill(0, 2);
+    EXPECT_EQ(rrip.victim(0), 3u);
+}
+
+TEST(CacheTest, HitsMissesAndWritebacks) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        flat_memory mem{10};
+        cxxdes::arch::cache<> c{cxxdes::arch::cache_config{64, 1, 2, 2, 1, 1, 1, 4}, &mem};
+        std::vector<time_integral> done;
+
+        coroutine<> co_main() {
+            co_await c.load(0);    // miss
+            done.push_back(now());
+            co_await c.load(8);    // hit, same line
+            done.push_back(now());
+            co_await c.store(64);  // miss, line becomes dirty
+            done.push_back(now());
+            co_await c.load(128);  // miss, evicts the clean line 0
+            done.push_back(now());
+            co_await c.load(0);    // miss, evicts and writes back line 64
+            done.push_back(now());
+        }
+    };
+
+    test t;
+    t.run();
+
+    EXPECT_EQ(t.done, (std::vector<time_integral>{ 12, 14, 26, 38, 50 }));
+    EXPECT_EQ(t.c.hits(), 1u);
+    EXPECT_EQ(t.c.misses(), 4u);
+    EXPECT_EQ(t.c.evictions(), 2u);
+    EXPECT_EQ(t.c.writebacks(), 1u);
+    EXPECT_EQ(t.mem.reads, 4u);
+    EXPECT_EQ(t.mem.writes, 1u);
+    EXPECT_TRUE(t.c.contains(130));
+    EXPECT_FALSE(t.c.contains(64));
+}
+
+TEST(CacheTest, MshrsCoalesceMisses) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        // one bank port and a single MSHR
+        flat_memory mem{10};
+        cxxdes::arch::cache<cxxdes::arch::srrip> c{cxxdes::arch::cache_config{64, 4, 2, 2, 1, 1, 1, 1}, &mem};
+        std::vector<time_integral> done = std::vector<time_integral>(3);
+
+        coroutine<> load(std::size_t i, cxxdes::arch::addr_type addr) {
+            co_await c.load(addr);
+            done[i] = now();
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(load(0, 0), load(1, 4), load(2, 64));
+        }
+    };
+
+    test t;
+    t.run();
+
+    // the second load waits for the fill of the first; the third for the MSHR
+    EXPECT_EQ(t.done, (std::vector<time_integral>{ 12, 12, 22 }));
+    EXPECT_EQ(t.c.misses(), 3u);
+    EXPECT_EQ(t.c.coalesced(), 1u);
+    EXPECT_EQ(t.c.outstanding(), 0u);
+    EXPECT_EQ(t.mem.reads, 2u);
+}
+
+TEST(CacheTest, CoalescedMissAfterEviction) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        // a single line, two ports, and two MSHRs
+        flat_memory mem{10};
+        cxxdes::arch::cache<> c{cxxdes::arch::cache_config{64, 1, 1, 2, 1, 2, 1, 2}, &mem};
+        time_integral stored = -1;
+
+        coroutine<> store() {
+            co_await delay(1);
+            co_await c.store(64);
+            stored = now();
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(c.load(0), c.load(64), store());
+        }
+    };
+
+    test t;
+    t.run();
+
+    // the store waits for the fill of line 64, which makes it dirty, but line
+    // 0 replaces it before the store resumes, so the store misses again
+    EXPECT_EQ(t.stored, 22);
+    EXPECT_EQ(t.c.misses(), 3u);
+    EXPECT_EQ(t.c.coalesced(), 1u);
+    EXPECT_EQ(t.c.writebacks(), 1u);
+    EXPECT_EQ(t.mem.reads, 3u);
+    EXPECT_EQ(t.mem.writes, 1u);
+    EXPECT_TRUE(t.c.contains(64));
+}
+
+TEST(DramTest, RowBufferTiming) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        // four lines per row, two banks
+        cxxdes::arch::dram mem{cxxdes::arch::dram_config{64, 256, 1, 2, 3, 2, 4, 1}};
+        std::vector<time_integral> done;
+
+        coroutine<> co_main() {
+            for (cxxdes::arch::addr_type addr: { 0, 64, 256, 512 }) {
+                co_await mem.load(addr);
+                done.push_back(now());
+            }
+        }
+    };
+
+    test t;
+    t.run();
+
+    // row miss, row hit, row miss in the other bank, row conflict
+    EXPECT_EQ(t.done, (std::vector<time_integral>{ 6, 9, 15, 25 }));
+    EXPECT_EQ(t.mem.row_hits(), 1u);
+    EXPECT_EQ(t.mem.row_misses(), 2u);
+    EXPECT_EQ(t.mem.row_conflicts(), 1u);
+    EXPECT_EQ(t.mem.reads(), 4u);
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+namespace experiment = cxxdes::experiment;
+namespace stats = cxxdes::stats;
+
+namespace {
+
+// mean of exponential gaps with mean 2, observed through the event queue
+CXXDES_SIMULATION(gaps) {
+    gaps(std::uint64_t seed): rng{seed} {
+    }
+
+    std::mt19937_64 rng;
+    stats::tally observed;
+
+    coroutine<> co_main() {
+        std::exponential_distribution<double> gap{0.5};
+
+        for (int i = 0; i < 200; ++i) {
+            auto before = now();
+            co_await delay(static_cast<time_integral>(1000 * gap(rng)));
+            observed.add(static_cast<double>(now() - before) / 1000);
+        }
+    }
+};
+
+}
+
+TEST(ExperimentTest, StudentT) {
+    EXPECT_NEAR(stats::student_t_quantile(0.975, 1), 12.7062, 1e-3);
+    EXPECT_NEAR(stats::student_t_quantile(0.975, 9), 2.2622, 1e-4);
+    EXPECT_NEAR(stats::student_t_quantile(0.995, 30), 2.7500, 1e-4);
+    EXPECT_NEAR(stats::student_t_quantile(0.975, 1e6), 1.9600, 1e-4);
+    EXPECT_NEAR(stats::student_t_quantile(0.025, 9), -2.2622, 1e-4);
+    EXPECT_THROW(stats::student_t_quantile(1, 9), std::runtime_error);
+}
+
+TEST(ExperimentTest, ThreadPool) {
+    std::atomic<int> count = 0;
+
+    {
+        experiment::thread_pool pool{4};
+        EXPECT_EQ(pool.size(), 4u);
+
+        // tasks submitting tasks, which idle workers steal
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&] {
+                for (int j = 0; j < 10; ++j)
+                    pool.submit([&] { ++count; });
+                ++count;
+            });
+        }
+
+        pool.wait();
+        EXPECT_EQ(count, 550);
+
+        pool.submit([] { throw std::runtime_error("failed"); });
+        EXPECT_THROW(pool.wait(), std::runtime_error);
+
+        // the pool is usable after an exception
+        pool.submit([&] { ++count; });
+        pool.wait();
+        EXPECT_EQ(count, 551);
+
+        std::vector<int> squares(20);
+        pool.parallel_for(squares.size(), [&](std::size_t i) { squares[i] = static_cast<int>(i * i); });
+        EXPECT_EQ(squares[19], 361);
+
+        EXPECT_THROW(pool.parallel_for(3, [](std::size_t i) {
+            if (i == 1)
+                throw std::runtime_error("failed");
+        }), std::runtime_error);
+    }
+}
+
+TEST(ExperimentTest, Replications) {
+    auto one = [](experiment::replication r) {
+        gaps sim{r.seed};
+        sim.run();
+        return sim.observed.mean();
+    };
+
+    experiment::replication_config cfg{
+        .min_replications = 5,
+        .max_replications = 400,
+        .half_width = 0.05,
+        .seed = 7,
+        .threads = 1
+    };
+
+    auto serial = experiment::run_replications(cfg, one);
+    EXPECT_TRUE(serial.converged);
+    EXPECT_LE(serial.half_width, 0.05);
+    EXPECT_GE(serial.replications(), 5u);
+    EXPECT_LT(serial.replications(), 400u);
+    EXPECT_NEAR(serial.mean(), 2.0, 0.1);
+
+    // the outcome does not depend on the number of threads
+    cfg.threads = 4;
+    auto parallel = experiment::run_replications(cfg, one);
+    EXPECT_EQ(parallel.replications(), serial.replications());
+    EXPECT_DOUBLE_EQ(parallel.mean(), serial.mean());
+    EXPECT_DOUBLE_EQ(parallel.half_width, serial.half_width);
+
+    // without a target, every replication runs
+    cfg.half_width = 0;
+    cfg.max_replications = 12;
+    auto capped = experiment::run_replications(cfg, one);
+    EXPECT_FALSE(capped.converged);
+    EXPECT_EQ(capped.replications(), 12u);
+
+    cfg.min_replications = 20;
+    EXPECT_THROW(experiment::run_replications(cfg, one), std::runtime_error);
+
+    cfg.min_replications = 2;
+    cfg.confidence = 1;
+    EXPECT_THROW(experiment::run_replications(cfg, one), std::runtime_error);
+    cfg.confidence = 0;
+    EXPECT_THROW(experiment::run_replications(cfg, one), std::runtime_error);
+}
+
+TEST(ExperimentTest, MergedResults) {
+    experiment::replication_config cfg{
+        .min_replications = 8,
+        .max_replications = 8,
+        .seed = 3,
+        .threads = 3
+    };
+
+    auto s = experiment::run_replications(
+        cfg,
+        [](experiment::replication r) {
+            gaps sim{r.seed};
+            sim.run();
+            return sim.observed;
+        },
+        [](stats::tally const &t) { return t.mean(); });
+
+    EXPECT_EQ(s.replications(), 8u);
+    EXPECT_EQ(s.merged.count(), 8u * 200u);
+    EXPECT_NEAR(s.merged.mean(), s.mean(), 1e-9);
+
+    // an exception stops the experiment and reaches the caller
+    EXPECT_THROW(
+        experiment::run_replications(cfg, [](experiment::replication r) -> double {
+            if (r.index == 3)
+                throw std::runtime_error("replication failed");
+            return 1.0;
+        }),
+        std::runtime_error);
+}
+
+TEST(ExperimentTest, Sweep) {
+    // a noisy step at 0.5, observed through a simulation
+    auto step = [](double x, experiment::replication r) {
+        CXXDES_SIMULATION(noisy) {
+            noisy(double x, std::uint64_t seed): x{x}, rng{seed} {
+            }
+
+            double x;
+            std::mt19937_64 rng;
+            double y = 0;
+
+            coroutine<> co_main() {
+                co_await delay(10);
+                y = std::tanh((x - 0.5) * 40) + std::normal_distribution<double>{0, 0.01}(rng);
+            }
+        };
+
+        noisy sim{x, r.seed};
+        sim.run();
+        return sim.y;
+    };
+
+    experiment::sweep_config cfg{
+        .lower = 0,
+        .upper = 1,
+        .initial_points = 5,
+        .max_points = 21,
+        .batch = 4,
+        .replications = { .min_replications = 3, .max_replications = 6, .half_width = 0.01 }
+    };
+
+    std::ostringstream csv;
+    auto points = experiment::sweep(cfg, step, experiment::csv_writer{csv, "x"});
+
+    ASSERT_EQ(points.size(), 21u);
+    EXPECT_TRUE(std::is_sorted(points.begin(), points.end(), [](auto const &a, auto const &b) { return a.parameter < b.parameter; }));
+    EXPECT_EQ(points.front().parameter, 0);
+    EXPECT_EQ(points.back().parameter, 1);
+    EXPECT_EQ(points.back().round, 0u);
+
+    // refinement goes to the step, which a uniform grid of 21 points samples 5 times
+    std::size_t near = 0;
+    for (auto const &p: points)
+        if (std::abs(p.parameter - 0.5) < 0.125)
+            ++near;
+    EXPECT_GE(near, 10u);
+
+    // every point, and the header, is streamed
+    std::size_t lines = 0;
+    for (auto c: csv.str())
+        lines += c == '\n';
+    EXPECT_EQ(lines, points.size() + 1);
+    EXPECT_EQ(csv.str().substr(0, csv.str().find('\n')), "x,round,replications,mean,half_width,converged");
+
+    // the points do not depend on the number of threads
+    cfg.replications.threads = 1;
+    auto serial = experiment::sweep(cfg, step);
+    cfg.replications.threads = 4;
+    auto parallel = experiment::sweep(cfg, step);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].parameter, parallel[i].parameter);
+        EXPECT_EQ(serial[i].summary.mean(), parallel[i].summary.mean());
+        EXPECT_EQ(serial[i].summary.replications(), parallel[i].summary.replications());
+    }
+
+    // a tolerance above every score stops after the first round
+    cfg.tolerance = 10;
+    EXPECT_EQ(experiment::sweep(cfg, step).size(), 5u);
+
+    cfg.initial_points = 1;
+    EXPECT_THROW(experiment::sweep(cfg, step), std::runtime_error);
+
+    cfg.initial_points = 5;
+    cfg.batch = 0;
+    EXPECT_THROW(experiment::sweep(cfg, step), std::runtime_error);
+}
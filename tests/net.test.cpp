@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+namespace {
+
+// sends one packet across a mesh and returns its delivery time
+time_integral one_packet(cxxdes::net::network_config const &config, std::size_t cols, std::uint32_t flits, std::uint32_t *hops = nullptr) {
+    CXXDES_SIMULATION(test) {
+        test(cxxdes::net::network_config const &config, std::size_t cols, std::uint32_t flits_):
+            net{cols, 2, config}, flits{flits_} {
+        }
+
+        cxxdes::net::mesh net;
+        std::uint32_t flits;
+        time_integral delivered = 0;
+        std::uint32_t hops = 0;
+
+        coroutine<> co_main() {
+            auto dst = net.node(net.cols() - 1, 1);
+            auto p = net.make_packet(net.node(0, 0), dst, flits);
+            co_await net.send(p);
+
+            auto q = co_await net.receive(dst);
+            EXPECT_EQ(q, p);
+            delivered = q->delivered;
+            hops = q->hops;
+            net.release(q);
+        }
+    };
+
+    test t{config, cols, flits};
+    t.run();
+
+    if (hops)
+        *hops = t.hops;
+    return t.delivered;
+}
+
+} /* namespace */
+
+TEST(NetworkTest, ZeroLoadLatency) {
+    cxxdes::net::network_config config;
+
+    // one cycle per hop, and the body follows the head flit by flit
+    std::uint32_t hops = 0;
+    EXPECT_EQ(one_packet(config, 3, 1, &hops), 3);
+    EXPECT_EQ(hops, 3u);
+    EXPECT_EQ(one_packet(config, 3, 4), 6);
+
+    config.link_latency = 3;
+    EXPECT_EQ(one_packet(config, 3, 1), 9);
+}
+
+TEST(NetworkTest, CreditsLimitShallowBuffers) {
+    cxxdes::net::network_config config;
+
+    // with a single buffer slot, each flit waits for the credit of the previous one
+    config.buffer_depth = 1;
+    EXPECT_EQ(one_packet(config, 2, 4), 8);
+
+    config.buffer_depth = 4;
+    EXPECT_EQ(one_packet(config, 2, 4), 5);
+}
+
+TEST(NetworkTest, TorusWrapsAround) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::net::torus net{4, 1};
+
+        coroutine<> co_main() {
+            co_await net.send(net.make_packet(0, 3));
+
+            auto p = co_await net.receive(3);
+            EXPECT_EQ(p->hops, 1u);
+            EXPECT_EQ(now(), 1);
+            net.release(p);
+        }
+    };
+
+    test t;
+    t.run();
+    EXPECT_EQ(t.net.delivered(), 1u);
+}
+
+TEST(NetworkTest, UniformTrafficDrains) {
+    CXXDES_SIMULATION(test) {
+        test(cxxdes::net::allocation_policy allocation):
+            net{4, 4, make_config(allocation)} {
+        }
+
+        static cxxdes::net::network_config make_config(cxxdes::net::allocation_policy allocation) {
+            cxxdes::net::network_config config;
+            config.buffer_depth = 2;
+            config.allocation = allocation;
+            return config;
+        }
+
+        cxxdes::net::torus net;
+        std::size_t received = 0;
+
+        coroutine<> source(cxxdes::net::node_id node) {
+            std::mt19937 rng{static_cast<unsigned>(node)};
+            std::uniform_int_distribution<cxxdes::net::node_id> dst{0, net.routers() - 1};
+
+            for (int i = 0; i < 50; ++i) {
+                co_await net.send(net.make_packet(node, dst(rng), 3));
+                co_await delay(2);
+            }
+        }
+
+        coroutine<> sink(cxxdes::net::node_id node) {
+            while (true) {
+                auto p = co_await net.receive(node);
+                EXPECT_EQ(p->dst, node);
+                ++received;
+                net.release(p);
+            }
+        }
+
+        coroutine<> co_main() {
+            for (cxxdes::net::node_id n = 0; n < net.routers(); ++n) {
+                co_await async(source(n));
+                co_await async(sink(n));
+            }
+        }
+    };
+
+    for (auto allocation: { cxxdes::net::allocation_policy::round_robin, cxxdes::net::allocation_policy::oldest_first }) {
+        test t{allocation};
+        t.run();
+
+        EXPECT_EQ(t.received, 16u * 50u);
+        EXPECT_EQ(t.net.in_flight(), 0u);
+        EXPECT_EQ(t.net.pool().live(), 0u);
+        EXPECT_LT(t.net.pool().allocated(), 16u * 50u);
+    }
+}
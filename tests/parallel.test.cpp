@@ -0,0 +1,492 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+namespace parallel = cxxdes::parallel;
+
+namespace {
+
+// returns every ball one tick after it arrives, recording the arrivals
+template <typename Channel>
+coroutine<> player(Channel &out, Channel &in, bool serve, int rounds, std::vector<time_integral> &arrivals) {
+    auto env = co_await this_environment();
+
+    if (serve)
+        out.send(0);
+
+    for (int i = 0; i < rounds; ++i) {
+        auto x = co_await in.pop();
+        EXPECT_EQ(x, 2 * i + (serve ? 1 : 0));
+        arrivals.push_back(env->now());
+
+        co_await delay(1);
+        out.send(x + 1);
+    }
+}
+
+// forwards every token around a ring with a random extra delay
+template <typename Channel>
+coroutine<> forwarder(Channel &out, Channel &in, std::uint64_t seed, std::vector<time_integral> &arrivals) {
+    auto env = co_await this_environment();
+    std::mt19937_64 rng{seed};
+
+    for (int k = 0; k < 3; ++k)
+        out.send(k, out.lookahead() + k);
+
+    while (true) {
+        auto x = co_await in.pop();
+        arrivals.push_back(env->now());
+        out.send(x, out.lookahead() + static_cast<time_integral>(rng() % 10));
+    }
+}
+
+struct ring_outcome {
+    std::vector<std::size_t> counts;
+    std::vector<time_integral> sums;
+    std::vector<time_integral> ends;
+};
+
+ring_outcome run_ring(parallel::synchronization sync) {
+    constexpr std::size_t n = 4;
+    std::vector<std::vector<time_integral>> arrivals(n);
+
+    parallel::engine e{sync};
+    for (std::size_t i = 0; i < n; ++i)
+        e.add_partition();
+
+    std::vector<parallel::channel<int> *> links;
+    for (std::size_t i = 0; i < n; ++i)
+        links.push_back(&e.connect<int>(e[i], e[(i + 1) % n], 5 + static_cast<time_integral>(i)));
+
+    for (std::size_t i = 0; i < n; ++i)
+        e[i].env.bind(forwarder(*links[i], *links[(i + n - 1) % n], i + 1, arrivals[i]));
+
+    e.run_until(2000);
+
+    if (sync == parallel::synchronization::window)
+        EXPECT_GT(e.windows(), 0u);
+    else
+        EXPECT_GT(e.null_messages(), 0u);
+
+    // the arrivals are compared as multisets, as messages that arrive at the
+    // same time may be popped in either order
+    ring_outcome r;
+    for (std::size_t i = 0; i < n; ++i) {
+        time_integral sum = 0;
+        for (auto t: arrivals[i])
+            sum += t;
+
+        r.counts.push_back(arrivals[i].size());
+        r.sums.push_back(sum);
+        r.ends.push_back(e[i].env.now());
+    }
+
+    return r;
+}
+
+// state of one core of a pipeline, touched only by processes of its partition
+struct core_state {
+    std::uint64_t acc = 0;
+    std::uint64_t staged = 0;
+    int stages = 0;
+    std::vector<time_integral> edges;
+
+    bool operator==(core_state const &) const = default;
+};
+
+coroutine<> stage(core_state &s, std::uint64_t x) {
+    co_await delay(2);
+    s.staged = s.staged * 31 + x;
+    ++s.stages;
+}
+
+coroutine<> record(std::vector<std::size_t> &commits, std::size_t i) {
+    commits.push_back(i);
+    co_return ;
+}
+
+// advances at every clock edge, with stages that inherit its partition
+coroutine<> core(core_state &s, std::size_t i, std::vector<std::size_t> &commits) {
+    auto env = co_await this_environment();
+
+    for (std::uint64_t cycle = 0; cycle < 50; ++cycle) {
+        co_await delay(1);
+        s.acc = s.acc * 6364136223846793005ull + i + cycle;
+        s.edges.push_back(env->now());
+
+        if (cycle % 10 == 0)
+            co_await async(stage(s, i));
+
+        // started outside the partitions, in the order of the commit
+        if (cycle == 25)
+            co_await async(record(commits, i).partition(partition_consts::none));
+    }
+}
+
+struct pipeline_outcome {
+    std::vector<core_state> cores;
+    std::vector<std::size_t> commits;
+    std::uint64_t batches;
+};
+
+coroutine<> urgent(std::string &log) {
+    log += 'U';
+    co_return ;
+}
+
+// starts an urgent process of partition target at the time of the batch
+coroutine<> starter(std::string &log, partition_type target) {
+    co_await delay(1);
+    log += 'A';
+    co_await async(urgent(log).priority(-5).partition(target));
+}
+
+coroutine<> bystander(std::string &log) {
+    co_await delay(1);
+    log += 'B';
+}
+
+std::string run_priorities(partition_type target, bool batched) {
+    std::string log;
+
+    environment env;
+    if (batched) {
+        // runs the partitions one after another, so that they may share the log
+        env.parallel_partitions([](std::size_t n, auto const &task) {
+            for (std::size_t i = 0; i < n; ++i)
+                task(i);
+        });
+    }
+
+    env.bind(starter(log, target).partition(0));
+    env.bind(bystander(log).partition(1));
+    env.run();
+    return log;
+}
+
+// zero threads runs without an executor
+pipeline_outcome run_pipeline(std::size_t threads) {
+    constexpr std::size_t n = 8;
+
+    pipeline_outcome r;
+    r.cores.resize(n);
+
+    std::unique_ptr<cxxdes::experiment::thread_pool> pool;
+    environment env;
+
+    if (threads > 0) {
+        pool = std::make_unique<cxxdes::experiment::thread_pool>(threads);
+        env.parallel_partitions([&](std::size_t k, auto const &task) {
+            pool->parallel_for(k, task);
+        });
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+        env.bind(core(r.cores[i], i, r.commits).partition(i));
+
+    env.run();
+    r.batches = env.partition_batches();
+
+    // a recycled environment counts anew
+    env.recycle();
+    EXPECT_EQ(env.partition_batches(), 0u);
+    return r;
+}
+
+// runs fn(node) in n processes, each with the transport make(rank), and returns their results
+template <typename MakeTransport, typename Fn>
+auto run_ranks(std::size_t n, MakeTransport make, Fn fn) {
+    environment scratch;
+    return fork_scenarios(scratch, n, [&](std::size_t r) {
+        auto t = make(r);
+        parallel::node nd{t};
+        return fn(nd);
+    });
+}
+
+// makes the transport of a rank out of the endpoints of a mesh, dropping the others
+template <typename Transport>
+auto from_mesh(std::vector<Transport> &mesh) {
+    return [&](std::size_t r) {
+        auto t = std::move(mesh[r]);
+        mesh.clear();
+        return t;
+    };
+}
+
+struct rank_outcome {
+    std::size_t count;
+    time_integral arrivals[10];
+    time_integral sum;
+    time_integral end;
+    std::uint64_t windows;
+};
+
+template <typename MakeTransport>
+void check_remote_ping_pong(MakeTransport make) {
+    auto results = run_ranks(2, make, [](parallel::node &nd) {
+        auto &pq = nd.connect<int>(0, 1, 5);
+        auto &qp = nd.connect<int>(1, 0, 5);
+
+        std::vector<time_integral> arrivals;
+        if (nd.rank() == 0)
+            nd.env.bind(player(pq, qp, true, 10, arrivals));
+        else
+            nd.env.bind(player(qp, pq, false, 10, arrivals));
+
+        nd.run();
+
+        rank_outcome r{};
+        r.count = arrivals.size();
+        std::copy_n(arrivals.begin(), std::min<std::size_t>(arrivals.size(), 10), r.arrivals);
+        r.windows = nd.windows();
+        return r;
+    });
+
+    ASSERT_EQ(results.size(), 2u);
+    ASSERT_EQ(results[0].count, 10u);
+    ASSERT_EQ(results[1].count, 10u);
+    EXPECT_EQ(results[0].windows, results[1].windows);
+
+    for (time_integral i = 0; i < 10; ++i) {
+        EXPECT_EQ(results[1].arrivals[i], 5 + 12 * i);
+        EXPECT_EQ(results[0].arrivals[i], 11 + 12 * i);
+    }
+}
+
+template <typename MakeTransport>
+void check_remote_ring(MakeTransport make) {
+    constexpr std::size_t n = 4;
+
+    auto results = run_ranks(n, make, [](parallel::node &nd) {
+        std::vector<parallel::remote_channel<int> *> links;
+        for (std::size_t i = 0; i < n; ++i)
+            links.push_back(&nd.connect<int>(i, (i + 1) % n, 5 + static_cast<time_integral>(i)));
+
+        auto i = nd.rank();
+        std::vector<time_integral> arrivals;
+        nd.env.bind(forwarder(*links[i], *links[(i + n - 1) % n], i + 1, arrivals));
+        nd.run_until(2000);
+
+        rank_outcome r{};
+        r.count = arrivals.size();
+        for (auto t: arrivals)
+            r.sum += t;
+        r.end = nd.env.now();
+        return r;
+    });
+
+    // the same model as threads
+    auto threads = run_ring(parallel::synchronization::window);
+
+    ASSERT_EQ(results.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(results[i].count, threads.counts[i]);
+        EXPECT_EQ(results[i].sum, threads.sums[i]);
+        EXPECT_EQ(results[i].end, 2000);
+    }
+}
+
+}
+
+TEST(ParallelTest, PingPong) {
+    for (auto sync: { parallel::synchronization::window, parallel::synchronization::null_messages }) {
+        std::vector<time_integral> a, b;
+
+        parallel::engine e{sync};
+        auto &p = e.add_partition();
+        auto &q = e.add_partition();
+        EXPECT_EQ(q.index(), 1u);
+
+        auto &pq = e.connect<int>(p, q, 5);
+        auto &qp = e.connect<int>(q, p, 5);
+        p.env.bind(player(pq, qp, true, 10, a));
+        q.env.bind(player(qp, pq, false, 10, b));
+
+        if (sync == parallel::synchronization::window)
+            e.run();
+        else
+            e.run_until(1000);
+
+        // 5 ticks of lookahead and 1 tick of service per hop
+        ASSERT_EQ(a.size(), 10u);
+        ASSERT_EQ(b.size(), 10u);
+        for (time_integral i = 0; i < 10; ++i) {
+            EXPECT_EQ(b[i], 5 + 12 * i);
+            EXPECT_EQ(a[i], 11 + 12 * i);
+        }
+    }
+}
+
+TEST(ParallelTest, SynchronizationsAgree) {
+    auto windows = run_ring(parallel::synchronization::window);
+    auto nulls = run_ring(parallel::synchronization::null_messages);
+
+    EXPECT_EQ(windows.counts, nulls.counts);
+    EXPECT_EQ(windows.sums, nulls.sums);
+
+    for (std::size_t i = 0; i < windows.counts.size(); ++i) {
+        EXPECT_GT(windows.counts[i], 100u);
+        EXPECT_EQ(windows.ends[i], 2000);
+        EXPECT_EQ(nulls.ends[i], 2000);
+    }
+}
+
+TEST(ParallelTest, Errors) {
+    parallel::engine e{parallel::synchronization::null_messages};
+    auto &p = e.add_partition();
+    auto &q = e.add_partition();
+
+    parallel::engine other;
+    auto &r = other.add_partition();
+
+    EXPECT_THROW(e.connect<int>(p, q, 0), std::runtime_error);
+    EXPECT_THROW(e.connect<int>(p, r, 1), std::runtime_error);
+    EXPECT_THROW(e.run(), std::runtime_error);
+
+    auto &pq = e.connect<int>(p, q, 2);
+    EXPECT_THROW(pq.send(1, 1), std::runtime_error);
+
+    // an exception in one partition stops all of them
+    for (auto sync: { parallel::synchronization::window, parallel::synchronization::null_messages }) {
+        parallel::engine f{sync};
+        auto &a = f.add_partition();
+        auto &b = f.add_partition();
+        f.connect<int>(a, b, 1);
+
+        a.env.bind([]() -> coroutine<> {
+            co_await delay(10);
+            throw std::runtime_error("partition failed");
+        }());
+
+        b.env.bind([]() -> coroutine<> {
+            while (true)
+                co_await delay(1);
+        }());
+
+        EXPECT_THROW(f.run_until(100), std::runtime_error);
+    }
+}
+
+TEST(ParallelTest, RemotePingPong) {
+    auto sockets = parallel::socket_transport::mesh(2);
+    check_remote_ping_pong(from_mesh(sockets));
+
+    auto rings = parallel::shm_transport::mesh(2, 64);
+    check_remote_ping_pong(from_mesh(rings));
+
+    // processes that find each other through socket files
+    auto prefix = "/tmp/cxxdes-parallel-" + std::to_string(::getpid()) + "-";
+    check_remote_ping_pong([&](std::size_t r) {
+        return parallel::socket_transport::connect(prefix, r, 2);
+    });
+}
+
+TEST(ParallelTest, RemoteMatchesThreads) {
+    auto sockets = parallel::socket_transport::mesh(4);
+    check_remote_ring(from_mesh(sockets));
+
+    auto rings = parallel::shm_transport::mesh(4);
+    check_remote_ring(from_mesh(rings));
+}
+
+TEST(ParallelTest, RemoteErrors) {
+    auto sockets = parallel::socket_transport::mesh(2);
+
+    {
+        parallel::node nd{sockets[0]};
+        EXPECT_EQ(nd.size(), 2u);
+        EXPECT_THROW(nd.connect<int>(0, 1, 0), std::runtime_error);
+        EXPECT_THROW(nd.connect<int>(0, 0, 1), std::runtime_error);
+        EXPECT_THROW(nd.connect<int>(0, 2, 1), std::runtime_error);
+
+        auto &qp = nd.connect<int>(1, 0, 1);
+        EXPECT_THROW(qp.send(1), std::runtime_error);
+
+        auto &pq = nd.connect<int>(0, 1, 2);
+        EXPECT_THROW(pq.send(1, 1), std::runtime_error);
+    }
+
+    // an exception in one process stops all of them
+    struct outcome {
+        bool own;
+        bool other;
+    };
+
+    auto results = run_ranks(2, from_mesh(sockets), [](parallel::node &nd) {
+        nd.connect<int>(0, 1, 1);
+
+        if (nd.rank() == 0) {
+            nd.env.bind([]() -> coroutine<> {
+                co_await delay(10);
+                throw std::logic_error("partition failed");
+            }());
+        }
+        else {
+            nd.env.bind([]() -> coroutine<> {
+                while (true)
+                    co_await delay(1);
+            }());
+        }
+
+        outcome r{};
+        try {
+            nd.run_until(100);
+        }
+        catch (std::logic_error const &) {
+            r.own = true;
+        }
+        catch (std::runtime_error const &) {
+            r.other = true;
+        }
+        return r;
+    });
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].own);
+    EXPECT_TRUE(results[1].other);
+}
+
+TEST(ParallelTest, IntraTimestamp) {
+    auto c = core_state{};
+    std::vector<std::size_t> commits;
+    EXPECT_EQ(core(c, 0, commits).partition(3).partition(), 3u);
+
+    auto serial = run_pipeline(0);
+    auto one = run_pipeline(1);
+    auto four = run_pipeline(4);
+
+    EXPECT_EQ(serial.batches, 0u);
+    EXPECT_GT(four.batches, 50u);
+
+    for (std::size_t i = 0; i < serial.cores.size(); ++i) {
+        EXPECT_EQ(serial.cores[i].edges.size(), 50u);
+        EXPECT_EQ(serial.cores[i].stages, 5);
+        EXPECT_EQ(one.cores[i], serial.cores[i]);
+        EXPECT_EQ(four.cores[i], serial.cores[i]);
+    }
+
+    // the commit order does not depend on the threads
+    EXPECT_EQ(serial.commits.size(), 8u);
+    EXPECT_EQ(one.commits, four.commits);
+    EXPECT_EQ(four.commits, run_pipeline(4).commits);
+}
+
+TEST(ParallelTest, IntraTimestampPriorities) {
+    // the urgent process runs right after the event that started it
+    auto serial = run_priorities(partition_consts::inherit, false);
+    EXPECT_NE(serial.find("AU"), std::string::npos);
+    EXPECT_EQ(serial.size(), 3u);
+    EXPECT_EQ(run_priorities(partition_consts::inherit, true), "AUB");
+
+    // of another partition, it cannot
+    EXPECT_THROW(run_priorities(1, true), std::runtime_error);
+}
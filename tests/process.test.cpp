@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
+#include <string>
+#include <csignal>
+#include <cstdlib>
 
 #include <cxxdes/cxxdes.hpp>
 
@@ -146,6 +152,294 @@ TEST(ProcessTest, RunForStopsBeforeFutureEvent) {
     EXPECT_TRUE(sim.completed);
 }
 
+TEST(ProcessTest, ForkScenarios) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        int rate = 1;
+        long total = 0;
+
+        coroutine<> co_main() {
+            for (int i = 0; i < 200; ++i) {
+                co_await delay(1);
+                total += rate;
+            }
+        }
+    };
+
+    struct outcome {
+        long total;
+        time_integral end;
+    };
+
+    test sim;
+    sim.run_for(100);
+    auto warm = sim.total;
+
+    // every scenario continues from the warmed-up state with its own rate
+    auto results = fork_scenarios(sim, 3, [&](std::size_t i) {
+        sim.rate = static_cast<int>(i) + 2;
+        sim.env.run();
+        return outcome{sim.total, sim.now()};
+    });
+
+    ASSERT_EQ(results.size(), 3u);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].total, warm + (200 - warm) * static_cast<long>(i + 2));
+        EXPECT_EQ(results[i].end, 200);
+    }
+
+    // the parent is left at the warm-up point
+    EXPECT_EQ(sim.total, warm);
+    EXPECT_EQ(sim.now(), 100);
+
+    try {
+        fork_scenarios(sim, 2, [&](std::size_t i) {
+            if (i == 1)
+                throw std::runtime_error("boom");
+            return 0;
+        });
+        FAIL();
+    }
+    catch (std::runtime_error const &e) {
+        EXPECT_STREQ(e.what(), "scenario 1 threw: boom");
+    }
+
+    // a child that dies or exits early reports its status, not a result
+    try {
+        fork_scenarios(sim, 2, [&](std::size_t i) {
+            if (i == 0)
+                std::_Exit(3);
+            return 0;
+        });
+        FAIL();
+    }
+    catch (std::runtime_error const &e) {
+        EXPECT_STREQ(e.what(), "scenario 0 exited with status 3");
+    }
+
+    try {
+        fork_scenarios(sim, 2, [&](std::size_t i) {
+            if (i == 1)
+                std::abort();
+            return 0;
+        });
+        FAIL();
+    }
+    catch (std::runtime_error const &e) {
+        EXPECT_EQ(std::string{e.what()}, fmt::format("scenario 1 was killed by signal {}", SIGABRT));
+    }
+
+    sim.env.run();
+    EXPECT_EQ(sim.total, 200);
+}
+
+TEST(ProcessTest, Post) {
+    constexpr int producers = 4;
+    constexpr int posts = 500;
+
+    environment env;
+    int received = 0;
+    time_integral last = 0;
+    bool ordered = true;
+
+    // keeps the simulation going while other threads post
+    env.bind([](environment &env, int &received) -> coroutine<> {
+        while (received < producers * posts)
+            co_await delay(1);
+        EXPECT_EQ(env.dropped_posts(), 0u);
+    }(env, received));
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            for (int k = 0; k < posts; ++k) {
+                env.post(k, [&] {
+                    ordered = ordered && env.now() >= last;
+                    last = env.now();
+                    ++received;
+                });
+            }
+        });
+    }
+
+    env.run();
+    for (auto &t: threads)
+        t.join();
+
+    EXPECT_EQ(received, producers * posts);
+    EXPECT_TRUE(ordered);
+
+    // events posted for the past
+    auto now = env.now() + 10;
+    env.run_until(now);
+
+    time_integral at = -1;
+    env.post(now - 5, [&] { at = env.now(); });
+    env.run();
+    EXPECT_EQ(at, now);
+
+    env.late_posts(late_post_policy::drop);
+    env.post(now - 5, [&] { at = -1; });
+    env.post(now + 5, [&] { at = env.now(); });
+    env.run();
+    EXPECT_EQ(at, now + 5);
+    EXPECT_EQ(env.dropped_posts(), 1u);
+
+    env.late_posts(late_post_policy::fail);
+    env.post(0, [] {});
+    EXPECT_THROW(env.step(), std::runtime_error);
+
+    // tokens may be posted too
+    auto tkn = new token(0, priority_consts::zero, nullptr, "posted exception");
+    tkn->eptr = std::make_exception_ptr(std::logic_error("posted"));
+    env.post(now + 20, tkn);
+    EXPECT_THROW(env.run(), std::logic_error);
+    EXPECT_EQ(env.now(), now + 20);
+
+    // a recycled environment counts anew, but keeps its settings
+    env.recycle();
+    EXPECT_EQ(env.dropped_posts(), 0u);
+    EXPECT_EQ(env.late_posts(), late_post_policy::fail);
+}
+
+TEST(ProcessTest, Realtime) {
+    using clock = std::chrono::steady_clock;
+    using namespace std::chrono_literals;
+    using namespace cxxdes::time_utils::ops;
+
+    auto ticker = [](int n) -> coroutine<> {
+        for (int i = 0; i < n; ++i)
+            co_await delay(5);
+    };
+
+    // one tick is a millisecond, run twice as fast as the wall clock
+    environment env;
+    env.time_precision(1_ms);
+    env.bind(ticker(20));
+
+    auto begin = clock::now();
+    auto report = run_realtime(env, 2);
+    auto elapsed = clock::now() - begin;
+
+    EXPECT_EQ(env.now(), 100);
+    EXPECT_GE(elapsed, 50ms);
+    EXPECT_LT(elapsed, 5s);
+    EXPECT_EQ(report.steps, 21u);
+    EXPECT_EQ(report.slack.count() + report.overrun.count(), 21u);
+    EXPECT_EQ(report.jitter.count(), report.slack.count());
+
+    EXPECT_THROW(run_realtime(env, 0), std::runtime_error);
+
+    // an idle run waits for the end, taking posted events meanwhile
+    time_integral at = -1;
+    std::thread poster{[&] {
+        std::this_thread::sleep_for(5ms);
+        env.post(0, [&] { at = env.now(); });
+    }};
+
+    begin = clock::now();
+    run_realtime(env, 1, { .until = 130 });
+    elapsed = clock::now() - begin;
+    poster.join();
+
+    EXPECT_EQ(env.now(), 130);
+    EXPECT_GE(elapsed, 30ms);
+    EXPECT_GE(at, 100);
+    EXPECT_LT(at, 130);
+
+    // an event that takes longer than the time to the next one
+    auto slow = [](int n) -> coroutine<> {
+        for (int i = 0; i < n; ++i) {
+            std::this_thread::sleep_for(20ms);
+            co_await delay(1);
+        }
+    };
+
+    env.bind(slow(3));
+    report = run_realtime(env, 1);
+    EXPECT_GE(report.overrun.count(), 2u);
+    EXPECT_GE(report.overrun.max(), 0.015);
+
+    env.bind(slow(3));
+    EXPECT_THROW(run_realtime(env, 1, { .mode = realtime_mode::strict, .tolerance = 5ms }), std::runtime_error);
+
+    // a strict run with the default tolerance that keeps up, starting with an event due at once
+    environment fresh;
+    fresh.time_precision(1_ms);
+    fresh.bind(ticker(4));
+    report = run_realtime(fresh, 1, { .mode = realtime_mode::strict });
+    EXPECT_EQ(report.steps, 5u);
+    EXPECT_EQ(report.overrun.count(), 0u);
+
+    // a simulation binds co_main() first
+    CXXDES_SIMULATION(paced) {
+        using simulation::simulation;
+
+        coroutine<> co_main() {
+            co_await delay(10);
+        }
+    };
+
+    paced sim;
+    sim.env.time_precision(1_ms);
+    report = run_realtime(sim, 1);
+    EXPECT_EQ(sim.now(), 10);
+    EXPECT_EQ(report.steps, 2u);
+}
+
+TEST(ProcessTest, Recycle) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        int finished = 0;
+
+        coroutine<> worker(int i) {
+            co_await delay(i);
+            ++finished;
+        }
+
+        coroutine<> co_main() {
+            for (int i = 1; i <= 100; ++i)
+                co_await async(worker(i));
+            co_await delay(100);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.finished, 100);
+    EXPECT_EQ(sim.now(), 100);
+
+    // a recycled simulation runs again from time zero, and may be reconfigured
+    auto capacity = sim.env.event_capacity();
+    EXPECT_GE(capacity, 100u);
+
+    sim.recycle();
+    sim.finished = 0;
+    EXPECT_EQ(sim.now(), 0);
+    EXPECT_EQ(sim.env.event_capacity(), capacity);
+    EXPECT_NO_THROW(sim.env.time_unit(one_second));
+
+    sim.run_for(50);
+    EXPECT_EQ(sim.finished, 50);
+
+    // unfinished processes are destroyed, as by reset()
+    sim.recycle();
+    sim.finished = 0;
+    EXPECT_EQ(sim.now(), 0);
+    EXPECT_EQ(sim.env.next_event(), nullptr);
+
+    sim.run();
+    EXPECT_EQ(sim.finished, 100);
+    EXPECT_EQ(sim.now(), 100);
+    EXPECT_EQ(sim.env.event_capacity(), capacity);
+
+    // unlike reset(), which releases the storage
+    sim.env.reset();
+    EXPECT_EQ(sim.env.event_capacity(), 0u);
+}
+
 TEST(ProcessTest, Priorities) {
     CXXDES_SIMULATION(test) {
         using simulation::simulation;
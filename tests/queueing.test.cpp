@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+using namespace cxxdes::time_utils::ops;
+
+namespace queueing = cxxdes::queueing;
+
+namespace {
+
+struct mmc_result {
+    double sojourn = 0;
+    double in_system = 0;
+    double utilization = 0;
+    std::uint64_t jobs = 0;
+    std::size_t allocated = 0;
+};
+
+// simulates an M/M/c station until it served `jobs` jobs
+mmc_result simulate_mmc(double lambda, double mu, std::size_t c, queueing::discipline d, std::uint64_t jobs) {
+    CXXDES_SIMULATION(test) {
+        test(double lambda, double mu, std::size_t c, queueing::discipline d):
+            out{env, pool},
+            st{env, c, queueing::exponential{mu, 7}, d},
+            src{env, pool, st, lambda, 3} {
+            env.time_precision(1_us);
+            st.connect(out);
+        }
+
+        queueing::job_pool pool;
+        queueing::sink out;
+        queueing::station st;
+        queueing::poisson_source src;
+
+        coroutine<> co_main() {
+            src.start();
+            co_return ;
+        }
+    };
+
+    test t{lambda, mu, c, d};
+    t.src.limit(jobs);
+    t.run();
+
+    EXPECT_EQ(t.pool.live(), 0u);
+    return mmc_result{t.out.mean(), t.st.mean_in_system(), t.st.utilization(), t.out.count(), t.pool.allocated()};
+}
+
+// collects the creation times of the jobs in the order they leave
+struct recorder: queueing::node {
+    recorder(environment &env, queueing::job_pool &pool): env{env}, pool{pool} {
+    }
+
+    void accept(queueing::job *j) override {
+        created.push_back(j->created / env.real_to_sim(1_ms));
+        pool.release(j);
+    }
+
+    environment &env;
+    queueing::job_pool &pool;
+    std::vector<time_integral> created;
+};
+
+std::vector<time_integral> service_order(queueing::discipline d) {
+    CXXDES_SIMULATION(test) {
+        test(queueing::discipline d):
+            out{env, pool},
+            st{env, 1, queueing::deterministic{1}, d},
+            low{env, pool, st, {0, 0.1, 0.2}},
+            high{env, pool, st, {0.3}} {
+            env.time_precision(1_ms);
+            st.connect(out);
+            low.classify(0, 5);
+            high.classify(1, 1);
+        }
+
+        queueing::job_pool pool;
+        recorder out;
+        queueing::station st;
+        queueing::trace_source low;
+        queueing::trace_source high;
+
+        coroutine<> co_main() {
+            low.start();
+            high.start();
+            co_return ;
+        }
+    };
+
+    test t{d};
+    t.run();
+    return t.out.created;
+}
+
+} /* namespace */
+
+TEST(QueueingTest, ErlangC) {
+    // M/M/2 with an offered load of 1.5
+    EXPECT_NEAR(queueing::erlang_c(2, 1.5), 0.642857, 1e-6);
+    EXPECT_NEAR(queueing::mmc_sojourn_time(1.5, 1, 2), 16.0 / 7.0, 1e-9);
+    EXPECT_NEAR(queueing::mmc_sojourn_time(0.5, 1, 1), 2, 1e-9);
+    EXPECT_THROW(queueing::erlang_c(2, 2), std::runtime_error);
+}
+
+TEST(QueueingTest, MatchesMMc) {
+    struct {
+        double lambda;
+        std::size_t c;
+    } cases[] = { {0.5, 1}, {1.5, 2}, {3.2, 4} };
+
+    for (auto const &x: cases) {
+        auto r = simulate_mmc(x.lambda, 1, x.c, queueing::discipline::fifo, 100'000);
+
+        EXPECT_EQ(r.jobs, 100'000u);
+        EXPECT_NEAR(r.sojourn, queueing::mmc_sojourn_time(x.lambda, 1, x.c), 0.05 * queueing::mmc_sojourn_time(x.lambda, 1, x.c));
+        EXPECT_NEAR(r.in_system, queueing::mmc_in_system(x.lambda, 1, x.c), 0.05 * queueing::mmc_in_system(x.lambda, 1, x.c));
+        EXPECT_NEAR(r.utilization, x.lambda / static_cast<double>(x.c), 0.02);
+
+        // descriptors are reused
+        EXPECT_LT(r.allocated, 1000u);
+    }
+}
+
+TEST(QueueingTest, DisciplinesShareTheMeanOfMMc) {
+    // with exponential service, the mean sojourn time does not depend on the order of service
+    for (auto d: { queueing::discipline::lifo, queueing::discipline::processor_sharing, queueing::discipline::priority }) {
+        auto r = simulate_mmc(0.5, 1, 1, d, 100'000);
+        EXPECT_NEAR(r.sojourn, 2, 0.1);
+    }
+
+    auto r = simulate_mmc(1.5, 1, 2, queueing::discipline::processor_sharing, 100'000);
+    EXPECT_NEAR(r.sojourn, 16.0 / 7.0, 0.05 * 16.0 / 7.0);
+    EXPECT_NEAR(r.utilization, 0.75, 0.02);
+}
+
+TEST(QueueingTest, ServiceOrder) {
+    using v = std::vector<time_integral>;
+
+    // jobs created at 0, 100, and 200 ms with priority 5, and at 300 ms with priority 1
+    EXPECT_EQ(service_order(queueing::discipline::fifo), (v{0, 100, 200, 300}));
+    EXPECT_EQ(service_order(queueing::discipline::lifo), (v{0, 300, 200, 100}));
+    EXPECT_EQ(service_order(queueing::discipline::priority), (v{0, 300, 100, 200}));
+
+    // under processor sharing, the first job has the least work left at every point
+    EXPECT_EQ(service_order(queueing::discipline::processor_sharing), (v{0, 100, 200, 300}));
+}
+
+TEST(QueueingTest, RoutersBalanceLoad) {
+    enum class policy { random, jsq, power_of_two };
+
+    auto simulate = [](policy p) {
+        CXXDES_SIMULATION(test) {
+            test(policy p):
+                out{env, pool},
+                st0{env, 1, queueing::exponential{1, 10}},
+                st1{env, 1, queueing::exponential{1, 11}},
+                st2{env, 1, queueing::exponential{1, 12}},
+                st3{env, 1, queueing::exponential{1, 13}},
+                random{{&st0, &st1, &st2, &st3}, {1, 1, 1, 1}, 5},
+                jsq{{&st0, &st1, &st2, &st3}, 5},
+                power_of_two{{&st0, &st1, &st2, &st3}, 5},
+                src{env, pool, route(p), 3.2, 3} {
+                env.time_precision(1_us);
+                for (auto st: { &st0, &st1, &st2, &st3 })
+                    st->connect(out);
+                src.limit(100'000);
+            }
+
+            queueing::node &route(policy p) {
+                switch (p) {
+                case policy::jsq: return jsq;
+                case policy::power_of_two: return power_of_two;
+                default: return random;
+                }
+            }
+
+            queueing::job_pool pool;
+            queueing::sink out;
+            queueing::station st0, st1, st2, st3;
+            queueing::probabilistic_router random;
+            queueing::jsq_router jsq;
+            queueing::power_of_two_router power_of_two;
+            queueing::poisson_source src;
+
+            coroutine<> co_main() {
+                src.start();
+                co_return ;
+            }
+        };
+
+        test t{p};
+        t.run();
+        EXPECT_EQ(t.out.count(), 100'000u);
+        return t.out.mean();
+    };
+
+    auto random = simulate(policy::random);
+    auto jsq = simulate(policy::jsq);
+    auto power_of_two = simulate(policy::power_of_two);
+
+    // random routing makes four independent M/M/1 queues at load 0.8
+    EXPECT_NEAR(random, 5, 0.5);
+    EXPECT_LT(power_of_two, 0.6 * random);
+    EXPECT_LT(jsq, power_of_two);
+}
+
+TEST(QueueingTest, MmppSourceRate) {
+    CXXDES_SIMULATION(test) {
+        test():
+            out{env, pool},
+            src{env, pool, out, {0.2, 2.0}, {{0, 0.1}, {0.1, 0}}, 0, 9} {
+            env.time_precision(1_us);
+            src.limit(200'000);
+        }
+
+        queueing::job_pool pool;
+        queueing::sink out;
+        queueing::mmpp_source src;
+
+        coroutine<> co_main() {
+            src.start();
+            co_return ;
+        }
+    };
+
+    test t;
+    t.run();
+
+    // the chain spends half of the time in each state
+    EXPECT_EQ(t.out.count(), 200'000u);
+    EXPECT_NEAR(200'000.0 / t.env.now_seconds(), 1.1, 0.05);
+    EXPECT_EQ(t.out.mean(), 0);
+}
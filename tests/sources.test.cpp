@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+using namespace cxxdes::time_utils::ops;
+
+namespace sources = cxxdes::sources;
+
+namespace {
+
+// runs `src` and returns the times of its arrivals, in milliseconds
+std::vector<time_integral> arrival_times(std::function<std::unique_ptr<sources::source>(environment &)> make) {
+    CXXDES_SIMULATION(test) {
+        test(std::function<std::unique_ptr<sources::source>(environment &)> make) {
+            env.time_precision(1_ms);
+            src = make(env);
+            src->on_arrival([this] { times.push_back(now()); });
+        }
+
+        std::unique_ptr<sources::source> src;
+        std::vector<time_integral> times;
+
+        coroutine<> co_main() {
+            src->start();
+            co_return ;
+        }
+    };
+
+    test t{std::move(make)};
+    t.run();
+    return t.times;
+}
+
+} /* namespace */
+
+TEST(SourcesTest, Renewal) {
+    using v = std::vector<time_integral>;
+
+    auto times = arrival_times([](environment &env) {
+        auto src = std::make_unique<sources::renewal<std::function<double()>>>(env, [] { return 0.5; });
+        src->limit(4);
+        return src;
+    });
+    EXPECT_EQ(times, (v{500, 1000, 1500, 2000}));
+
+    // random number distributions draw from the source's own engine
+    times = arrival_times([](environment &env) {
+        auto src = std::make_unique<sources::renewal<std::uniform_real_distribution<double>>>(
+            env, std::uniform_real_distribution<double>{1, 3}, 5);
+        src->limit(10'000);
+        return src;
+    });
+    ASSERT_EQ(times.size(), 10'000u);
+    EXPECT_NEAR(static_cast<double>(times.back()) / 10'000.0, 2000, 40);
+}
+
+TEST(SourcesTest, Poisson) {
+    auto times = arrival_times([](environment &env) {
+        auto src = std::make_unique<sources::poisson>(env, 4.0, 7);
+        src->limit(100'000);
+        return src;
+    });
+
+    ASSERT_EQ(times.size(), 100'000u);
+    EXPECT_NEAR(100'000.0 / (static_cast<double>(times.back()) / 1000.0), 4.0, 0.1);
+
+    environment env;
+    EXPECT_THROW(sources::poisson(env, 0), std::runtime_error);
+}
+
+TEST(SourcesTest, Batch) {
+    using v = std::vector<time_integral>;
+
+    // groups of three every second; the limit cuts the last group short
+    auto times = arrival_times([](environment &env) {
+        auto src = std::make_unique<sources::batch<std::function<double()>, std::function<int()>>>(
+            env, [] { return 1.0; }, [] { return 3; });
+        src->limit(7);
+        return src;
+    });
+    EXPECT_EQ(times, (v{1000, 1000, 1000, 2000, 2000, 2000, 3000}));
+}
+
+TEST(SourcesTest, PeriodicWithJitter) {
+    auto times = arrival_times([](environment &env) {
+        auto src = std::make_unique<sources::periodic>(env, 1.0, 0.25, 3);
+        src->limit(1000);
+        return src;
+    });
+
+    ASSERT_EQ(times.size(), 1000u);
+    for (std::size_t k = 0; k < times.size(); ++k) {
+        auto nominal = static_cast<time_integral>(k + 1) * 1000;
+        EXPECT_GE(times[k], nominal);
+        EXPECT_LT(times[k], nominal + 250);
+    }
+
+    environment env;
+    EXPECT_THROW(sources::periodic(env, 1.0, 2.0), std::runtime_error);
+}
+
+TEST(SourcesTest, Stop) {
+    CXXDES_SIMULATION(test) {
+        test(): src{env, 1.0} {
+            env.time_precision(1_ms);
+            src.on_arrival([this] {
+                if (src.generated() == 5)
+                    src.stop();
+            });
+        }
+
+        sources::periodic src;
+
+        coroutine<> co_main() {
+            src.start();
+            co_return ;
+        }
+    };
+
+    test t;
+    t.run();
+    EXPECT_EQ(t.src.generated(), 5u);
+    EXPECT_EQ(t.now(), 6000);
+    EXPECT_THROW(t.src.start(), std::runtime_error);
+}
+
+TEST(SourcesTest, FeedQueue) {
+    CXXDES_SIMULATION(test) {
+        test(): q{2}, src{env, 1.0} {
+            env.time_precision(1_ms);
+            src.feed(q, [this] { return now(); });
+            src.limit(10);
+        }
+
+        cxxdes::sync::queue<time_integral> q;
+        sources::periodic src;
+        std::vector<time_integral> received;
+
+        coroutine<> co_main() {
+            src.start();
+
+            // slower than the arrivals, so the queue overflows
+            while (received.size() + src.dropped() < 10 || q.size() > 0) {
+                auto x = co_await q.pop();
+                received.push_back(x);
+                co_await env.timeout(2.3);
+            }
+        }
+    };
+
+    test t;
+    t.run();
+
+    EXPECT_EQ(t.src.generated(), 10u);
+    EXPECT_EQ(t.received.size() + t.src.dropped(), 10u);
+    EXPECT_GT(t.src.dropped(), 0u);
+
+    // items arrive in order, and the first one is taken as soon as it is put
+    EXPECT_EQ(t.received.front(), 1000);
+    EXPECT_TRUE(std::is_sorted(t.received.begin(), t.received.end()));
+}
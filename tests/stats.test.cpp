@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+namespace stats = cxxdes::stats;
+
+TEST(StatsTest, Tally) {
+    stats::tally all, a, b;
+
+    for (int i = 1; i <= 10; ++i) {
+        all.add(i);
+        (i <= 4 ? a : b).add(i);
+    }
+
+    EXPECT_EQ(all.count(), 10u);
+    EXPECT_DOUBLE_EQ(all.mean(), 5.5);
+    EXPECT_DOUBLE_EQ(all.sum(), 55);
+    EXPECT_NEAR(all.variance(), 55.0 / 6.0, 1e-12);
+    EXPECT_EQ(all.min(), 1);
+    EXPECT_EQ(all.max(), 10);
+
+    // merging gives the statistics of one tally that saw everything
+    a.merge(b);
+    EXPECT_EQ(a.count(), all.count());
+    EXPECT_NEAR(a.mean(), all.mean(), 1e-12);
+    EXPECT_NEAR(a.variance(), all.variance(), 1e-12);
+    EXPECT_EQ(a.min(), 1);
+    EXPECT_EQ(a.max(), 10);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.variance(), 0);
+}
+
+TEST(StatsTest, TimeWeighted) {
+    CXXDES_SIMULATION(test) {
+        test(): length{env} {
+        }
+
+        stats::time_weighted length;
+
+        coroutine<> co_main() {
+            // 0 for 10 ticks, 2 for 20 ticks, 1 for 10 ticks
+            co_await delay(10);
+            length.add(2);
+            co_await delay(20);
+            length.set(1);
+            co_await delay(10);
+        }
+    };
+
+    test t;
+    t.run();
+
+    EXPECT_EQ(t.length.duration(), 40);
+    EXPECT_DOUBLE_EQ(t.length.mean(), 50.0 / 40.0);
+    EXPECT_DOUBLE_EQ(t.length.variance(), 90.0 / 40.0 - (50.0 / 40.0) * (50.0 / 40.0));
+    EXPECT_EQ(t.length.min(), 0);
+    EXPECT_EQ(t.length.max(), 2);
+    EXPECT_EQ(t.length.value(), 1);
+
+    // a second replication, merged as if run after the first
+    test u;
+    u.run();
+    t.length.merge(u.length);
+    EXPECT_EQ(t.length.duration(), 80);
+    EXPECT_DOUBLE_EQ(t.length.mean(), 50.0 / 40.0);
+
+    t.length.reset();
+    EXPECT_EQ(t.length.duration(), 0);
+    EXPECT_EQ(t.length.mean(), 1);
+}
+
+TEST(StatsTest, Histogram) {
+    stats::histogram h{0, 10, 5};
+
+    for (double x: { -1.0, 0.0, 1.9, 2.0, 5.5, 9.99, 10.0, 42.0 })
+        h.add(x);
+
+    EXPECT_EQ(h.bins(), 5u);
+    EXPECT_EQ(h.total(), 8u);
+    EXPECT_EQ(h.underflow(), 1u);
+    EXPECT_EQ(h.overflow(), 2u);
+    EXPECT_EQ(h.count(0), 2u);
+    EXPECT_EQ(h.count(1), 1u);
+    EXPECT_EQ(h.count(2), 1u);
+    EXPECT_EQ(h.count(4), 1u);
+    EXPECT_DOUBLE_EQ(h.lower(1), 2);
+    EXPECT_DOUBLE_EQ(h.upper(1), 4);
+
+    stats::histogram uniform{0, 1, 100};
+    for (int i = 0; i < 1000; ++i)
+        uniform.add((i + 0.5) / 1000.0);
+    EXPECT_NEAR(uniform.quantile(0.5), 0.5, 0.01);
+    EXPECT_NEAR(uniform.quantile(0.9), 0.9, 0.01);
+
+    auto copy = uniform;
+    copy.merge(uniform);
+    EXPECT_EQ(copy.total(), 2000u);
+    EXPECT_EQ(copy.count(10), 20u);
+
+    EXPECT_THROW(copy.merge(h), std::runtime_error);
+    EXPECT_THROW((stats::histogram{1, 1, 4}), std::runtime_error);
+}
+
+TEST(StatsTest, LogHistogram) {
+    stats::log_histogram h{1, 1e6, 6};
+
+    for (double x: { 0.5, 1.0, 5.0, 50.0, 500.0, 999'999.0, 1e6 })
+        h.add(x);
+
+    EXPECT_EQ(h.underflow(), 1u);
+    EXPECT_EQ(h.overflow(), 1u);
+    EXPECT_EQ(h.count(0), 2u);
+    EXPECT_EQ(h.count(1), 1u);
+    EXPECT_EQ(h.count(2), 1u);
+    EXPECT_EQ(h.count(5), 1u);
+    EXPECT_NEAR(h.lower(3), 1000, 1e-6);
+
+    EXPECT_THROW((stats::log_histogram{0, 10, 4}), std::runtime_error);
+}
+
+TEST(StatsTest, TDigest) {
+    std::mt19937_64 rng{1};
+    std::exponential_distribution<double> dist{1.0};
+
+    stats::tdigest all, a, b;
+    std::vector<double> xs;
+
+    for (int i = 0; i < 100'000; ++i) {
+        auto x = dist(rng);
+        xs.push_back(x);
+        all.add(x);
+        (i % 3 == 0 ? a : b).add(x);
+    }
+
+    std::sort(xs.begin(), xs.end());
+
+    // fraction of the observations below x
+    auto rank = [&](double x) {
+        return static_cast<double>(std::lower_bound(xs.begin(), xs.end(), x) - xs.begin()) / static_cast<double>(xs.size());
+    };
+
+    EXPECT_EQ(all.count(), 100'000);
+    EXPECT_LE(all.centroids(), 110u);
+
+    // the fraction of observations below the estimate is close to q
+    a.merge(b);
+    for (auto q: { 0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 }) {
+        auto tolerance = 0.01 * std::min(q, 1 - q) + 1e-3;
+        EXPECT_NEAR(rank(all.quantile(q)), q, tolerance) << q;
+        EXPECT_NEAR(rank(a.quantile(q)), q, tolerance) << q;
+    }
+
+    EXPECT_EQ(all.quantile(0), xs.front());
+    EXPECT_EQ(all.quantile(1), xs.back());
+
+    all.reset();
+    EXPECT_EQ(all.count(), 0);
+    EXPECT_EQ(all.quantile(0.5), 0);
+}
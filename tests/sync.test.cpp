@@ -0,0 +1,1605 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+
+#include <cxxdes/cxxdes.hpp>
+
+using namespace cxxdes::core;
+
+TEST(BarrierTest, ReleasesAllWaitersAtLastArrival) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::barrier<> b{3};
+        std::vector<time_integral> released;
+
+        coroutine<> p(time_integral t) {
+            co_await delay(t);
+            co_await b.arrive_and_wait();
+            released.push_back(now());
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(p(1), p(5), p(3));
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.released, (std::vector<time_integral>{ 5, 5, 5 }));
+    EXPECT_EQ(sim.b.phase(), 1u);
+}
+
+TEST(BarrierTest, CyclicWithCompletion) {
+    struct counter {
+        std::size_t *n;
+        void operator()() const { ++*n; }
+    };
+
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        std::size_t completions = 0;
+        cxxdes::sync::barrier<counter> b{2, counter{&completions}};
+
+        coroutine<> p(time_integral t) {
+            for (int i = 0; i < 4; ++i) {
+                co_await delay(t);
+                co_await b.arrive_and_wait();
+                EXPECT_EQ(now(), (i + 1) * 10);
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(p(1), p(10));
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.completions, 4u);
+    EXPECT_EQ(sim.b.phase(), 4u);
+    EXPECT_EQ(sim.b.waiting(), 0u);
+}
+
+TEST(BarrierTest, ArriveAndDrop) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::barrier<> b{2};
+
+        coroutine<> leaver() {
+            co_await b.arrive_and_drop();
+            EXPECT_EQ(now(), 0);
+        }
+
+        coroutine<> stayer() {
+            co_await delay(2);
+            co_await b.arrive_and_wait();
+            EXPECT_EQ(now(), 2);
+
+            // the leaver no longer participates
+            co_await b.arrive_and_wait();
+            EXPECT_EQ(now(), 2);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(leaver(), stayer());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.b.expected(), 1u);
+}
+
+TEST(BarrierTest, PhaseReleasesWaitersWithOneEvent) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::barrier<> b{4};
+        cxxdes::sync::latch l{1};
+        std::vector<time_integral> released;
+
+        static bool is_batch(token *tkn) {
+            return tkn && tkn->handler && !tkn->coro_data;
+        }
+
+        coroutine<> p(time_integral latency) {
+            co_await b.arrive_and_wait(latency);
+            released.push_back(now());
+        }
+
+        coroutine<> q() {
+            co_await l.wait();
+            released.push_back(now());
+        }
+
+        coroutine<> co_main() {
+            for (int phase = 0; phase < 2; ++phase) {
+                for (int i = 0; i < 3; ++i)
+                    co_await async(p(0));
+
+                co_await delay(1);
+                EXPECT_EQ(env.next_event(), nullptr);
+
+                // the last arrival schedules the three waiters as one event
+                co_await b.arrive_and_wait();
+                EXPECT_TRUE(is_batch(env.next_event()));
+
+                co_await delay(1);
+                EXPECT_EQ(released.size(), 3u * (phase + 1));
+            }
+
+            // waiters with a latency are released by an event of their own
+            co_await async(p(0));
+            co_await async(p(5));
+            co_await async(p(5));
+            co_await delay(1);
+            co_await b.arrive_and_wait();
+            co_await delay(10);
+            EXPECT_EQ(released, (std::vector<time_integral>{ 1, 1, 1, 3, 3, 3, 5, 10, 10 }));
+
+            released.clear();
+            co_await async(q());
+            co_await async(q());
+            co_await delay(1);
+            co_await l.count_down();
+            EXPECT_TRUE(is_batch(env.next_event()));
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.released, (std::vector<time_integral>{ 16, 16 }));
+}
+
+TEST(LatchTest, CountDownReleasesWaiters) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::latch l{3};
+        std::size_t n_released = 0;
+
+        coroutine<> waiter() {
+            co_await l.wait();
+            EXPECT_EQ(now(), 7);
+            ++n_released;
+        }
+
+        coroutine<> counter() {
+            co_await delay(2);
+            co_await l.count_down();
+            EXPECT_EQ(n_released, 0u);
+            co_await delay(5);
+            co_await l.count_down(2);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(waiter(), waiter(), counter());
+
+            // already released
+            co_await l.wait();
+            EXPECT_EQ(now(), 7);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.n_released, 2u);
+    EXPECT_TRUE(sim.l.try_wait());
+}
+
+TEST(SharedMutexTest, ReadersShareWritersExclude) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::shared_mutex m;
+        std::size_t max_readers = 0;
+
+        coroutine<> reader(time_integral start) {
+            co_await delay(start);
+            _Co_with(m.shared()) {
+                max_readers = std::max(max_readers, m.readers());
+                EXPECT_FALSE(m.is_acquired_exclusive());
+                co_await delay(10);
+            };
+        }
+
+        coroutine<> writer(time_integral start, time_integral expected) {
+            co_await delay(start);
+            _Co_with(m.exclusive()) {
+                EXPECT_EQ(now(), expected);
+                EXPECT_EQ(m.readers(), 0u);
+                co_await delay(10);
+            };
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(reader(0), reader(1), writer(2, 11), reader(3));
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    // the reader arriving after the writer waits for it (writer preference)
+    EXPECT_EQ(sim.max_readers, 2u);
+    EXPECT_EQ(sim.now(), 31);
+}
+
+TEST(SharedMutexTest, WriterReleaseAdmitsReadersInOneBatch) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::shared_mutex m{cxxdes::sync::shared_mutex_policy::phase_fair};
+        std::vector<time_integral> reader_times;
+        std::vector<time_integral> writer_times;
+
+        coroutine<> reader() {
+            auto h = co_await m.acquire_shared();
+            reader_times.push_back(now());
+            co_await delay(5);
+            co_await h.release();
+        }
+
+        coroutine<> writer() {
+            auto h = co_await m.acquire_exclusive();
+            EXPECT_TRUE(h.exclusive());
+            writer_times.push_back(now());
+            co_await delay(10);
+            co_await h.release();
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(writer(), writer(), reader(), reader(), reader());
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    // writer, then all readers at once, then the second writer
+    EXPECT_EQ(sim.writer_times, (std::vector<time_integral>{ 0, 15 }));
+    EXPECT_EQ(sim.reader_times, (std::vector<time_integral>{ 10, 10, 10 }));
+}
+
+TEST(SharedMutexTest, WaiterThatGaveUpIsNotAdmitted) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::shared_mutex m;
+        std::vector<time_integral> acquired;
+
+        coroutine<> writer(time_integral start, time_integral hold) {
+            co_await delay(start);
+            auto h = co_await m.acquire_exclusive();
+            acquired.push_back(now());
+            co_await delay(hold);
+            co_await h.release();
+        }
+
+        coroutine<> impatient_reader() {
+            co_await delay(1);
+            co_await any_of(m.acquire_shared(), timeout(2));
+            EXPECT_EQ(now(), 3);
+            EXPECT_EQ(m.waiting_readers(), 0u);
+
+            auto r = co_await m.acquire_shared_for(2);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(m.waiting_readers(), 0u);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(writer(0, 10), impatient_reader(), writer(20, 5));
+            EXPECT_FALSE(m.is_acquired());
+            EXPECT_EQ(m.readers(), 0u);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.acquired, (std::vector<time_integral>{ 0, 20 }));
+}
+
+TEST(SharedMutexTest, WriterThatGaveUpAdmitsQueuedReaders) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::shared_mutex m;
+        std::vector<time_integral> reader_times;
+
+        coroutine<> reader(time_integral start) {
+            co_await delay(start);
+            auto h = co_await m.acquire_shared();
+            reader_times.push_back(now());
+            co_await delay(20);
+            co_await h.release();
+        }
+
+        coroutine<> writer() {
+            co_await delay(1);
+            auto r = co_await m.acquire_exclusive_until(5);
+            EXPECT_EQ(now(), 5);
+            EXPECT_FALSE(r);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(reader(0), writer(), reader(2), reader(3));
+            EXPECT_EQ(m.readers(), 0u);
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    // the later readers queue behind the writer until it gives up
+    EXPECT_EQ(sim.reader_times, (std::vector<time_integral>{ 0, 5, 5 }));
+}
+
+TEST(QueueTest, BoundedHandoff) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q{1};
+        std::vector<int> popped;
+
+        coroutine<> producer() {
+            for (int i = 0; i < 4; ++i)
+                co_await q.put(i);
+            EXPECT_EQ(now(), 30);
+        }
+
+        coroutine<> consumer() {
+            for (int i = 0; i < 4; ++i) {
+                co_await delay(10);
+                popped.push_back(co_await q.pop());
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(producer(), consumer());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.popped, (std::vector<int>{ 0, 1, 2, 3 }));
+    EXPECT_EQ(sim.q.size(), 0u);
+}
+
+TEST(SelectTest, ClaimsExactlyOneItem) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q1;
+        cxxdes::sync::queue<std::string> q2;
+
+        coroutine<> producer() {
+            co_await delay(5);
+            co_await q2.put("hello");
+            co_await q1.put(42);
+        }
+
+        coroutine<> dispatcher() {
+            auto r = co_await cxxdes::sync::select(q1.pop_op(), q2.pop_op());
+            EXPECT_EQ(now(), 5);
+            EXPECT_EQ(r.index, 1u);
+            EXPECT_EQ(r.get<1>(), "hello");
+
+            // the first queue was never popped
+            EXPECT_EQ(q1.size(), 1u);
+            EXPECT_EQ(q1.waiting_consumers(), 0u);
+
+            // ready operations win immediately, leftmost first
+            auto s = co_await cxxdes::sync::select(q2.pop_op(), q1.pop_op());
+            EXPECT_EQ(now(), 5);
+            EXPECT_EQ(s.index, 1u);
+            EXPECT_EQ(s.get<1>(), 42);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(dispatcher(), producer());
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(SelectTest, Timeout) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q1;
+        cxxdes::sync::queue<int> q2;
+
+        coroutine<> co_main() {
+            auto r = co_await cxxdes::sync::select(q1.pop_op(), q2.pop_op(), delay(10));
+            EXPECT_EQ(now(), 10);
+            EXPECT_EQ(r.index, 2u);
+
+            // both registrations were withdrawn
+            EXPECT_EQ(q1.waiting_consumers(), 0u);
+            EXPECT_EQ(q2.waiting_consumers(), 0u);
+
+            // a later put is not lost
+            co_await q1.put(7);
+            EXPECT_EQ(q1.size(), 1u);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(SelectTest, AbandonedSelectIsWithdrawn) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q;
+
+        coroutine<> co_main() {
+            co_await any_of(cxxdes::sync::select(q.pop_op(), delay(20)), delay(5));
+            EXPECT_EQ(now(), 5);
+            EXPECT_EQ(q.waiting_consumers(), 0u);
+
+            co_await q.put(1);
+            EXPECT_EQ(q.size(), 1u);
+            co_await delay(30);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(TimedWaitTest, QueuePopFor) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q;
+
+        coroutine<> producer() {
+            co_await delay(15);
+            co_await q.put(3);
+        }
+
+        coroutine<> consumer() {
+            auto r = co_await q.pop_for(10);
+            EXPECT_EQ(now(), 10);
+            EXPECT_TRUE(r.timed_out());
+            EXPECT_EQ(r.error(), cxxdes::sync::wait_errc::timeout);
+            EXPECT_THROW(r.value(), std::runtime_error);
+
+            // the expired waiter was removed from the queue
+            EXPECT_EQ(q.waiting_consumers(), 0u);
+
+            auto s = co_await q.pop_until(100);
+            EXPECT_EQ(now(), 15);
+            EXPECT_TRUE(s);
+            EXPECT_EQ(*s, 3);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(consumer(), producer());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.q.size(), 0u);
+}
+
+TEST(TimedWaitTest, QueuePutFor) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q{1};
+
+        coroutine<> co_main() {
+            co_await q.put(1);
+
+            auto r = co_await q.put_for(5, 2);
+            EXPECT_EQ(now(), 5);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(q.waiting_producers(), 0u);
+            EXPECT_EQ(q.size(), 1u);
+            EXPECT_EQ(co_await q.pop(), 1);
+
+            auto s = co_await q.put_for(5, 3);
+            EXPECT_EQ(now(), 5);
+            EXPECT_TRUE(s);
+            EXPECT_EQ(co_await q.pop(), 3);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(TimedWaitTest, CompletedWaitsCancelTheirTimers) {
+    constexpr int n = 10000;
+
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q;
+        std::size_t peak = 0;
+        int received = 0;
+
+        coroutine<> producer() {
+            for (int i = 0; i < n; ++i) {
+                co_await delay(1);
+                co_await q.put(i);
+            }
+        }
+
+        coroutine<> consumer() {
+            for (int i = 0; i < n; ++i) {
+                auto r = co_await q.pop_for(100 * n);
+                received += r.has_value();
+                peak = std::max(peak, env.scheduled_events());
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(consumer(), producer());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.received, n);
+
+    // the timers of the waits that won are gone rather than left to expire
+    EXPECT_EQ(sim.now(), n);
+    EXPECT_EQ(sim.env.scheduled_events(), 0u);
+    EXPECT_LT(sim.peak, 8u);
+}
+
+TEST(TimedWaitTest, EventWaitFor) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::event evt;
+        int woken = 0;
+
+        coroutine<> waiter(time_integral d) {
+            auto r = co_await evt.wait_for(d);
+            if (r)
+                ++woken;
+        }
+
+        coroutine<> co_main() {
+            co_await async(waiter(5));
+            co_await async(waiter(5));
+            co_await async(waiter(50));
+
+            co_await delay(10);
+            EXPECT_EQ(evt.waiting(), 1u);
+
+            co_await evt.wake();
+            EXPECT_EQ(evt.waiting(), 0u);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.woken, 1);
+}
+
+TEST(TimedWaitTest, MutexAcquireFor) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::mutex mtx;
+        std::vector<int> order;
+
+        coroutine<> holder() {
+            auto h = co_await mtx.acquire();
+            co_await delay(20);
+            co_await h.release();
+        }
+
+        coroutine<> impatient() {
+            auto r = co_await mtx.acquire_for(10);
+            EXPECT_EQ(now(), 10);
+            EXPECT_FALSE(r);
+            order.push_back(1);
+        }
+
+        coroutine<> patient() {
+            auto r = co_await mtx.acquire_for(30);
+            EXPECT_EQ(now(), 20);
+            EXPECT_TRUE(r);
+            order.push_back(2);
+            co_await r->release();
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(holder(), impatient(), patient());
+            EXPECT_EQ(mtx.waiting(), 0u);
+            EXPECT_FALSE(mtx.is_acquired());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.order, (std::vector<int>{ 1, 2 }));
+}
+
+TEST(TimedWaitTest, BarrierAndLatch) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::barrier<> b{3};
+        cxxdes::sync::latch l{2};
+        std::vector<time_integral> released;
+
+        coroutine<> participant(time_integral start) {
+            co_await delay(start);
+            co_await b.arrive_and_wait();
+            released.push_back(now());
+        }
+
+        coroutine<> impatient() {
+            auto r = co_await b.arrive_and_wait_for(5);
+            EXPECT_EQ(now(), 5);
+            EXPECT_TRUE(r.timed_out());
+
+            // the arrival was withdrawn along with the waiter
+            EXPECT_EQ(b.remaining(), 2u);
+            EXPECT_EQ(b.waiting(), 1u);
+        }
+
+        coroutine<> co_main() {
+            co_await async(participant(1));
+            co_await impatient();
+            EXPECT_EQ(b.phase(), 0u);
+
+            co_await all_of(participant(5), participant(10));
+            EXPECT_EQ(b.phase(), 1u);
+
+            auto r = co_await l.wait_until(20);
+            EXPECT_EQ(now(), 20);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(l.count(), 2u);
+
+            co_await l.count_down();
+            co_await async(l.count_down());
+            EXPECT_TRUE(co_await l.wait_for(5));
+            EXPECT_EQ(now(), 20);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.released, (std::vector<time_integral>{ 15, 15, 15 }));
+}
+
+TEST(TimedWaitTest, SemaphoreAndResource) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::semaphore<> sem{0, 1};
+        cxxdes::sync::resource res{1};
+
+        coroutine<> co_main() {
+            auto r = co_await sem.down_for(5);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(sem.waiting_down(), 0u);
+
+            EXPECT_TRUE(co_await sem.up_for(5));
+            EXPECT_FALSE(co_await sem.up_until(20));
+            EXPECT_EQ(now(), 20);
+            EXPECT_EQ(sem.value(), 1u);
+
+            auto h = co_await res.acquire();
+            auto s = co_await res.acquire_for(5);
+            EXPECT_FALSE(s);
+            EXPECT_EQ(res.waiting(), 0u);
+            co_await h.release();
+
+            auto t = co_await res.acquire_for(5);
+            EXPECT_TRUE(t);
+            EXPECT_EQ(res.available(), 0u);
+            co_await t->release();
+            EXPECT_EQ(res.available(), 1u);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(QueueTest, BatchPutAndPop) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q{8};
+        std::vector<int> received;
+        std::vector<time_integral> times;
+
+        coroutine<> producer() {
+            std::vector<int> burst(6);
+            for (int b = 0; b < 3; ++b) {
+                for (int i = 0; i < 6; ++i)
+                    burst[i] = b * 6 + i;
+
+                // blocks until the whole burst fits
+                co_await q.put_range(burst.begin(), burst.end());
+                times.push_back(now());
+            }
+        }
+
+        coroutine<> consumer() {
+            for (int b = 0; b < 6; ++b) {
+                co_await delay(10);
+                co_await q.pop_n(std::back_inserter(received), 3);
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(producer(), consumer());
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    std::vector<int> expected(18);
+    for (int i = 0; i < 18; ++i)
+        expected[i] = i;
+
+    EXPECT_EQ(sim.received, expected);
+    EXPECT_EQ(sim.times, (std::vector<time_integral>{ 0, 20, 40 }));
+    EXPECT_EQ(sim.q.underlying_buffer().capacity(), 8u);
+}
+
+TEST(QueueTest, BatchPopWaitsForWholeBatch) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int> q;
+        std::vector<int> batch;
+
+        coroutine<> producer() {
+            for (int i = 0; i < 7; ++i) {
+                co_await delay(2);
+                co_await q.put(i);
+            }
+        }
+
+        coroutine<> batch_consumer() {
+            co_await q.pop_n(std::back_inserter(batch), 2);
+            EXPECT_EQ(now(), 12);
+        }
+
+        coroutine<> co_main() {
+            co_await async(producer());
+
+            int out[4] = {};
+            auto end = co_await q.pop_n(out, 4);
+            EXPECT_EQ(now(), 8);
+            EXPECT_EQ(end, out + 4);
+            EXPECT_EQ(out[3], 3);
+
+            // a single pop does not overtake a blocked batch
+            co_await async(batch_consumer());
+            co_await delay(1);
+            EXPECT_EQ(co_await q.pop(), 6);
+            EXPECT_EQ(now(), 14);
+
+            cxxdes::sync::queue<int> small{2};
+            EXPECT_THROW((void) small.pop_n(out, 4), std::runtime_error);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.batch, (std::vector<int>{ 4, 5 }));
+}
+
+TEST(RingBufferTest, PushOfOwnElementWhileGrowing) {
+    cxxdes::util::ring_buffer<std::string> buf;
+
+    // long strings live on the heap, so a copy of a moved-from element shows
+    for (int i = 0; i < 8; ++i)
+        buf.push_back(std::string(32, static_cast<char>('a' + i)));
+
+    // wrap around, then grow while appending copies of the front and back
+    buf.pop_front();
+    buf.push_back(std::string(32, 'i'));
+    ASSERT_EQ(buf.size(), buf.capacity());
+
+    buf.push_back(buf.front());
+    EXPECT_EQ(buf.capacity(), 16u);
+    EXPECT_EQ(buf.back(), std::string(32, 'b'));
+
+    for (std::size_t n = buf.size(); n <= 16; ++n)
+        buf.emplace_back(buf.back());
+
+    ASSERT_EQ(buf.size(), 17u);
+    EXPECT_EQ(buf.front(), std::string(32, 'b'));
+    EXPECT_EQ(buf[7], std::string(32, 'i'));
+    EXPECT_EQ(buf.back(), std::string(32, 'b'));
+}
+
+TEST(RingBufferTest, ThrowingGrowthLeavesBufferUnchanged) {
+    struct item {
+        int value;
+        bool fail = false;
+
+        item(int v, bool f = false): value{v}, fail{f} {
+            if (fail)
+                throw std::runtime_error("item");
+        }
+
+        item(item const &other): value{other.value} {
+            if (other.fail)
+                throw std::runtime_error("copy");
+        }
+    };
+
+    cxxdes::util::ring_buffer<item> buf{2};
+    buf.emplace_back(1);
+    buf.emplace_back(2);
+
+    EXPECT_THROW(buf.emplace_back(3, true), std::runtime_error);
+    ASSERT_EQ(buf.size(), 2u);
+    EXPECT_EQ(buf.capacity(), 2u);
+    EXPECT_EQ(buf.front().value, 1);
+    EXPECT_EQ(buf.back().value, 2);
+
+    buf.emplace_back(3);
+    EXPECT_EQ(buf.size(), 3u);
+    EXPECT_EQ(buf[2].value, 3);
+}
+
+TEST(PriorityStoreTest, ReturnsItemsInPriorityOrder) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::priority_store<int> store{3};
+        std::vector<int> got;
+
+        coroutine<> producer() {
+            for (int x: { 5, 1, 4, 2, 3 })
+                co_await store.put(x);
+            EXPECT_EQ(now(), 11);
+        }
+
+        coroutine<> consumer() {
+            co_await delay(10);
+            for (int i = 0; i < 5; ++i) {
+                got.push_back(co_await store.get());
+                co_await delay(1);
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(producer(), consumer());
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    // 5, 1, 4 are stored; each get admits the next blocked put
+    EXPECT_EQ(sim.got, (std::vector<int>{ 1, 2, 3, 4, 5 }));
+    EXPECT_TRUE(sim.store.empty());
+}
+
+TEST(PriorityStoreTest, CustomCompareIsStable) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        using item = std::pair<int, char>;
+
+        struct by_priority {
+            bool operator()(item const &a, item const &b) const {
+                return a.first > b.first;
+            }
+        };
+
+        cxxdes::sync::priority_store<item, by_priority> store;
+        std::string got;
+
+        coroutine<> co_main() {
+            co_await store.put({ 1, 'a' });
+            co_await store.put({ 2, 'b' });
+            co_await store.put({ 1, 'c' });
+            co_await store.put({ 2, 'd' });
+
+            for (int i = 0; i < 4; ++i)
+                got.push_back((co_await store.get()).second);
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.got, "bdac");
+}
+
+TEST(FilterStoreTest, OnlyMatchingWaiterWakes) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        struct packet {
+            int dst;
+            int seq;
+        };
+
+        struct by_dst {
+            int operator()(packet const &p) const {
+                return p.dst;
+            }
+        };
+
+        cxxdes::sync::filter_store<packet, by_dst> store;
+        std::vector<std::pair<int, time_integral>> got;
+
+        coroutine<> port(int dst) {
+            auto p = co_await store.get(dst);
+            EXPECT_EQ(p.dst, dst);
+            got.emplace_back(dst, now());
+        }
+
+        coroutine<> monitor() {
+            auto p = co_await store.get_if([](packet const &p) { return p.seq >= 10; });
+            EXPECT_EQ(p.seq, 10);
+            got.emplace_back(-1, now());
+        }
+
+        coroutine<> co_main() {
+            co_await async(port(1));
+            co_await async(port(2));
+            co_await async(monitor());
+            co_await delay(1);
+            EXPECT_EQ(store.waiting_getters(), 3u);
+
+            co_await delay(4);
+            co_await store.put({ 2, 0 });
+            EXPECT_EQ(store.waiting_getters(), 2u);
+
+            co_await delay(5);
+            co_await store.put({ 3, 1 });
+            co_await store.put({ 3, 10 });
+            EXPECT_EQ(store.count(3), 1u);
+
+            co_await delay(5);
+            co_await store.put({ 1, 2 });
+            EXPECT_EQ(store.waiting_getters(), 0u);
+
+            // stored items are claimed by key or by predicate
+            EXPECT_EQ((co_await store.get(3)).seq, 1);
+            co_await store.put({ 4, 3 });
+            co_await store.put({ 4, 4 });
+            EXPECT_EQ((co_await store.get_if([](packet const &p) { return p.seq == 4; })).seq, 4);
+            EXPECT_EQ((co_await store.get()).seq, 3);
+            EXPECT_TRUE(store.empty());
+        }
+    };
+
+    test sim;
+    sim.run();
+    EXPECT_EQ(sim.got, (std::vector<std::pair<int, time_integral>>{ { 2, 5 }, { -1, 10 }, { 1, 15 } }));
+}
+
+TEST(FilterStoreTest, TimedGetIsWithdrawn) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::filter_store<int> store;
+
+        coroutine<> co_main() {
+            auto r = co_await cxxdes::sync::timed(store.get(7), delay(5));
+            EXPECT_FALSE(r);
+            EXPECT_EQ(store.waiting_getters(), 0u);
+
+            // the item is stored, not given to the expired waiter
+            co_await store.put(7);
+            EXPECT_EQ(store.count(7), 1u);
+        }
+    };
+
+    test{}.run();
+}
+
+namespace {
+
+// key that counts its live copies
+struct counted_key {
+    static inline int live = 0;
+
+    int v;
+
+    counted_key(int v_): v{v_} { ++live; }
+    counted_key(counted_key const &other): v{other.v} { ++live; }
+    ~counted_key() { --live; }
+
+    bool operator==(counted_key const &other) const {
+        return v == other.v;
+    }
+
+    struct hash {
+        std::size_t operator()(counted_key const &k) const {
+            return std::hash<int>{}(k.v);
+        }
+    };
+
+    struct of {
+        counted_key operator()(int x) const {
+            return counted_key{x};
+        }
+    };
+};
+
+} /* namespace */
+
+TEST(FilterStoreTest, WithdrawnKeysAreForgotten) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::filter_store<int, counted_key::of, counted_key::hash> store;
+
+        coroutine<> getter(int key) {
+            co_await store.get(key);
+        }
+
+        coroutine<> co_main() {
+            // every timed out get waits for a key of its own
+            for (int i = 0; i < 100; ++i) {
+                auto r = co_await cxxdes::sync::timed(store.get(i), delay(1));
+                EXPECT_FALSE(r);
+            }
+            EXPECT_EQ(counted_key::live, 0);
+
+            // a key stays while one of its waiters does
+            auto a = co_await async(getter(7));
+            co_await cxxdes::sync::timed(store.get(7), delay(1));
+            EXPECT_EQ(store.waiting_getters(), 1u);
+
+            co_await store.put(7);
+            EXPECT_EQ(store.count(7), 0u);
+            co_await a;
+            EXPECT_EQ(counted_key::live, 0);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(ContainerTest, FifoHoldsBackSmallerRequests) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::container<int> c{100};
+        std::vector<std::pair<int, cxxdes::core::time_integral>> served;
+
+        coroutine<> consumer(int amount, cxxdes::core::time_integral start) {
+            co_await delay(start);
+            co_await c.get(amount);
+            served.emplace_back(amount, now());
+        }
+
+        coroutine<> producer() {
+            co_await delay(2);
+            co_await c.put(30);
+            co_await delay(1);
+            co_await c.put(30);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(consumer(50, 0), consumer(10, 1), producer());
+            EXPECT_EQ(c.level(), 0);
+        }
+    };
+
+    test t;
+    t.run();
+    std::vector<std::pair<int, cxxdes::core::time_integral>> expected{{50, 3}, {10, 3}};
+    EXPECT_EQ(t.served, expected);
+}
+
+TEST(ContainerTest, FirstFitServesOldestFittingRequest) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::container<int> c{100, 0, cxxdes::sync::container_policy::first_fit};
+        std::vector<int> served;
+
+        coroutine<> consumer(int amount) {
+            co_await c.get(amount);
+            served.push_back(amount);
+        }
+
+        coroutine<> co_main() {
+            // more waiters than the initial index size
+            for (int amount = 20; amount > 0; --amount)
+                co_await async(consumer(amount));
+
+            co_await delay(1);
+            EXPECT_EQ(c.waiting_getters(), 20u);
+
+            // one unit at a time, so every completion is at a distinct time
+            for (int i = 0; i < 20 * 21 / 2; ++i) {
+                co_await c.put(1);
+                co_await delay(1);
+            }
+
+            EXPECT_EQ(c.level(), 0);
+            EXPECT_EQ(c.waiting_getters(), 0u);
+        }
+    };
+
+    test t;
+    t.run();
+    ASSERT_EQ(t.served.size(), 20u);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(t.served[i], i + 1);
+}
+
+TEST(ContainerTest, PutWaitsForRoomAndTimedGetGivesUp) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::container<double> tank{10.0, 8.0};
+        cxxdes::core::time_integral put_done = 0;
+
+        coroutine<> filler() {
+            co_await tank.put(5.0);
+            put_done = now();
+        }
+
+        coroutine<> drainer() {
+            co_await delay(2);
+            co_await tank.get(4.0);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(filler(), drainer());
+            EXPECT_DOUBLE_EQ(tank.level(), 9.0);
+
+            auto r = co_await tank.get_for(3, 9.5);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(tank.waiting_getters(), 0u);
+            EXPECT_DOUBLE_EQ(tank.level(), 9.0);
+        }
+    };
+
+    test t;
+    t.run();
+    EXPECT_EQ(t.put_done, 2);
+    EXPECT_THROW((void) t.tank.get(11.0), std::runtime_error);
+}
+
+TEST(BroadcastTest, SubscribersShareOneMessage) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::broadcast<std::string> topic{4};
+        std::vector<std::string const *> seen;
+        std::vector<int> order;
+
+        coroutine<> reader(int id) {
+            co_await delay(id);
+            auto sub = topic.subscribe();
+            auto m = co_await sub.recv();
+            EXPECT_EQ(*m, "hello");
+            EXPECT_EQ(now(), 5);
+            seen.push_back(&*m);
+            order.push_back(id);
+        }
+
+        coroutine<> co_main() {
+            for (int id = 0; id < 3; ++id)
+                co_await async(reader(id));
+
+            co_await delay(5);
+            EXPECT_EQ(topic.subscribers(), 3u);
+            EXPECT_EQ(topic.waiting_subscribers(), 3u);
+
+            co_await topic.publish("hello");
+            EXPECT_EQ(topic.waiting_subscribers(), 0u);
+
+            // every subscriber has read it, so the ring slot is free
+            EXPECT_EQ(topic.size(), 0u);
+            co_await delay(1);
+            EXPECT_EQ(topic.subscribers(), 0u);
+        }
+    };
+
+    test t;
+    t.run();
+    ASSERT_EQ(t.seen.size(), 3u);
+    EXPECT_EQ(t.seen[0], t.seen[1]);
+    EXPECT_EQ(t.seen[1], t.seen[2]);
+    EXPECT_EQ(t.order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(BroadcastTest, BlockWaitsForSlowestSubscriber) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::broadcast<int> topic{2, cxxdes::sync::broadcast_policy::block};
+        std::vector<cxxdes::core::time_integral> published;
+        std::vector<int> fast_got, slow_got;
+
+        coroutine<> reader(std::vector<int> &got, int period) {
+            auto sub = topic.subscribe();
+            for (int i = 0; i < 4; ++i) {
+                got.push_back(*co_await sub.recv());
+                co_await delay(period);
+            }
+        }
+
+        coroutine<> publisher() {
+            co_await delay(1);
+            for (int i = 0; i < 4; ++i) {
+                co_await topic.publish(i);
+                published.push_back(now());
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(reader(fast_got, 0), reader(slow_got, 10), publisher());
+        }
+    };
+
+    test t;
+    t.run();
+    EXPECT_EQ(t.fast_got, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(t.slow_got, (std::vector<int>{0, 1, 2, 3}));
+    // two slots: the fourth message waits until the slow reader takes the second
+    EXPECT_EQ(t.published, (std::vector<cxxdes::core::time_integral>{1, 1, 1, 11}));
+}
+
+TEST(BroadcastTest, DropAndLagLimit) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::broadcast<int> lossy{2, cxxdes::sync::broadcast_policy::drop};
+        cxxdes::sync::broadcast<int> limited{2, cxxdes::sync::broadcast_policy::lag_limit};
+
+        coroutine<> co_main() {
+            auto a = lossy.subscribe();
+            auto b = limited.subscribe();
+            auto c = limited.subscribe();
+
+            for (int i = 0; i < 5; ++i) {
+                co_await lossy.publish(i);
+                co_await limited.publish(i);
+
+                // c keeps up, b never reads
+                EXPECT_EQ(*co_await c.recv(), i);
+            }
+
+            // the oldest messages were dropped; a continues from the oldest kept one
+            EXPECT_EQ(*co_await a.recv(), 3);
+            EXPECT_EQ(a.dropped(), 3u);
+
+            EXPECT_TRUE(b.detached());
+            EXPECT_FALSE(c.detached());
+            EXPECT_EQ(limited.subscribers(), 1u);
+
+            bool thrown = false;
+            try {
+                co_await b.recv();
+            }
+            catch (std::runtime_error &) {
+                thrown = true;
+            }
+            EXPECT_TRUE(thrown);
+        }
+    };
+
+    test{}.run();
+}
+
+TEST(MediumTest, BusCollisions) {
+    cxxdes::sync::medium bus;
+    auto a = bus.add_node();
+    auto b = bus.add_node();
+    auto c = bus.add_node();
+
+    bus.begin_transmission(a);
+    EXPECT_FALSE(bus.busy(a));
+    EXPECT_TRUE(bus.busy(b));
+    EXPECT_FALSE(bus.collided(a));
+
+    bus.begin_transmission(b);
+    EXPECT_TRUE(bus.collided(a));
+    EXPECT_TRUE(bus.collided(b));
+
+    bus.begin_transmission(c);
+    EXPECT_FALSE(bus.end_transmission(a));
+    EXPECT_FALSE(bus.end_transmission(b));
+    EXPECT_FALSE(bus.end_transmission(c));
+
+    bus.begin_transmission(c);
+    EXPECT_TRUE(bus.end_transmission(c));
+
+    EXPECT_EQ(bus.transmissions(), 4u);
+    EXPECT_EQ(bus.collisions(), 3u);
+    EXPECT_THROW(bus.end_transmission(c), std::runtime_error);
+}
+
+TEST(MediumTest, RangeLimitsInterference) {
+    cxxdes::sync::medium radio{10.0};
+
+    // a grid of nodes 20 apart never interferes
+    std::vector<cxxdes::sync::medium::node_id> grid;
+    for (int i = 0; i < 40; ++i)
+        for (int j = 0; j < 40; ++j)
+            grid.push_back(radio.add_node(1000.0 + 20.0 * i, 20.0 * j));
+
+    for (auto id: grid)
+        radio.begin_transmission(id);
+    for (auto id: grid)
+        EXPECT_TRUE(radio.end_transmission(id));
+
+    auto a = radio.add_node(0, 0);
+    auto b = radio.add_node(5, 0);
+    auto c = radio.add_node(100, 0);
+
+    radio.begin_transmission(a);
+    radio.begin_transmission(c);
+    EXPECT_FALSE(radio.collided(a));
+    EXPECT_FALSE(radio.collided(c));
+    EXPECT_TRUE(radio.busy(b));
+
+    radio.begin_transmission(b);
+    EXPECT_TRUE(radio.collided(a));
+    EXPECT_TRUE(radio.collided(b));
+    EXPECT_FALSE(radio.collided(c));
+
+    EXPECT_FALSE(radio.end_transmission(a));
+    EXPECT_FALSE(radio.end_transmission(b));
+    EXPECT_TRUE(radio.end_transmission(c));
+}
+
+TEST(MediumTest, WaitIdleResumesWhenCarrierClears) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::medium radio{10.0};
+        cxxdes::sync::medium::node_id a = radio.add_node(0, 0);
+        cxxdes::sync::medium::node_id b = radio.add_node(5, 0);
+        cxxdes::sync::medium::node_id d = radio.add_node(8, 0);
+        cxxdes::sync::medium::node_id far = radio.add_node(50, 0);
+        cxxdes::core::time_integral idle_at = -1;
+
+        coroutine<> listener() {
+            co_await delay(1);
+            EXPECT_TRUE(radio.busy(d));
+            co_await radio.wait_idle(d);
+            idle_at = now();
+        }
+
+        coroutine<> talker(cxxdes::sync::medium::node_id id, int duration) {
+            radio.begin_transmission(id);
+            co_await delay(duration);
+            radio.end_transmission(id);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(talker(a, 4), talker(b, 6), talker(far, 2), listener());
+
+            auto r = co_await radio.wait_idle_for(5, d);
+            EXPECT_TRUE(r);
+
+            radio.begin_transmission(a);
+            r = co_await radio.wait_idle_for(5, d);
+            EXPECT_FALSE(r);
+            radio.end_transmission(a);
+        }
+    };
+
+    test t;
+    t.run();
+    EXPECT_EQ(t.idle_at, 6);
+}
+
+namespace {
+
+// three ports request three grants each; a grant is released right away
+std::vector<std::size_t> arbitrate(cxxdes::sync::arbiter_policy policy, std::size_t weight0 = 1) {
+    CXXDES_SIMULATION(test) {
+        test(cxxdes::sync::arbiter_policy policy, std::size_t weight0): arb{3, policy} {
+            arb.set_weight(0, weight0);
+        }
+
+        cxxdes::sync::arbiter arb;
+        std::vector<std::size_t> winners;
+
+        coroutine<> requester(std::size_t port) {
+            for (int i = 0; i < 3; ++i) {
+                auto g = co_await arb.request(port);
+                EXPECT_EQ(now(), static_cast<cxxdes::core::time_integral>(winners.size()));
+                winners.push_back(g.port());
+                co_await g.release();
+            }
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(requester(0), requester(1), requester(2));
+        }
+    };
+
+    test t{policy, weight0};
+    t.run();
+    return t.winners;
+}
+
+}
+
+TEST(ArbiterTest, PoliciesGrantOncePerCycle) {
+    using cxxdes::sync::arbiter_policy;
+    using v = std::vector<std::size_t>;
+
+    EXPECT_EQ(arbitrate(arbiter_policy::round_robin), (v{0, 1, 2, 0, 1, 2, 0, 1, 2}));
+    EXPECT_EQ(arbitrate(arbiter_policy::fixed_priority), (v{0, 0, 0, 1, 1, 1, 2, 2, 2}));
+    EXPECT_EQ(arbitrate(arbiter_policy::age_based), (v{0, 1, 2, 0, 1, 2, 0, 1, 2}));
+    EXPECT_EQ(arbitrate(arbiter_policy::weighted, 2), (v{0, 0, 1, 2, 0, 1, 2, 1, 2}));
+}
+
+TEST(ArbiterTest, CapacityAndTimedRequest) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        // two output lanes, arbitrated every 4 ticks
+        cxxdes::sync::arbiter arb{4, cxxdes::sync::arbiter_policy::round_robin, 4, 2};
+        std::vector<std::pair<std::size_t, cxxdes::core::time_integral>> granted;
+
+        coroutine<> requester(std::size_t port, int start) {
+            co_await delay(start);
+            _Co_with(arb.port(port)) {
+                granted.emplace_back(port, now());
+                co_await delay(5);
+            };
+        }
+
+        coroutine<> impatient() {
+            co_await delay(1);
+            auto r = co_await arb.request_for(2, 3);
+            EXPECT_FALSE(r);
+            EXPECT_EQ(arb.waiting(3), 0u);
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(requester(0, 1), requester(1, 2), requester(2, 3), impatient());
+            EXPECT_EQ(arb.granted(), 0u);
+            EXPECT_EQ(arb.grants(0) + arb.grants(1) + arb.grants(2), 3u);
+        }
+    };
+
+    test t;
+    t.run();
+
+    // ports 0 and 1 win the pass at 4; port 2 gets a lane at the first pass after a release
+    std::vector<std::pair<std::size_t, cxxdes::core::time_integral>> expected{{0, 4}, {1, 4}, {2, 12}};
+    EXPECT_EQ(t.granted, expected);
+}
+
+TEST(MonitorTest, Queue) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::queue<int, cxxdes::sync::monitored> q{2};
+
+        coroutine<> producer() {
+            co_await q.put(1);
+            co_await q.put(2);
+
+            // waits for room until 10
+            co_await q.put(3);
+        }
+
+        coroutine<> consumer() {
+            co_await delay(10);
+            EXPECT_FALSE(q.try_put(env, 4));
+
+            for (int i = 0; i < 3; ++i)
+                co_await q.pop();
+
+            EXPECT_FALSE(co_await q.pop_for(5));
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(producer(), consumer());
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    auto const &m = sim.q.monitor();
+    EXPECT_EQ(m.arrivals(), 8u);
+    EXPECT_EQ(m.balks(), 1u);
+    EXPECT_EQ(m.timeouts(), 1u);
+    EXPECT_EQ(m.waits().count(), 6u);
+    EXPECT_DOUBLE_EQ(m.waits().mean(), 10.0 / 6.0);
+    EXPECT_EQ(m.waits().max(), 10);
+
+    // two items until 10, none until 15
+    EXPECT_EQ(m.level().duration(), 15);
+    EXPECT_DOUBLE_EQ(m.level().mean(), 20.0 / 15.0);
+    EXPECT_EQ(m.level().max(), 2);
+}
+
+TEST(MonitorTest, MutexAndResource) {
+    CXXDES_SIMULATION(test) {
+        using simulation::simulation;
+
+        cxxdes::sync::basic_mutex<cxxdes::sync::monitored> mtx;
+        cxxdes::sync::basic_resource<cxxdes::sync::monitored> res{2};
+
+        coroutine<> holder() {
+            auto h = co_await mtx.acquire();
+            co_await delay(20);
+            co_await h.release();
+        }
+
+        coroutine<> patient() {
+            co_await delay(5);
+            auto h = co_await mtx.acquire();
+            EXPECT_EQ(now(), 20);
+            co_await delay(5);
+            co_await h.release();
+        }
+
+        coroutine<> impatient() {
+            co_await delay(5);
+            EXPECT_FALSE(co_await mtx.acquire_for(5));
+        }
+
+        coroutine<> user(time_integral hold) {
+            auto h = co_await res.acquire();
+            co_await delay(hold);
+            co_await h.release();
+        }
+
+        coroutine<> co_main() {
+            co_await all_of(holder(), patient(), impatient(), user(10), user(30), user(10));
+            co_await delay(40 - now());
+        }
+    };
+
+    test sim;
+    sim.run();
+
+    auto const &m = sim.mtx.monitor();
+    EXPECT_EQ(m.arrivals(), 3u);
+    EXPECT_EQ(m.timeouts(), 1u);
+    EXPECT_EQ(m.waits().count(), 2u);
+    EXPECT_EQ(m.waits().max(), 15);
+    EXPECT_DOUBLE_EQ(m.level().mean(), 25.0 / 40.0);
+
+    // the third user waits for the first; the level counts available units
+    auto const &r = sim.res.monitor();
+    EXPECT_EQ(r.arrivals(), 3u);
+    EXPECT_EQ(r.waits().max(), 10);
+    EXPECT_EQ(sim.res.capacity(), 2u);
+    EXPECT_DOUBLE_EQ(r.level().mean(), (0 * 20 + 1 * 10 + 2 * 10) / 40.0);
+}
+
+TEST(MonitorTest, Registry) {
+    cxxdes::sync::monitor_registry registry;
+    cxxdes::sync::semaphore<std::size_t, cxxdes::sync::monitored> sem{1};
+
+    {
+        cxxdes::sync::queue<int, cxxdes::sync::monitored> q;
+        registry.add("sem", sem);
+        registry.add("queue", q);
+        EXPECT_EQ(registry.size(), 2u);
+        EXPECT_THROW(registry.add("again", q), std::runtime_error);
+        EXPECT_THROW(q.monitor().level(), std::runtime_error);
+    }
+
+    // a destroyed primitive leaves the registry
+    ASSERT_EQ(registry.size(), 1u);
+    EXPECT_EQ(registry.entries().front().name, "sem");
+
+    auto report = registry.report();
+    EXPECT_NE(report.find("sem"), std::string::npos);
+    EXPECT_EQ(report.find("queue"), std::string::npos);
+
+    static_assert(sizeof(cxxdes::sync::mutex) < sizeof(cxxdes::sync::basic_mutex<cxxdes::sync::monitored>));
+}